@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "ros2_controllers_utils/allocation_counter.hpp"
 #include "test_bicycle_steering_controller.hpp"
 
 class BicycleSteeringControllerTest
@@ -88,14 +89,10 @@ TEST_F(BicycleSteeringControllerTest, activate_success)
   ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
   ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
 
-  // check that the message is reset
-  auto msg = controller_->input_ref_.get();
-  EXPECT_TRUE(std::isnan(msg.twist.linear.x));
-  EXPECT_TRUE(std::isnan(msg.twist.linear.y));
-  EXPECT_TRUE(std::isnan(msg.twist.linear.z));
-  EXPECT_TRUE(std::isnan(msg.twist.angular.x));
-  EXPECT_TRUE(std::isnan(msg.twist.angular.y));
-  EXPECT_TRUE(std::isnan(msg.twist.angular.z));
+  // check that the reference is reset
+  auto reference = controller_->input_ref_.get();
+  EXPECT_TRUE(std::isnan(reference.values[0]));
+  EXPECT_TRUE(std::isnan(reference.values[1]));
 }
 
 TEST_F(BicycleSteeringControllerTest, update_success)
@@ -151,7 +148,7 @@ TEST_F(BicycleSteeringControllerTest, test_update_logic)
   msg.header.stamp = controller_->get_node()->now();
   msg.twist.linear.x = 0.1;
   msg.twist.angular.z = 0.2;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
 
   ASSERT_EQ(
     controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
@@ -163,7 +160,7 @@ TEST_F(BicycleSteeringControllerTest, test_update_logic)
     controller_->command_interfaces_[CMD_STEER_WHEEL].get_value(), 1.4179821977774734,
     COMMON_THRESHOLD);
 
-  EXPECT_FALSE(std::isnan(controller_->input_ref_.get().twist.linear.x));
+  EXPECT_FALSE(std::isnan(controller_->input_ref_.get().values[0]));
   EXPECT_EQ(controller_->reference_interfaces_.size(), joint_reference_interfaces_.size());
   for (const auto & interface : controller_->reference_interfaces_)
   {
@@ -195,7 +192,7 @@ TEST_F(BicycleSteeringControllerTest, test_update_logic_chained)
     controller_->command_interfaces_[CMD_STEER_WHEEL].get_value(), 1.4179821977774734,
     COMMON_THRESHOLD);
 
-  EXPECT_TRUE(std::isnan(controller_->input_ref_.get().twist.linear.x));
+  EXPECT_TRUE(std::isnan(controller_->input_ref_.get().values[0]));
   EXPECT_EQ(controller_->reference_interfaces_.size(), joint_reference_interfaces_.size());
   for (const auto & interface : controller_->reference_interfaces_)
   {
@@ -257,6 +254,44 @@ TEST_F(BicycleSteeringControllerTest, receive_message_and_publish_updated_status
   EXPECT_NEAR(msg.steering_angle_command[0], 1.4179821977774734, COMMON_THRESHOLD);
 }
 
+TEST_F(BicycleSteeringControllerTest, update_does_not_allocate)
+{
+  SetUpController();
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  controller_->set_chained_mode(false);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  ControllerReferenceMsg msg;
+  msg.header.stamp = controller_->get_node()->now();
+  msg.twist.linear.x = 0.1;
+  msg.twist.angular.z = 0.2;
+  const auto reference = controller_->to_reference(msg);
+
+  bool updates_ok = true;
+  // the state message is laid out at configure, so even the first updates must not allocate
+  const size_t allocations = ros2_controllers_utils::count_allocations(
+    [&]()
+    {
+      for (size_t i = 0; i < 10; ++i)
+      {
+        controller_->input_ref_.set(reference);
+        if (
+          controller_->update(
+            rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)) !=
+          controller_interface::return_type::OK)
+        {
+          updates_ok = false;
+        }
+      }
+    });
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_TRUE(updates_ok);
+  EXPECT_GT(controller_->command_interfaces_[CMD_TRACTION_WHEEL].get_value(), 0.0);
+}
+
+ROS2_CONTROLLERS_UTILS_COUNT_ALLOCATIONS()
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -67,6 +67,7 @@ class TestableBicycleSteeringController
   FRIEND_TEST(BicycleSteeringControllerTest, test_update_logic_chained);
   FRIEND_TEST(BicycleSteeringControllerTest, publish_status_success);
   FRIEND_TEST(BicycleSteeringControllerTest, receive_message_and_publish_updated_status);
+  FRIEND_TEST(BicycleSteeringControllerTest, update_does_not_allocate);
 
 public:
   controller_interface::CallbackReturn on_configure(
@@ -0,0 +1,172 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DIFF_DRIVE_CONTROLLER__BATCHED_DIFF_DRIVE_CONTROLLER_HPP_
+#define DIFF_DRIVE_CONTROLLER__BATCHED_DIFF_DRIVE_CONTROLLER_HPP_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "controller_interface/controller_interface.hpp"
+#include "diff_drive_controller/batched_odometry.hpp"
+#include "diff_drive_controller/diff_drive_kinematics.hpp"
+#include "geometry_msgs/msg/twist_stamped.hpp"
+#include "rclcpp_lifecycle/state.hpp"
+#include "realtime_tools/realtime_publisher.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
+#include "tf2_msgs/msg/tf_message.hpp"
+
+// auto-generated by generate_parameter_library
+#include "diff_drive_controller/batched_diff_drive_controller_parameters.hpp"
+
+namespace diff_drive_controller
+{
+/**
+ * \brief Differential drive controller of many robots at once, e.g., of a fleet in simulation.
+ *
+ * Each robot in ``robots`` is controlled like by its own DiffDriveController, with the parameters
+ * of DiffDriveController declared under ``fleet.<robot>``. All robots share one node and update
+ * loop, and their state is stored as structure of arrays.
+ * Instead of two realtime publishers per robot, the odometry of all robots is published in one
+ * ``~/odom`` message and one ``/tf`` message.
+ *
+ * ``~/odom`` is a std_msgs/Float64MultiArray. Its first ODOMETRY_DATA_OFFSET values are the stamp
+ * as sec and nanosec, followed by x, y, heading, linear and angular velocity of each robot, in the
+ * order of ``robots``.
+ */
+class BatchedDiffDriveController : public controller_interface::ControllerInterface
+{
+  using TwistStamped = geometry_msgs::msg::TwistStamped;
+
+public:
+  /// Number of values of each robot in the ``~/odom`` message.
+  static constexpr size_t ODOMETRY_VALUES_PER_ROBOT = 5;
+  /// Index of the first value of the first robot in the ``~/odom`` message.
+  static constexpr size_t ODOMETRY_DATA_OFFSET = 2;
+
+  BatchedDiffDriveController();
+
+  controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+
+  controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+  controller_interface::return_type update(
+    const rclcpp::Time & time, const rclcpp::Duration & period) override;
+
+  controller_interface::CallbackReturn on_init() override;
+
+  controller_interface::CallbackReturn on_configure(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  controller_interface::CallbackReturn on_activate(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  controller_interface::CallbackReturn on_deactivate(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  controller_interface::CallbackReturn on_cleanup(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  controller_interface::CallbackReturn on_error(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+protected:
+  using CommandHandles =
+    std::vector<std::reference_wrapper<hardware_interface::LoanedCommandInterface>>;
+  using FeedbackHandles =
+    std::vector<std::reference_wrapper<const hardware_interface::LoanedStateInterface>>;
+
+  const char * feedback_type() const;
+  /// Names of the interfaces of the left and right wheels of all robots, in the order of robots.
+  std::vector<std::string> interface_names(const std::string & interface_type) const;
+  /// Append the handles of \p wheel_names, looked up in the indices of the loaned interfaces.
+  bool register_wheels(
+    const std::vector<std::string> & wheel_names,
+    const std::unordered_map<std::string, size_t> & command_index,
+    const std::unordered_map<std::string, size_t> & state_index, CommandHandles & commands,
+    FeedbackHandles & feedback);
+
+  // Parameters from ROS for batched_diff_drive_controller
+  std::shared_ptr<batched_diff_drive_controller::ParamListener> param_listener_;
+  batched_diff_drive_controller::Params params_;
+  // Parameters of DiffDriveController of each robot, in the order of robots
+  std::vector<std::shared_ptr<ParamListener>> robot_param_listeners_;
+  std::vector<Params> robot_params_;
+
+  size_t num_robots_ = 0;
+  // The wheels of robot i are [wheel_offsets_[i], wheel_offsets_[i + 1]) on either side.
+  std::vector<size_t> wheel_offsets_;
+  CommandHandles left_wheel_commands_;
+  CommandHandles right_wheel_commands_;
+  FeedbackHandles left_wheel_feedback_;
+  FeedbackHandles right_wheel_feedback_;
+
+  // State of the robots, one value per robot
+  BatchedOdometry odometry_;
+  std::vector<WheelParams> wheel_params_;
+  // mean feedback of the wheels of each side
+  std::vector<double> left_feedback_;
+  std::vector<double> right_feedback_;
+  // limited commands of this cycle, and of the last ([0]) and second-to-last ([1]) cycle
+  std::vector<double> linear_command_;
+  std::vector<double> angular_command_;
+  std::array<std::vector<double>, 2> previous_linear_commands_;
+  std::array<std::vector<double>, 2> previous_angular_commands_;
+
+  // speed limiter of the linear (axis 0) and angular (axis 1) velocity of each robot
+  std::vector<ros2_controllers_utils::Limiter<2>> limiters_;
+
+  // Timeout of each robot to consider cmd_vel commands old [ns]
+  std::vector<int64_t> cmd_vel_timeouts_;
+
+  bool subscriber_is_active_ = false;
+  std::vector<rclcpp::Subscription<TwistStamped>::SharedPtr> velocity_command_subscribers_;
+
+  // Commands written by the subscribers, copied to the reference of the update loop in one go
+  std::mutex received_commands_mutex_;
+  std::vector<double> received_linear_;
+  std::vector<double> received_angular_;
+  std::vector<int64_t> received_stamp_;  // [ns]
+  std::vector<double> reference_linear_;
+  std::vector<double> reference_angular_;
+  std::vector<int64_t> reference_stamp_;  // [ns]
+
+  std::shared_ptr<rclcpp::Publisher<std_msgs::msg::Float64MultiArray>> odometry_publisher_ =
+    nullptr;
+  std::shared_ptr<realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>>
+    realtime_odometry_publisher_ = nullptr;
+
+  std::shared_ptr<rclcpp::Publisher<tf2_msgs::msg::TFMessage>> odometry_transform_publisher_ =
+    nullptr;
+  std::shared_ptr<realtime_tools::RealtimePublisher<tf2_msgs::msg::TFMessage>>
+    realtime_odometry_transform_publisher_ = nullptr;
+
+  // publish rate limiter
+  rclcpp::Duration publish_period_ = rclcpp::Duration::from_nanoseconds(0);
+  rclcpp::Time previous_publish_timestamp_{0, 0, RCL_CLOCK_UNINITIALIZED};
+
+  bool reset();
+  void halt();
+
+private:
+  void reset_buffers();
+};
+}  // namespace diff_drive_controller
+#endif  // DIFF_DRIVE_CONTROLLER__BATCHED_DIFF_DRIVE_CONTROLLER_HPP_
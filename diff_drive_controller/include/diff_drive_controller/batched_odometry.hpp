@@ -0,0 +1,93 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DIFF_DRIVE_CONTROLLER__BATCHED_ODOMETRY_HPP_
+#define DIFF_DRIVE_CONTROLLER__BATCHED_ODOMETRY_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace diff_drive_controller
+{
+/**
+ * \brief Odometry of several differential drive robots, stored as structure of arrays.
+ *
+ * Computes the same poses as one Odometry per robot, but all robots are updated in one loop over
+ * contiguous arrays, with the time step shared by all robots. The velocity is filtered with the
+ * exponential moving average of ros2_controllers_utils::VelocityEstimator. Only resize() allocates
+ * memory.
+ */
+class BatchedOdometry
+{
+public:
+  explicit BatchedOdometry(size_t velocity_rolling_window_size = 10);
+
+  /// Set the number of robots and reset all of them, allocates memory.
+  void resize(size_t size);
+  size_t size() const { return x_.size(); }
+
+  void init();
+  /// Update from the wheel positions [rad] of all robots.
+  bool update(
+    const std::vector<double> & left_pos, const std::vector<double> & right_pos, double dt);
+  /// Update from the wheel velocities [rad/s] of all robots.
+  bool updateFromVelocity(
+    const std::vector<double> & left_vel, const std::vector<double> & right_vel, double dt);
+  /// Update from the commanded linear [m/s] and angular [rad/s] velocities of all robots.
+  void updateOpenLoop(
+    const std::vector<double> & linear, const std::vector<double> & angular, double dt);
+  void resetOdometry();
+
+  const std::vector<double> & getX() const { return x_; }
+  const std::vector<double> & getY() const { return y_; }
+  const std::vector<double> & getHeading() const { return heading_; }
+  const std::vector<double> & getLinear() const { return linear_; }
+  const std::vector<double> & getAngular() const { return angular_; }
+
+  void setWheelParams(
+    size_t index, double wheel_separation, double left_wheel_radius, double right_wheel_radius);
+  void setVelocityRollingWindowSize(size_t velocity_rolling_window_size);
+
+private:
+  void integrate();
+  void estimateVelocity(double dt);
+
+  // Current pose and filtered velocity:
+  std::vector<double> x_;        //   [m]
+  std::vector<double> y_;        //   [m]
+  std::vector<double> heading_;  // [rad]
+  std::vector<double> linear_;   //   [m/s]
+  std::vector<double> angular_;  // [rad/s]
+
+  // Wheel kinematic parameters [m]:
+  std::vector<double> wheel_separation_;
+  std::vector<double> left_wheel_radius_;
+  std::vector<double> right_wheel_radius_;
+
+  // Previous wheel position [m]:
+  std::vector<double> left_wheel_old_pos_;
+  std::vector<double> right_wheel_old_pos_;
+
+  // Linear [m] and angular [rad] motion of the current update:
+  std::vector<double> linear_step_;
+  std::vector<double> angular_step_;
+
+  // Smoothing factor of the velocity filter:
+  double alpha_;
+  bool velocity_initialized_ = false;
+};
+
+}  // namespace diff_drive_controller
+
+#endif  // DIFF_DRIVE_CONTROLLER__BATCHED_ODOMETRY_HPP_
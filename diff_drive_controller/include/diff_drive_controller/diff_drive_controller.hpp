@@ -19,13 +19,14 @@
 #ifndef DIFF_DRIVE_CONTROLLER__DIFF_DRIVE_CONTROLLER_HPP_
 #define DIFF_DRIVE_CONTROLLER__DIFF_DRIVE_CONTROLLER_HPP_
 
+#include <array>
 #include <chrono>
 #include <memory>
-#include <queue>
 #include <string>
 #include <vector>
 
 #include "controller_interface/chainable_controller_interface.hpp"
+#include "diff_drive_controller/diff_drive_kinematics.hpp"
 #include "diff_drive_controller/odometry.hpp"
 #include "diff_drive_controller/speed_limiter.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
@@ -34,6 +35,10 @@
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "realtime_tools/realtime_thread_safe_box.hpp"
+#include "ros2_controllers_utils/command_history.hpp"
+#include "ros2_controllers_utils/command_schedule.hpp"
+#include "ros2_controllers_utils/limiter.hpp"
+#include "ros2_controllers_utils/stamped_command.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
 
 // auto-generated by generate_parameter_library
@@ -76,11 +81,25 @@ public:
   controller_interface::CallbackReturn on_error(
     const rclcpp_lifecycle::State & previous_state) override;
 
+  /**
+   * \brief Get the odometry at a past point in time, interpolated from the odometry history.
+   *
+   * The size of the history is set with the ``odom_history_size`` parameter. Lock-free, can be
+   * called from any thread while the controller is configured, e.g., by a localization running in
+   * the same process.
+   *
+   * \return false if \p time is not covered by the history.
+   */
+  bool get_odometry_at(
+    const rclcpp::Time & time, ros2_controllers_utils::OdometrySample & sample) const;
+
 protected:
   bool on_set_chained_mode(bool chained_mode) override;
 
   std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
 
+  std::vector<hardware_interface::StateInterface> on_export_state_interfaces() override;
+
   struct WheelHandle
   {
     std::optional<std::reference_wrapper<const hardware_interface::LoanedStateInterface>> feedback;
@@ -122,15 +141,25 @@ protected:
   bool subscriber_is_active_ = false;
   rclcpp::Subscription<TwistStamped>::SharedPtr velocity_command_subscriber_ = nullptr;
 
+  // linear.x and angular.z of the received command, without the header of the message
+  using VelocityCommand = ros2_controllers_utils::StampedCommand<2>;
   // the realtime container to exchange the reference from subscriber
-  realtime_tools::RealtimeThreadSafeBox<TwistStamped> received_velocity_msg_;
+  realtime_tools::RealtimeThreadSafeBox<VelocityCommand> received_velocity_command_;
   // save the last reference in case of unable to get value from box
-  TwistStamped command_msg_;
-
-  std::queue<std::array<double, 2>> previous_two_commands_;
-  // speed limiters
-  std::unique_ptr<SpeedLimiter> limiter_linear_;
-  std::unique_ptr<SpeedLimiter> limiter_angular_;
+  VelocityCommand velocity_command_;
+
+  // commands ordered by their stamps, used instead of received_velocity_command_ with
+  // schedule_cmd_vel
+  using CommandSchedule = ros2_controllers_utils::CommandSchedule<2, 16>;
+  // written by the subscriber only
+  CommandSchedule pending_commands_;
+  realtime_tools::RealtimeThreadSafeBox<CommandSchedule> received_command_schedule_;
+  // copy of the schedule in the realtime loop
+  CommandSchedule command_schedule_;
+
+  ros2_controllers_utils::CommandHistory<std::array<double, 2>, 2> previous_two_commands_;
+  // speed limiter of the linear (index 0) and angular (index 1) velocity
+  ros2_controllers_utils::Limiter<2> limiter_;
 
   bool publish_limited_velocity_ = false;
   std::shared_ptr<rclcpp::Publisher<TwistStamped>> limited_velocity_publisher_ = nullptr;
@@ -0,0 +1,80 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DIFF_DRIVE_CONTROLLER__DIFF_DRIVE_KINEMATICS_HPP_
+#define DIFF_DRIVE_CONTROLLER__DIFF_DRIVE_KINEMATICS_HPP_
+
+#include "ros2_controllers_utils/limiter.hpp"
+
+// auto-generated by generate_parameter_library
+#include "diff_drive_controller/diff_drive_controller_parameters.hpp"
+
+namespace diff_drive_controller
+{
+/// Wheel separation and radii of a robot [m], with the multipliers of the parameters applied.
+struct WheelParams
+{
+  double separation = 0.0;
+  double left_radius = 0.0;
+  double right_radius = 0.0;
+};
+
+inline WheelParams get_wheel_params(const Params & params)
+{
+  return {
+    params.wheel_separation_multiplier * params.wheel_separation,
+    params.left_wheel_radius_multiplier * params.wheel_radius,
+    params.right_wheel_radius_multiplier * params.wheel_radius};
+}
+
+/**
+ * \brief Compute the wheel velocities to drive with a linear and angular velocity.
+ *
+ * \param[in] wheels Wheel separation and radii of the robot.
+ * \param[in] linear Linear velocity [m/s].
+ * \param[in] angular Angular velocity [rad/s].
+ * \param[out] left Velocity of the left wheels [rad/s].
+ * \param[out] right Velocity of the right wheels [rad/s].
+ */
+inline void get_wheel_velocities(
+  const WheelParams & wheels, const double linear, const double angular, double & left,
+  double & right)
+{
+  left = (linear - angular * wheels.separation / 2.0) / wheels.left_radius;
+  right = (linear + angular * wheels.separation / 2.0) / wheels.right_radius;
+}
+
+/**
+ * \brief Make the limiter of the linear (axis 0) and angular (axis 1) velocity of a robot.
+ *
+ * \throws std::invalid_argument if the ``linear.x.*`` or ``angular.z.*`` limits are inconsistent.
+ */
+inline ros2_controllers_utils::Limiter<2> make_speed_limiter(const Params & params)
+{
+  return ros2_controllers_utils::Limiter<2>(
+    {ros2_controllers_utils::make_rate_limits(
+       params.linear.x.min_velocity, params.linear.x.max_velocity,
+       params.linear.x.max_acceleration_reverse, params.linear.x.max_acceleration,
+       params.linear.x.max_deceleration, params.linear.x.max_deceleration_reverse,
+       params.linear.x.min_jerk, params.linear.x.max_jerk),
+     ros2_controllers_utils::make_rate_limits(
+       params.angular.z.min_velocity, params.angular.z.max_velocity,
+       params.angular.z.max_acceleration_reverse, params.angular.z.max_acceleration,
+       params.angular.z.max_deceleration, params.angular.z.max_deceleration_reverse,
+       params.angular.z.min_jerk, params.angular.z.max_jerk)});
+}
+
+}  // namespace diff_drive_controller
+
+#endif  // DIFF_DRIVE_CONTROLLER__DIFF_DRIVE_KINEMATICS_HPP_
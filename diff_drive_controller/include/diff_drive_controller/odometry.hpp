@@ -23,12 +23,8 @@
 #define DIFF_DRIVE_CONTROLLER__ODOMETRY_HPP_
 
 #include "rclcpp/time.hpp"
-// \note The versions conditioning is added here to support the source-compatibility with Humble
-#if RCPPUTILS_VERSION_MAJOR >= 2 && RCPPUTILS_VERSION_MINOR >= 6
-#include "rcpputils/rolling_mean_accumulator.hpp"
-#else
-#include "rcppmath/rolling_mean_accumulator.hpp"
-#endif
+#include "ros2_controllers_utils/odometry_history.hpp"
+#include "ros2_controllers_utils/velocity_estimator.hpp"
 
 namespace diff_drive_controller
 {
@@ -51,18 +47,17 @@ public:
 
   void setWheelParams(double wheel_separation, double left_wheel_radius, double right_wheel_radius);
   void setVelocityRollingWindowSize(size_t velocity_rolling_window_size);
+  void setVelocityEstimatorType(ros2_controllers_utils::VelocityEstimator::Type type);
+  void setHistorySize(size_t history_size);
 
-private:
-// \note The versions conditioning is added here to support the source-compatibility with Humble
-#if RCPPUTILS_VERSION_MAJOR >= 2 && RCPPUTILS_VERSION_MINOR >= 6
-  using RollingMeanAccumulator = rcpputils::RollingMeanAccumulator<double>;
-#else
-  using RollingMeanAccumulator = rcppmath::RollingMeanAccumulator<double>;
-#endif
+  /// History of the odometry, can be queried from any thread, see OdometryHistory::lookup().
+  const ros2_controllers_utils::OdometryHistory & getHistory() const { return history_; }
 
+private:
   void integrateRungeKutta2(double linear, double angular);
   void integrateExact(double linear, double angular);
   void resetAccumulators();
+  void pushHistory();
 
   // Current timestamp:
   rclcpp::Time timestamp_;
@@ -85,10 +80,14 @@ private:
   double left_wheel_old_pos_;
   double right_wheel_old_pos_;
 
-  // Rolling mean accumulators for the linear and angular velocities:
+  // Filters of the linear and angular velocities:
   size_t velocity_rolling_window_size_;
-  RollingMeanAccumulator linear_accumulator_;
-  RollingMeanAccumulator angular_accumulator_;
+  ros2_controllers_utils::VelocityEstimator::Type velocity_estimator_type_;
+  ros2_controllers_utils::VelocityEstimator linear_accumulator_;
+  ros2_controllers_utils::VelocityEstimator angular_accumulator_;
+
+  // Timestamped poses and velocities for lookups at past points in time:
+  ros2_controllers_utils::OdometryHistory history_;
 };
 
 }  // namespace diff_drive_controller
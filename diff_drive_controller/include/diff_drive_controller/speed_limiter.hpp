@@ -21,7 +21,7 @@
 
 #include <limits>
 
-#include "control_toolbox/rate_limiter.hpp"
+#include "ros2_controllers_utils/limiter.hpp"
 
 namespace diff_drive_controller
 {
@@ -50,10 +50,10 @@ public:
     double min_velocity, double max_velocity, double max_acceleration_reverse,
     double max_acceleration, double max_deceleration, double max_deceleration_reverse,
     double min_jerk, double max_jerk)
-  {
-    speed_limiter_ = control_toolbox::RateLimiter<double>(
+  : speed_limiter_({ros2_controllers_utils::make_rate_limits(
       min_velocity, max_velocity, max_acceleration_reverse, max_acceleration, max_deceleration,
-      max_deceleration_reverse, min_jerk, max_jerk);
+      max_deceleration_reverse, min_jerk, max_jerk)})
+  {
   }
 
   /**
@@ -66,7 +66,7 @@ public:
    */
   double limit(double & v, double v0, double v1, double dt)
   {
-    return speed_limiter_.limit(v, v0, v1, dt);
+    return speed_limiter_.limit(0, v, v0, v1, dt);
   }
 
   /**
@@ -74,7 +74,7 @@ public:
    * \param [in, out] v Velocity [m/s]
    * \return Limiting factor (1.0 if none)
    */
-  double limit_velocity(double & v) { return speed_limiter_.limit_value(v); }
+  double limit_velocity(double & v) { return speed_limiter_.limit_value(0, v); }
 
   /**
    * \brief Limit the acceleration
@@ -85,7 +85,7 @@ public:
    */
   double limit_acceleration(double & v, double v0, double dt)
   {
-    return speed_limiter_.limit_first_derivative(v, v0, dt);
+    return speed_limiter_.limit_first_derivative(0, v, v0, dt);
   }
 
   /**
@@ -99,11 +99,11 @@ public:
    */
   double limit_jerk(double & v, double v0, double v1, double dt)
   {
-    return speed_limiter_.limit_second_derivative(v, v0, v1, dt);
+    return speed_limiter_.limit_second_derivative(0, v, v0, v1, dt);
   }
 
 private:
-  control_toolbox::RateLimiter<double> speed_limiter_;  // Instance of the new RateLimiter
+  ros2_controllers_utils::Limiter<1> speed_limiter_;
 };
 
 }  // namespace diff_drive_controller
@@ -0,0 +1,618 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "diff_drive_controller/batched_diff_drive_controller.hpp"
+#include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "rclcpp/logging.hpp"
+#include "ros2_controllers_utils/publish_rate.hpp"
+#include "tf2/LinearMath/Quaternion.hpp"
+
+namespace
+{
+constexpr auto DEFAULT_COMMAND_TOPIC = "cmd_vel";
+constexpr auto DEFAULT_ODOMETRY_TOPIC = "~/odom";
+constexpr auto DEFAULT_TRANSFORM_TOPIC = "/tf";
+
+/// Index of the interfaces by their full name.
+template <typename T>
+std::unordered_map<std::string, size_t> index_interfaces_by_name(const std::vector<T> & interfaces)
+{
+  std::unordered_map<std::string, size_t> index;
+  index.reserve(interfaces.size());
+  for (size_t i = 0; i < interfaces.size(); ++i)
+  {
+    index.emplace(interfaces[i].get_name(), i);
+  }
+  return index;
+}
+}  // namespace
+
+namespace diff_drive_controller
+{
+using controller_interface::interface_configuration_type;
+using controller_interface::InterfaceConfiguration;
+using hardware_interface::HW_IF_POSITION;
+using hardware_interface::HW_IF_VELOCITY;
+
+BatchedDiffDriveController::BatchedDiffDriveController()
+: controller_interface::ControllerInterface()
+{
+}
+
+const char * BatchedDiffDriveController::feedback_type() const
+{
+  return params_.position_feedback ? HW_IF_POSITION : HW_IF_VELOCITY;
+}
+
+controller_interface::CallbackReturn BatchedDiffDriveController::on_init()
+{
+  try
+  {
+    // Create the parameter listener and get the parameters
+    param_listener_ = std::make_shared<batched_diff_drive_controller::ParamListener>(get_node());
+    params_ = param_listener_->get_params();
+
+    // the parameters of each robot are those of DiffDriveController, under fleet.<robot>
+    for (const auto & robot : params_.robots)
+    {
+      robot_param_listeners_.push_back(
+        std::make_shared<ParamListener>(get_node(), "fleet." + robot + "."));
+      robot_params_.push_back(robot_param_listeners_.back()->get_params());
+    }
+  }
+  catch (const std::exception & e)
+  {
+    fprintf(stderr, "Exception thrown during init stage with message: %s \n", e.what());
+    return controller_interface::CallbackReturn::ERROR;
+  }
+
+  return controller_interface::CallbackReturn::SUCCESS;
+}
+
+std::vector<std::string> BatchedDiffDriveController::interface_names(
+  const std::string & interface_type) const
+{
+  std::vector<std::string> names;
+  for (const auto & wheels : robot_params_)
+  {
+    for (const auto & joint_name : wheels.left_wheel_names)
+    {
+      names.push_back(joint_name + "/" + interface_type);
+    }
+    for (const auto & joint_name : wheels.right_wheel_names)
+    {
+      names.push_back(joint_name + "/" + interface_type);
+    }
+  }
+  return names;
+}
+
+InterfaceConfiguration BatchedDiffDriveController::command_interface_configuration() const
+{
+  return {interface_configuration_type::INDIVIDUAL, interface_names(HW_IF_VELOCITY)};
+}
+
+InterfaceConfiguration BatchedDiffDriveController::state_interface_configuration() const
+{
+  if (params_.open_loop)
+  {
+    return {interface_configuration_type::NONE, {}};
+  }
+  return {interface_configuration_type::INDIVIDUAL, interface_names(feedback_type())};
+}
+
+controller_interface::return_type BatchedDiffDriveController::update(
+  const rclcpp::Time & time, const rclcpp::Duration & period)
+{
+  auto logger = get_node()->get_logger();
+  const double dt = period.seconds();
+
+  {
+    // take the commands of all robots at once, keep the last ones if a subscriber is writing
+    std::unique_lock<std::mutex> lock(received_commands_mutex_, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+      std::copy(received_linear_.begin(), received_linear_.end(), reference_linear_.begin());
+      std::copy(received_angular_.begin(), received_angular_.end(), reference_angular_.begin());
+      std::copy(received_stamp_.begin(), received_stamp_.end(), reference_stamp_.begin());
+    }
+  }
+
+  // Brake if cmd_vel has timeout or no command was received yet, and limit the commands
+  const int64_t now = time.nanoseconds();
+  for (size_t i = 0; i < num_robots_; ++i)
+  {
+    const bool is_valid = now - reference_stamp_[i] <= cmd_vel_timeouts_[i];
+    linear_command_[i] = is_valid ? reference_linear_[i] : 0.0;
+    angular_command_[i] = is_valid ? reference_angular_[i] : 0.0;
+
+    limiters_[i].limit(
+      0, linear_command_[i], previous_linear_commands_[0][i], previous_linear_commands_[1][i], dt);
+    limiters_[i].limit(
+      1, angular_command_[i], previous_angular_commands_[0][i], previous_angular_commands_[1][i],
+      dt);
+  }
+  previous_linear_commands_[1].swap(previous_linear_commands_[0]);
+  previous_angular_commands_[1].swap(previous_angular_commands_[0]);
+  std::copy(linear_command_.begin(), linear_command_.end(), previous_linear_commands_[0].begin());
+  std::copy(
+    angular_command_.begin(), angular_command_.end(), previous_angular_commands_[0].begin());
+
+  if (params_.open_loop)
+  {
+    odometry_.updateOpenLoop(linear_command_, angular_command_, dt);
+  }
+  else
+  {
+    bool has_feedback = true;
+    for (size_t i = 0; i < num_robots_ && has_feedback; ++i)
+    {
+      double left_feedback_sum = 0.0;
+      double right_feedback_sum = 0.0;
+      for (size_t index = wheel_offsets_[i]; index < wheel_offsets_[i + 1]; ++index)
+      {
+        const auto left_feedback_op = left_wheel_feedback_[index].get().get_optional();
+        const auto right_feedback_op = right_wheel_feedback_[index].get().get_optional();
+        if (!left_feedback_op.has_value() || !right_feedback_op.has_value())
+        {
+          has_feedback = false;
+          break;
+        }
+        if (std::isnan(left_feedback_op.value()) || std::isnan(right_feedback_op.value()))
+        {
+          RCLCPP_ERROR(
+            logger, "Either the left or right wheel %s of robot '%s' is invalid", feedback_type(),
+            params_.robots[i].c_str());
+          return controller_interface::return_type::ERROR;
+        }
+        left_feedback_sum += left_feedback_op.value();
+        right_feedback_sum += right_feedback_op.value();
+      }
+      const double wheels_per_side = static_cast<double>(wheel_offsets_[i + 1] - wheel_offsets_[i]);
+      left_feedback_[i] = left_feedback_sum / wheels_per_side;
+      right_feedback_[i] = right_feedback_sum / wheels_per_side;
+    }
+
+    if (!has_feedback)
+    {
+      RCLCPP_DEBUG(logger, "Unable to retrieve the data from the wheels feedback!");
+    }
+    else if (params_.position_feedback)
+    {
+      odometry_.update(left_feedback_, right_feedback_, dt);
+    }
+    else
+    {
+      odometry_.updateFromVelocity(left_feedback_, right_feedback_, dt);
+    }
+  }
+
+  if (ros2_controllers_utils::is_publish_due(publish_period_, previous_publish_timestamp_, time))
+  {
+    const builtin_interfaces::msg::Time stamp = time;
+    const auto & x = odometry_.getX();
+    const auto & y = odometry_.getY();
+    const auto & heading = odometry_.getHeading();
+
+    if (realtime_odometry_publisher_->trylock())
+    {
+      auto & data = realtime_odometry_publisher_->msg_.data;
+      data[0] = stamp.sec;
+      data[1] = stamp.nanosec;
+      const auto & linear = odometry_.getLinear();
+      const auto & angular = odometry_.getAngular();
+      for (size_t i = 0; i < num_robots_; ++i)
+      {
+        double * values = &data[ODOMETRY_DATA_OFFSET + ODOMETRY_VALUES_PER_ROBOT * i];
+        values[0] = x[i];
+        values[1] = y[i];
+        values[2] = heading[i];
+        values[3] = linear[i];
+        values[4] = angular[i];
+      }
+      realtime_odometry_publisher_->unlockAndPublish();
+    }
+
+    if (params_.enable_odom_tf && realtime_odometry_transform_publisher_->trylock())
+    {
+      auto & transforms = realtime_odometry_transform_publisher_->msg_.transforms;
+      for (size_t i = 0; i < num_robots_; ++i)
+      {
+        tf2::Quaternion orientation;
+        orientation.setRPY(0.0, 0.0, heading[i]);
+
+        auto & transform = transforms[i];
+        transform.header.stamp = stamp;
+        transform.transform.translation.x = x[i];
+        transform.transform.translation.y = y[i];
+        transform.transform.rotation.x = orientation.x();
+        transform.transform.rotation.y = orientation.y();
+        transform.transform.rotation.z = orientation.z();
+        transform.transform.rotation.w = orientation.w();
+      }
+      realtime_odometry_transform_publisher_->unlockAndPublish();
+    }
+  }
+
+  // Compute and set wheels velocities:
+  bool set_command_result = true;
+  for (size_t i = 0; i < num_robots_; ++i)
+  {
+    double velocity_left;
+    double velocity_right;
+    get_wheel_velocities(
+      wheel_params_[i], linear_command_[i], angular_command_[i], velocity_left, velocity_right);
+
+    for (size_t index = wheel_offsets_[i]; index < wheel_offsets_[i + 1]; ++index)
+    {
+      set_command_result &= left_wheel_commands_[index].get().set_value(velocity_left);
+      set_command_result &= right_wheel_commands_[index].get().set_value(velocity_right);
+    }
+  }
+
+  RCLCPP_DEBUG_EXPRESSION(
+    logger, !set_command_result, "Unable to set the command to one of the command handles!");
+
+  return controller_interface::return_type::OK;
+}
+
+controller_interface::CallbackReturn BatchedDiffDriveController::on_configure(
+  const rclcpp_lifecycle::State &)
+{
+  auto logger = get_node()->get_logger();
+
+  // update parameters if they have changed
+  if (param_listener_->is_old(params_))
+  {
+    params_ = param_listener_->get_params();
+    RCLCPP_INFO(logger, "Parameters were updated");
+  }
+  for (size_t i = 0; i < robot_param_listeners_.size(); ++i)
+  {
+    if (robot_param_listeners_[i]->is_old(robot_params_[i]))
+    {
+      robot_params_[i] = robot_param_listeners_[i]->get_params();
+      RCLCPP_INFO(logger, "Parameters of robot '%s' were updated", params_.robots[i].c_str());
+    }
+  }
+
+  num_robots_ = params_.robots.size();
+  wheel_offsets_.assign(1, 0);
+  wheel_params_.resize(num_robots_);
+  limiters_.resize(num_robots_);
+  cmd_vel_timeouts_.resize(num_robots_);
+  odometry_.resize(num_robots_);
+  for (size_t i = 0; i < num_robots_; ++i)
+  {
+    const auto & robot = robot_params_[i];
+    if (robot.left_wheel_names.size() != robot.right_wheel_names.size())
+    {
+      RCLCPP_ERROR(
+        logger,
+        "The number of left wheels [%zu] and the number of right wheels [%zu] of robot '%s' are "
+        "different",
+        robot.left_wheel_names.size(), robot.right_wheel_names.size(), params_.robots[i].c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    wheel_offsets_.push_back(wheel_offsets_.back() + robot.left_wheel_names.size());
+    wheel_params_[i] = get_wheel_params(robot);
+    odometry_.setWheelParams(
+      i, wheel_params_[i].separation, wheel_params_[i].left_radius, wheel_params_[i].right_radius);
+    cmd_vel_timeouts_[i] = rclcpp::Duration::from_seconds(robot.cmd_vel_timeout).nanoseconds();
+
+    try
+    {
+      limiters_[i] = make_speed_limiter(robot);
+    }
+    catch (const std::invalid_argument & e)
+    {
+      RCLCPP_ERROR(
+        logger, "Error configuring speed limiter of robot '%s': %s", params_.robots[i].c_str(),
+        e.what());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+  }
+  odometry_.setVelocityRollingWindowSize(static_cast<size_t>(params_.velocity_rolling_window_size));
+  odometry_.init();
+
+  for (auto * values :
+       {&left_feedback_, &right_feedback_, &linear_command_, &angular_command_,
+        &previous_linear_commands_[0], &previous_linear_commands_[1],
+        &previous_angular_commands_[0], &previous_angular_commands_[1], &received_linear_,
+        &received_angular_, &reference_linear_, &reference_angular_})
+  {
+    values->assign(num_robots_, 0.0);
+  }
+  received_stamp_.assign(num_robots_, 0);
+  reference_stamp_.assign(num_robots_, 0);
+
+  if (!reset())
+  {
+    return controller_interface::CallbackReturn::ERROR;
+  }
+
+  // initialize one command subscriber per robot, all of them write to the same buffers
+  velocity_command_subscribers_.reserve(num_robots_);
+  for (size_t i = 0; i < num_robots_; ++i)
+  {
+    velocity_command_subscribers_.push_back(get_node()->create_subscription<TwistStamped>(
+      "~/" + params_.robots[i] + "/" + DEFAULT_COMMAND_TOPIC, rclcpp::SystemDefaultsQoS(),
+      [this, i](const std::shared_ptr<TwistStamped> msg) -> void
+      {
+        if (!subscriber_is_active_)
+        {
+          RCLCPP_WARN(
+            get_node()->get_logger(), "Can't accept new commands. subscriber is inactive");
+          return;
+        }
+        if ((msg->header.stamp.sec == 0) && (msg->header.stamp.nanosec == 0))
+        {
+          RCLCPP_WARN_ONCE(
+            get_node()->get_logger(),
+            "Received TwistStamped with zero timestamp, setting it to current "
+            "time, this message will only be shown once");
+          msg->header.stamp = get_node()->now();
+        }
+        if (!std::isfinite(msg->twist.linear.x) || !std::isfinite(msg->twist.angular.z))
+        {
+          RCLCPP_WARN(
+            get_node()->get_logger(), "Ignoring the command of robot '%s' containing NaNs",
+            params_.robots[i].c_str());
+          return;
+        }
+
+        const auto current_time_diff = get_node()->now() - msg->header.stamp;
+        const auto cmd_vel_timeout = rclcpp::Duration::from_nanoseconds(cmd_vel_timeouts_[i]);
+
+        if (
+          cmd_vel_timeout == rclcpp::Duration::from_seconds(0.0) ||
+          current_time_diff < cmd_vel_timeout)
+        {
+          std::lock_guard<std::mutex> lock(received_commands_mutex_);
+          received_linear_[i] = msg->twist.linear.x;
+          received_angular_[i] = msg->twist.angular.z;
+          received_stamp_[i] = rclcpp::Time(msg->header.stamp).nanoseconds();
+        }
+        else
+        {
+          RCLCPP_WARN(
+            get_node()->get_logger(),
+            "Ignoring the received message of robot '%s' (timestamp %.10f) because it is older "
+            "than the current time by %.10f seconds, which exceeds the allowed timeout (%.4f)",
+            params_.robots[i].c_str(), rclcpp::Time(msg->header.stamp).seconds(),
+            current_time_diff.seconds(), cmd_vel_timeout.seconds());
+        }
+      }));
+  }
+
+  // initialize odometry publisher and message
+  odometry_publisher_ = get_node()->create_publisher<std_msgs::msg::Float64MultiArray>(
+    DEFAULT_ODOMETRY_TOPIC, rclcpp::SystemDefaultsQoS());
+  realtime_odometry_publisher_ =
+    std::make_shared<realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>>(
+      odometry_publisher_);
+
+  auto & odometry_message = realtime_odometry_publisher_->msg_;
+  odometry_message.layout.data_offset = static_cast<uint32_t>(ODOMETRY_DATA_OFFSET);
+  odometry_message.layout.dim.resize(2);
+  odometry_message.layout.dim[0].label = "robots";
+  odometry_message.layout.dim[0].size = static_cast<uint32_t>(num_robots_);
+  odometry_message.layout.dim[0].stride =
+    static_cast<uint32_t>(num_robots_ * ODOMETRY_VALUES_PER_ROBOT);
+  odometry_message.layout.dim[1].label = "x_y_heading_linear_angular";
+  odometry_message.layout.dim[1].size = static_cast<uint32_t>(ODOMETRY_VALUES_PER_ROBOT);
+  odometry_message.layout.dim[1].stride = static_cast<uint32_t>(ODOMETRY_VALUES_PER_ROBOT);
+  odometry_message.data.assign(
+    ODOMETRY_DATA_OFFSET + num_robots_ * ODOMETRY_VALUES_PER_ROBOT, 0.0);
+
+  // limit the publication on the topics ~/odom and /tf
+  publish_period_ = rclcpp::Duration::from_seconds(1.0 / params_.publish_rate);
+
+  // initialize transform publisher and message
+  odometry_transform_publisher_ = get_node()->create_publisher<tf2_msgs::msg::TFMessage>(
+    DEFAULT_TRANSFORM_TOPIC, rclcpp::SystemDefaultsQoS());
+  realtime_odometry_transform_publisher_ =
+    std::make_shared<realtime_tools::RealtimePublisher<tf2_msgs::msg::TFMessage>>(
+      odometry_transform_publisher_);
+
+  // keeping track of odom and base_link transforms of all robots
+  auto & transforms = realtime_odometry_transform_publisher_->msg_.transforms;
+  transforms.resize(num_robots_);
+  for (size_t i = 0; i < num_robots_; ++i)
+  {
+    transforms[i].header.frame_id = params_.robots[i] + "/" + robot_params_[i].odom_frame_id;
+    transforms[i].child_frame_id = params_.robots[i] + "/" + robot_params_[i].base_frame_id;
+  }
+
+  return controller_interface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn BatchedDiffDriveController::on_activate(
+  const rclcpp_lifecycle::State &)
+{
+  auto logger = get_node()->get_logger();
+
+  const auto command_index = index_interfaces_by_name(command_interfaces_);
+  const auto state_index = index_interfaces_by_name(state_interfaces_);
+
+  const size_t num_wheels = wheel_offsets_.back();
+  for (auto * handles : {&left_wheel_commands_, &right_wheel_commands_})
+  {
+    handles->clear();
+    handles->reserve(num_wheels);
+  }
+  for (auto * handles : {&left_wheel_feedback_, &right_wheel_feedback_})
+  {
+    handles->clear();
+    handles->reserve(num_wheels);
+  }
+
+  // register handles of all robots, side by side
+  for (const auto & wheels : robot_params_)
+  {
+    if (
+      !register_wheels(
+        wheels.left_wheel_names, command_index, state_index, left_wheel_commands_,
+        left_wheel_feedback_) ||
+      !register_wheels(
+        wheels.right_wheel_names, command_index, state_index, right_wheel_commands_,
+        right_wheel_feedback_))
+    {
+      return controller_interface::CallbackReturn::ERROR;
+    }
+  }
+
+  // every activation starts the odometry of all robots at the origin, with a reset velocity filter
+  odometry_.resetOdometry();
+  odometry_.init();
+
+  reset_buffers();
+  subscriber_is_active_ = true;
+
+  RCLCPP_DEBUG(logger, "Subscribers and publishers of %zu robots are now active.", num_robots_);
+  return controller_interface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn BatchedDiffDriveController::on_deactivate(
+  const rclcpp_lifecycle::State &)
+{
+  subscriber_is_active_ = false;
+  halt();
+  reset_buffers();
+  left_wheel_commands_.clear();
+  right_wheel_commands_.clear();
+  left_wheel_feedback_.clear();
+  right_wheel_feedback_.clear();
+  return controller_interface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn BatchedDiffDriveController::on_cleanup(
+  const rclcpp_lifecycle::State &)
+{
+  if (!reset())
+  {
+    return controller_interface::CallbackReturn::ERROR;
+  }
+
+  return controller_interface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn BatchedDiffDriveController::on_error(
+  const rclcpp_lifecycle::State &)
+{
+  if (!reset())
+  {
+    return controller_interface::CallbackReturn::ERROR;
+  }
+  return controller_interface::CallbackReturn::SUCCESS;
+}
+
+bool BatchedDiffDriveController::reset()
+{
+  odometry_.resetOdometry();
+
+  reset_buffers();
+
+  left_wheel_commands_.clear();
+  right_wheel_commands_.clear();
+  left_wheel_feedback_.clear();
+  right_wheel_feedback_.clear();
+
+  subscriber_is_active_ = false;
+  velocity_command_subscribers_.clear();
+
+  return true;
+}
+
+void BatchedDiffDriveController::reset_buffers()
+{
+  // Fill the command history with zeros to catch early accelerations.
+  for (auto & commands : previous_linear_commands_)
+  {
+    std::fill(commands.begin(), commands.end(), 0.0);
+  }
+  for (auto & commands : previous_angular_commands_)
+  {
+    std::fill(commands.begin(), commands.end(), 0.0);
+  }
+
+  // Robots are stopped until a new command is received.
+  std::lock_guard<std::mutex> lock(received_commands_mutex_);
+  std::fill(received_linear_.begin(), received_linear_.end(), 0.0);
+  std::fill(received_angular_.begin(), received_angular_.end(), 0.0);
+  std::fill(received_stamp_.begin(), received_stamp_.end(), 0);
+  std::fill(reference_linear_.begin(), reference_linear_.end(), 0.0);
+  std::fill(reference_angular_.begin(), reference_angular_.end(), 0.0);
+  std::fill(reference_stamp_.begin(), reference_stamp_.end(), 0);
+}
+
+bool BatchedDiffDriveController::register_wheels(
+  const std::vector<std::string> & wheel_names,
+  const std::unordered_map<std::string, size_t> & command_index,
+  const std::unordered_map<std::string, size_t> & state_index, CommandHandles & commands,
+  FeedbackHandles & feedback)
+{
+  auto logger = get_node()->get_logger();
+
+  for (const auto & wheel_name : wheel_names)
+  {
+    const auto command_handle = command_index.find(wheel_name + "/" + HW_IF_VELOCITY);
+    if (command_handle == command_index.end())
+    {
+      RCLCPP_ERROR(logger, "Unable to obtain joint command handle for %s", wheel_name.c_str());
+      return false;
+    }
+    commands.emplace_back(command_interfaces_[command_handle->second]);
+
+    if (!params_.open_loop)
+    {
+      const auto state_handle = state_index.find(wheel_name + "/" + feedback_type());
+      if (state_handle == state_index.end())
+      {
+        RCLCPP_ERROR(logger, "Unable to obtain joint state handle for %s", wheel_name.c_str());
+        return false;
+      }
+      feedback.emplace_back(state_interfaces_[state_handle->second]);
+    }
+  }
+
+  return true;
+}
+
+void BatchedDiffDriveController::halt()
+{
+  for (auto & command : left_wheel_commands_)
+  {
+    command.get().set_value(0.0);
+  }
+  for (auto & command : right_wheel_commands_)
+  {
+    command.get().set_value(0.0);
+  }
+}
+
+}  // namespace diff_drive_controller
+
+#include "class_loader/register_macro.hpp"
+
+CLASS_LOADER_REGISTER_CLASS(
+  diff_drive_controller::BatchedDiffDriveController, controller_interface::ControllerInterface)
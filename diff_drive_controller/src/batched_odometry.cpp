@@ -0,0 +1,181 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "diff_drive_controller/batched_odometry.hpp"
+
+namespace diff_drive_controller
+{
+BatchedOdometry::BatchedOdometry(size_t velocity_rolling_window_size)
+{
+  setVelocityRollingWindowSize(velocity_rolling_window_size);
+}
+
+void BatchedOdometry::resize(size_t size)
+{
+  for (auto * values :
+       {&x_, &y_, &heading_, &linear_, &angular_, &wheel_separation_, &left_wheel_radius_,
+        &right_wheel_radius_, &left_wheel_old_pos_, &right_wheel_old_pos_, &linear_step_,
+        &angular_step_})
+  {
+    values->assign(size, 0.0);
+  }
+  velocity_initialized_ = false;
+}
+
+void BatchedOdometry::init()
+{
+  // Reset the velocity filter:
+  std::fill(linear_.begin(), linear_.end(), 0.0);
+  std::fill(angular_.begin(), angular_.end(), 0.0);
+  velocity_initialized_ = false;
+}
+
+bool BatchedOdometry::update(
+  const std::vector<double> & left_pos, const std::vector<double> & right_pos, double dt)
+{
+  // We cannot estimate the speed with very small time intervals:
+  if (dt < 0.0001)
+  {
+    return false;  // Interval too small to integrate with
+  }
+
+  const size_t n = size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double left_wheel_cur_pos = left_pos[i] * left_wheel_radius_[i];
+    const double right_wheel_cur_pos = right_pos[i] * right_wheel_radius_[i];
+
+    // Distance travelled by the wheels since the last update:
+    const double left_distance = left_wheel_cur_pos - left_wheel_old_pos_[i];
+    const double right_distance = right_wheel_cur_pos - right_wheel_old_pos_[i];
+
+    left_wheel_old_pos_[i] = left_wheel_cur_pos;
+    right_wheel_old_pos_[i] = right_wheel_cur_pos;
+
+    linear_step_[i] = (left_distance + right_distance) * 0.5;
+    angular_step_[i] = (right_distance - left_distance) / wheel_separation_[i];
+  }
+
+  integrate();
+  estimateVelocity(dt);
+  return true;
+}
+
+bool BatchedOdometry::updateFromVelocity(
+  const std::vector<double> & left_vel, const std::vector<double> & right_vel, double dt)
+{
+  if (dt < 0.0001)
+  {
+    return false;  // Interval too small to integrate with
+  }
+
+  const size_t n = size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double left_distance = left_vel[i] * left_wheel_radius_[i] * dt;
+    const double right_distance = right_vel[i] * right_wheel_radius_[i] * dt;
+
+    linear_step_[i] = (left_distance + right_distance) * 0.5;
+    angular_step_[i] = (right_distance - left_distance) / wheel_separation_[i];
+  }
+
+  integrate();
+  estimateVelocity(dt);
+  return true;
+}
+
+void BatchedOdometry::updateOpenLoop(
+  const std::vector<double> & linear, const std::vector<double> & angular, double dt)
+{
+  const size_t n = size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    // Save last linear and angular velocity:
+    linear_[i] = linear[i];
+    angular_[i] = angular[i];
+
+    linear_step_[i] = linear[i] * dt;
+    angular_step_[i] = angular[i] * dt;
+  }
+
+  integrate();
+}
+
+void BatchedOdometry::resetOdometry()
+{
+  std::fill(x_.begin(), x_.end(), 0.0);
+  std::fill(y_.begin(), y_.end(), 0.0);
+  std::fill(heading_.begin(), heading_.end(), 0.0);
+}
+
+void BatchedOdometry::setWheelParams(
+  size_t index, double wheel_separation, double left_wheel_radius, double right_wheel_radius)
+{
+  wheel_separation_[index] = wheel_separation;
+  left_wheel_radius_[index] = left_wheel_radius;
+  right_wheel_radius_[index] = right_wheel_radius;
+}
+
+void BatchedOdometry::setVelocityRollingWindowSize(size_t velocity_rolling_window_size)
+{
+  // same mean age of the samples as the rolling mean over the window
+  alpha_ = 2.0 / (static_cast<double>(std::max<size_t>(velocity_rolling_window_size, 1)) + 1.0);
+}
+
+void BatchedOdometry::integrate()
+{
+  const size_t n = size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double linear = linear_step_[i];
+    const double angular = angular_step_[i];
+    const double heading_old = heading_[i];
+    if (std::fabs(angular) < 1e-6)
+    {
+      /// Runge-Kutta 2nd order integration:
+      const double direction = heading_old + angular * 0.5;
+      x_[i] += linear * std::cos(direction);
+      y_[i] += linear * std::sin(direction);
+      heading_[i] += angular;
+    }
+    else
+    {
+      /// Exact integration (should solve problems when angular is zero):
+      const double r = linear / angular;
+      heading_[i] += angular;
+      x_[i] += r * (std::sin(heading_[i]) - std::sin(heading_old));
+      y_[i] += -r * (std::cos(heading_[i]) - std::cos(heading_old));
+    }
+  }
+}
+
+void BatchedOdometry::estimateVelocity(double dt)
+{
+  // the first sample after init() is taken as it is
+  const double alpha = velocity_initialized_ ? alpha_ : 1.0;
+  velocity_initialized_ = true;
+
+  const size_t n = size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    linear_[i] += alpha * (linear_step_[i] / dt - linear_[i]);
+    angular_[i] += alpha * (angular_step_[i] / dt - angular_[i]);
+  }
+}
+
+}  // namespace diff_drive_controller
@@ -16,8 +16,9 @@
  * Author: Bence Magyar, Enrique Fernández, Manuel Meraz
  */
 
+#include <array>
 #include <memory>
-#include <queue>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,6 +27,7 @@
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 #include "rclcpp/logging.hpp"
+#include "ros2_controllers_utils/publish_rate.hpp"
 #include "tf2/LinearMath/Quaternion.hpp"
 
 namespace
@@ -107,24 +109,38 @@ controller_interface::return_type DiffDriveController::update_reference_from_sub
 {
   auto logger = get_node()->get_logger();
 
-  auto current_ref_op = received_velocity_msg_.try_get();
-  if (current_ref_op.has_value())
+  if (params_.schedule_cmd_vel)
   {
-    command_msg_ = current_ref_op.value();
+    auto schedule_op = received_command_schedule_.try_get();
+    if (schedule_op.has_value())
+    {
+      command_schedule_ = schedule_op.value();
+    }
+    // keep the last command until the first scheduled one takes effect
+    command_schedule_.sample(
+      time.nanoseconds(), params_.interpolate_cmd_vel, velocity_command_.values,
+      velocity_command_.stamp);
+  }
+  else
+  {
+    auto current_ref_op = received_velocity_command_.try_get();
+    if (current_ref_op.has_value())
+    {
+      velocity_command_ = current_ref_op.value();
+    }
   }
 
-  const auto age_of_last_command = time - command_msg_.header.stamp;
+  const int64_t age_of_last_command = time.nanoseconds() - velocity_command_.stamp;
   // Brake if cmd_vel has timeout, override the stored command
-  if (age_of_last_command > cmd_vel_timeout_)
+  if (age_of_last_command > cmd_vel_timeout_.nanoseconds())
   {
     reference_interfaces_[0] = 0.0;
     reference_interfaces_[1] = 0.0;
   }
-  else if (
-    std::isfinite(command_msg_.twist.linear.x) && std::isfinite(command_msg_.twist.angular.z))
+  else if (velocity_command_.is_finite())
   {
-    reference_interfaces_[0] = command_msg_.twist.linear.x;
-    reference_interfaces_[1] = command_msg_.twist.angular.z;
+    reference_interfaces_[0] = velocity_command_.values[0];
+    reference_interfaces_[1] = velocity_command_.values[1];
   }
   else
   {
@@ -155,9 +171,7 @@ controller_interface::return_type DiffDriveController::update_and_write_commands
   }
 
   // Apply (possibly new) multipliers:
-  const double wheel_separation = params_.wheel_separation_multiplier * params_.wheel_separation;
-  const double left_wheel_radius = params_.left_wheel_radius_multiplier * params_.wheel_radius;
-  const double right_wheel_radius = params_.right_wheel_radius_multiplier * params_.wheel_radius;
+  const WheelParams wheels = get_wheel_params(params_);
 
   if (params_.open_loop)
   {
@@ -204,33 +218,23 @@ controller_interface::return_type DiffDriveController::update_and_write_commands
     else
     {
       odometry_.updateFromVelocity(
-        left_feedback_mean * left_wheel_radius * period.seconds(),
-        right_feedback_mean * right_wheel_radius * period.seconds(), time);
+        left_feedback_mean * wheels.left_radius * period.seconds(),
+        right_feedback_mean * wheels.right_radius * period.seconds(), time);
     }
   }
 
+  state_interfaces_values_[0] = odometry_.getX();
+  state_interfaces_values_[1] = odometry_.getY();
+  state_interfaces_values_[2] = odometry_.getHeading();
+  state_interfaces_values_[3] = odometry_.getLinear();
+  state_interfaces_values_[4] = odometry_.getAngular();
+
   tf2::Quaternion orientation;
   orientation.setRPY(0.0, 0.0, odometry_.getHeading());
 
-  bool should_publish = false;
-  try
+  if (ros2_controllers_utils::is_publish_due(publish_period_, previous_publish_timestamp_, time))
   {
-    if (previous_publish_timestamp_ + publish_period_ < time)
-    {
-      previous_publish_timestamp_ += publish_period_;
-      should_publish = true;
-    }
-  }
-  catch (const std::runtime_error &)
-  {
-    // Handle exceptions when the time source changes and initialize publish timestamp
-    previous_publish_timestamp_ = time;
-    should_publish = true;
-  }
-
-  if (should_publish)
-  {
-    if (realtime_odometry_publisher_->trylock())
+    if (params_.publish_odom && realtime_odometry_publisher_->trylock())
     {
       auto & odometry_message = realtime_odometry_publisher_->msg_;
       odometry_message.header.stamp = time;
@@ -259,15 +263,11 @@ controller_interface::return_type DiffDriveController::update_and_write_commands
     }
   }
 
-  double & last_linear = previous_two_commands_.back()[0];
-  double & second_to_last_linear = previous_two_commands_.front()[0];
-  double & last_angular = previous_two_commands_.back()[1];
-  double & second_to_last_angular = previous_two_commands_.front()[1];
-
-  limiter_linear_->limit(linear_command, last_linear, second_to_last_linear, period.seconds());
-  limiter_angular_->limit(angular_command, last_angular, second_to_last_angular, period.seconds());
-  previous_two_commands_.pop();
-  previous_two_commands_.push({{linear_command, angular_command}});
+  std::array<double, 2> command{{linear_command, angular_command}};
+  limiter_.limit(command, previous_two_commands_, period.seconds());
+  previous_two_commands_.push(command);
+  linear_command = command[0];
+  angular_command = command[1];
 
   //    Publish limited velocity
   if (publish_limited_velocity_ && realtime_limited_velocity_publisher_->trylock())
@@ -284,10 +284,9 @@ controller_interface::return_type DiffDriveController::update_and_write_commands
   }
 
   // Compute wheels velocities:
-  const double velocity_left =
-    (linear_command - angular_command * wheel_separation / 2.0) / left_wheel_radius;
-  const double velocity_right =
-    (linear_command + angular_command * wheel_separation / 2.0) / right_wheel_radius;
+  double velocity_left;
+  double velocity_right;
+  get_wheel_velocities(wheels, linear_command, angular_command, velocity_left, velocity_right);
 
   // Set wheels velocities:
   bool set_command_result = true;
@@ -325,13 +324,20 @@ controller_interface::CallbackReturn DiffDriveController::on_configure(
     return controller_interface::CallbackReturn::ERROR;
   }
 
-  const double wheel_separation = params_.wheel_separation_multiplier * params_.wheel_separation;
-  const double left_wheel_radius = params_.left_wheel_radius_multiplier * params_.wheel_radius;
-  const double right_wheel_radius = params_.right_wheel_radius_multiplier * params_.wheel_radius;
-
-  odometry_.setWheelParams(wheel_separation, left_wheel_radius, right_wheel_radius);
+  const WheelParams wheels = get_wheel_params(params_);
+  odometry_.setWheelParams(wheels.separation, wheels.left_radius, wheels.right_radius);
   odometry_.setVelocityRollingWindowSize(static_cast<size_t>(params_.velocity_rolling_window_size));
 
+  ros2_controllers_utils::VelocityEstimator::Type velocity_estimator_type;
+  if (!ros2_controllers_utils::VelocityEstimator::type_from_string(
+        params_.velocity_estimator, velocity_estimator_type))
+  {
+    RCLCPP_ERROR(logger, "Unknown velocity estimator '%s'", params_.velocity_estimator.c_str());
+    return controller_interface::CallbackReturn::ERROR;
+  }
+  odometry_.setVelocityEstimatorType(velocity_estimator_type);
+  odometry_.setHistorySize(static_cast<size_t>(params_.odom_history_size));
+
   cmd_vel_timeout_ = rclcpp::Duration::from_seconds(params_.cmd_vel_timeout);
   publish_limited_velocity_ = params_.publish_limited_velocity;
 
@@ -339,17 +345,19 @@ controller_interface::CallbackReturn DiffDriveController::on_configure(
   const int nr_ref_itfs = 2;
   reference_interfaces_.resize(nr_ref_itfs, std::numeric_limits<double>::quiet_NaN());
 
-  limiter_linear_ = std::make_unique<SpeedLimiter>(
-    params_.linear.x.min_velocity, params_.linear.x.max_velocity,
-    params_.linear.x.max_acceleration_reverse, params_.linear.x.max_acceleration,
-    params_.linear.x.max_deceleration, params_.linear.x.max_deceleration_reverse,
-    params_.linear.x.min_jerk, params_.linear.x.max_jerk);
+  // Allocate state interfaces for the odometry: x, y, yaw, linear and angular velocity
+  const int nr_state_itfs = 5;
+  state_interfaces_values_.resize(nr_state_itfs, std::numeric_limits<double>::quiet_NaN());
 
-  limiter_angular_ = std::make_unique<SpeedLimiter>(
-    params_.angular.z.min_velocity, params_.angular.z.max_velocity,
-    params_.angular.z.max_acceleration_reverse, params_.angular.z.max_acceleration,
-    params_.angular.z.max_deceleration, params_.angular.z.max_deceleration_reverse,
-    params_.angular.z.min_jerk, params_.angular.z.max_jerk);
+  try
+  {
+    limiter_ = make_speed_limiter(params_);
+  }
+  catch (const std::invalid_argument & e)
+  {
+    RCLCPP_ERROR(logger, "Error configuring speed limiter: %s", e.what());
+    return controller_interface::CallbackReturn::ERROR;
+  }
 
   if (!reset())
   {
@@ -393,7 +401,20 @@ controller_interface::CallbackReturn DiffDriveController::on_configure(
         cmd_vel_timeout_ == rclcpp::Duration::from_seconds(0.0) ||
         current_time_diff < cmd_vel_timeout_)
       {
-        received_velocity_msg_.set(*msg);
+        if (params_.schedule_cmd_vel)
+        {
+          pending_commands_.drop_superseded(get_node()->now().nanoseconds());
+          pending_commands_.insert(
+            rclcpp::Time(msg->header.stamp).nanoseconds(),
+            {{msg->twist.linear.x, msg->twist.angular.z}});
+          received_command_schedule_.set(pending_commands_);
+        }
+        else
+        {
+          received_velocity_command_.set(
+            {rclcpp::Time(msg->header.stamp).nanoseconds(),
+             {{msg->twist.linear.x, msg->twist.angular.z}}});
+        }
       }
       else
       {
@@ -558,22 +579,17 @@ void DiffDriveController::reset_buffers()
   std::fill(
     reference_interfaces_.begin(), reference_interfaces_.end(),
     std::numeric_limits<double>::quiet_NaN());
-  // Empty out the old queue. Fill with zeros (not NaN) to catch early accelerations.
-  std::queue<std::array<double, 2>> empty;
-  std::swap(previous_two_commands_, empty);
-  previous_two_commands_.push({{0.0, 0.0}});
-  previous_two_commands_.push({{0.0, 0.0}});
+  // Fill the command history with zeros (not NaN) to catch early accelerations.
+  previous_two_commands_.fill({{0.0, 0.0}});
 
   // Fill RealtimeBox with NaNs so it will contain a known value
   // but still indicate that no command has yet been sent.
-  command_msg_.header.stamp = get_node()->now();
-  command_msg_.twist.linear.x = std::numeric_limits<double>::quiet_NaN();
-  command_msg_.twist.linear.y = std::numeric_limits<double>::quiet_NaN();
-  command_msg_.twist.linear.z = std::numeric_limits<double>::quiet_NaN();
-  command_msg_.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
-  command_msg_.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
-  command_msg_.twist.angular.z = std::numeric_limits<double>::quiet_NaN();
-  received_velocity_msg_.set(command_msg_);
+  velocity_command_.reset(get_node()->now().nanoseconds());
+  received_velocity_command_.set(velocity_command_);
+
+  pending_commands_.clear();
+  command_schedule_.clear();
+  received_command_schedule_.set(command_schedule_);
 }
 
 void DiffDriveController::halt()
@@ -649,6 +665,12 @@ controller_interface::CallbackReturn DiffDriveController::configure_side(
   return controller_interface::CallbackReturn::SUCCESS;
 }
 
+bool DiffDriveController::get_odometry_at(
+  const rclcpp::Time & time, ros2_controllers_utils::OdometrySample & sample) const
+{
+  return odometry_.getHistory().lookup(time.nanoseconds(), sample);
+}
+
 bool DiffDriveController::on_set_chained_mode(bool /*chained_mode*/) { return true; }
 
 std::vector<hardware_interface::CommandInterface>
@@ -670,6 +692,31 @@ DiffDriveController::on_export_reference_interfaces()
   return reference_interfaces;
 }
 
+std::vector<hardware_interface::StateInterface> DiffDriveController::on_export_state_interfaces()
+{
+  std::vector<hardware_interface::StateInterface> state_interfaces;
+  state_interfaces.reserve(state_interfaces_values_.size());
+
+  const std::string prefix = get_node()->get_name();
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/x", HW_IF_POSITION, &state_interfaces_values_[0]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/y", HW_IF_POSITION, &state_interfaces_values_[1]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/yaw", HW_IF_POSITION, &state_interfaces_values_[2]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/linear", HW_IF_VELOCITY, &state_interfaces_values_[3]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/angular", HW_IF_VELOCITY, &state_interfaces_values_[4]));
+
+  return state_interfaces;
+}
+
 }  // namespace diff_drive_controller
 
 #include "class_loader/register_macro.hpp"
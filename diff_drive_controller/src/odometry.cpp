@@ -35,15 +35,17 @@ Odometry::Odometry(size_t velocity_rolling_window_size)
   left_wheel_old_pos_(0.0),
   right_wheel_old_pos_(0.0),
   velocity_rolling_window_size_(velocity_rolling_window_size),
-  linear_accumulator_(velocity_rolling_window_size),
-  angular_accumulator_(velocity_rolling_window_size)
+  velocity_estimator_type_(ros2_controllers_utils::VelocityEstimator::Type::ROLLING_MEAN),
+  linear_accumulator_(velocity_estimator_type_, velocity_rolling_window_size),
+  angular_accumulator_(velocity_estimator_type_, velocity_rolling_window_size)
 {
 }
 
 void Odometry::init(const rclcpp::Time & time)
 {
-  // Reset accumulators and timestamp:
+  // Reset accumulators, history and timestamp:
   resetAccumulators();
+  history_.clear();
   timestamp_ = time;
 }
 
@@ -90,12 +92,14 @@ bool Odometry::updateFromVelocity(double left_vel, double right_vel, const rclcp
 
   timestamp_ = time;
 
-  // Estimate speeds using a rolling mean to filter them out:
+  // Estimate speeds using the velocity estimators to filter them out:
   linear_accumulator_.accumulate(linear / dt);
   angular_accumulator_.accumulate(angular / dt);
 
-  linear_ = linear_accumulator_.getRollingMean();
-  angular_ = angular_accumulator_.getRollingMean();
+  linear_ = linear_accumulator_.get_estimate();
+  angular_ = angular_accumulator_.get_estimate();
+
+  pushHistory();
 
   return true;
 }
@@ -110,6 +114,8 @@ void Odometry::updateOpenLoop(double linear, double angular, const rclcpp::Time
   const double dt = time.seconds() - timestamp_.seconds();
   timestamp_ = time;
   integrateExact(linear * dt, angular * dt);
+
+  pushHistory();
 }
 
 void Odometry::resetOdometry()
@@ -117,6 +123,7 @@ void Odometry::resetOdometry()
   x_ = 0.0;
   y_ = 0.0;
   heading_ = 0.0;
+  history_.clear();
 }
 
 void Odometry::setWheelParams(
@@ -131,7 +138,21 @@ void Odometry::setVelocityRollingWindowSize(size_t velocity_rolling_window_size)
 {
   velocity_rolling_window_size_ = velocity_rolling_window_size;
 
-  resetAccumulators();
+  linear_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+  angular_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+}
+
+void Odometry::setVelocityEstimatorType(ros2_controllers_utils::VelocityEstimator::Type type)
+{
+  velocity_estimator_type_ = type;
+
+  linear_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+  angular_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+}
+
+void Odometry::setHistorySize(size_t history_size)
+{
+  history_.resize(history_size);
 }
 
 void Odometry::integrateRungeKutta2(double linear, double angular)
@@ -163,8 +184,20 @@ void Odometry::integrateExact(double linear, double angular)
 
 void Odometry::resetAccumulators()
 {
-  linear_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
-  angular_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
+  linear_accumulator_.reset();
+  angular_accumulator_.reset();
+}
+
+void Odometry::pushHistory()
+{
+  ros2_controllers_utils::OdometrySample sample;
+  sample.stamp = timestamp_.nanoseconds();
+  sample.x = x_;
+  sample.y = y_;
+  sample.heading = heading_;
+  sample.linear_x = linear_;
+  sample.angular_z = angular_;
+  history_.push(sample);
 }
 
 }  // namespace diff_drive_controller
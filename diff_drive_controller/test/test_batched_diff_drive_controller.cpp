@@ -0,0 +1,355 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "diff_drive_controller/batched_diff_drive_controller.hpp"
+#include "hardware_interface/loaned_command_interface.hpp"
+#include "hardware_interface/loaned_state_interface.hpp"
+#include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "lifecycle_msgs/msg/state.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/executors.hpp"
+
+using CallbackReturn = controller_interface::CallbackReturn;
+using hardware_interface::HW_IF_VELOCITY;
+using hardware_interface::LoanedCommandInterface;
+using hardware_interface::LoanedStateInterface;
+using lifecycle_msgs::msg::State;
+using testing::ElementsAre;
+
+class TestableBatchedDiffDriveController
+: public diff_drive_controller::BatchedDiffDriveController
+{
+public:
+  using BatchedDiffDriveController::BatchedDiffDriveController;
+
+  void wait_for_twist(
+    rclcpp::Executor & executor,
+    const std::chrono::milliseconds & timeout = std::chrono::milliseconds(500))
+  {
+    auto until = get_node()->get_clock()->now() + timeout;
+    while (get_node()->get_clock()->now() < until)
+    {
+      executor.spin_some();
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+  }
+
+  const std_msgs::msg::Float64MultiArray & get_odometry_message() const
+  {
+    return realtime_odometry_publisher_->msg_;
+  }
+
+  const tf2_msgs::msg::TFMessage & get_transform_message() const
+  {
+    return realtime_odometry_transform_publisher_->msg_;
+  }
+
+  const diff_drive_controller::BatchedOdometry & get_odometry() const { return odometry_; }
+};
+
+class TestBatchedDiffDriveController : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    controller_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    controller_ = std::make_unique<TestableBatchedDiffDriveController>();
+
+    pub_node = std::make_shared<rclcpp::Node>("velocity_publisher");
+    velocity_publisher = pub_node->create_publisher<geometry_msgs::msg::TwistStamped>(
+      controller_name + "/robot_b/cmd_vel", rclcpp::SystemDefaultsQoS());
+  }
+
+  static void TearDownTestCase() { rclcpp::shutdown(); }
+
+  void publish(double linear, double angular)
+  {
+    int wait_count = 0;
+    auto topic = velocity_publisher->get_topic_name();
+    while (pub_node->count_subscribers(topic) == 0)
+    {
+      if (wait_count >= 5)
+      {
+        auto error_msg = std::string("publishing to ") + topic + " but no node subscribes to it";
+        throw std::runtime_error(error_msg);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      ++wait_count;
+    }
+
+    geometry_msgs::msg::TwistStamped velocity_message;
+    velocity_message.header.stamp = pub_node->get_clock()->now();
+    velocity_message.twist.linear.x = linear;
+    velocity_message.twist.angular.z = angular;
+    velocity_publisher->publish(velocity_message);
+  }
+
+  void assignResources()
+  {
+    std::vector<LoanedCommandInterface> command_ifs;
+    command_ifs.emplace_back(a_left_cmd_);
+    command_ifs.emplace_back(a_right_cmd_);
+    command_ifs.emplace_back(b_left_1_cmd_);
+    command_ifs.emplace_back(b_left_2_cmd_);
+    command_ifs.emplace_back(b_right_1_cmd_);
+    command_ifs.emplace_back(b_right_2_cmd_);
+    controller_->assign_interfaces(std::move(command_ifs), {});
+  }
+
+  controller_interface::return_type InitController(
+    const std::vector<rclcpp::Parameter> & parameters = {})
+  {
+    auto node_options = rclcpp::NodeOptions();
+    std::vector<rclcpp::Parameter> parameter_overrides = {
+      rclcpp::Parameter("robots", std::vector<std::string>{"robot_a", "robot_b"}),
+      rclcpp::Parameter("fleet.robot_a.left_wheel_names", std::vector<std::string>{"a_left"}),
+      rclcpp::Parameter("fleet.robot_a.right_wheel_names", std::vector<std::string>{"a_right"}),
+      rclcpp::Parameter("fleet.robot_a.wheel_separation", 0.5),
+      rclcpp::Parameter("fleet.robot_a.wheel_radius", 0.1),
+      rclcpp::Parameter(
+        "fleet.robot_b.left_wheel_names", std::vector<std::string>{"b_left_1", "b_left_2"}),
+      rclcpp::Parameter(
+        "fleet.robot_b.right_wheel_names", std::vector<std::string>{"b_right_1", "b_right_2"}),
+      rclcpp::Parameter("fleet.robot_b.wheel_separation", 0.4),
+      rclcpp::Parameter("fleet.robot_b.wheel_radius", 0.2),
+      rclcpp::Parameter("open_loop", true)};
+
+    parameter_overrides.insert(parameter_overrides.end(), parameters.begin(), parameters.end());
+    node_options.parameter_overrides(parameter_overrides);
+
+    return controller_->init(controller_name, urdf_, 0, "", node_options);
+  }
+
+  std::string controller_name;
+  std::unique_ptr<TestableBatchedDiffDriveController> controller_;
+
+  // robot_a: a_left, a_right, robot_b: b_left_1, b_left_2, b_right_1, b_right_2
+  std::vector<double> command_values_ = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+  hardware_interface::CommandInterface a_left_cmd_{"a_left", HW_IF_VELOCITY, &command_values_[0]};
+  hardware_interface::CommandInterface a_right_cmd_{"a_right", HW_IF_VELOCITY, &command_values_[1]};
+  hardware_interface::CommandInterface b_left_1_cmd_{
+    "b_left_1", HW_IF_VELOCITY, &command_values_[2]};
+  hardware_interface::CommandInterface b_left_2_cmd_{
+    "b_left_2", HW_IF_VELOCITY, &command_values_[3]};
+  hardware_interface::CommandInterface b_right_1_cmd_{
+    "b_right_1", HW_IF_VELOCITY, &command_values_[4]};
+  hardware_interface::CommandInterface b_right_2_cmd_{
+    "b_right_2", HW_IF_VELOCITY, &command_values_[5]};
+
+  rclcpp::Node::SharedPtr pub_node;
+  rclcpp::Publisher<geometry_msgs::msg::TwistStamped>::SharedPtr velocity_publisher;
+
+  const std::string urdf_ = "";
+};
+
+TEST_F(TestBatchedDiffDriveController, init_fails_without_robots)
+{
+  const auto ret =
+    controller_->init(controller_name, urdf_, 0, "", controller_->define_custom_node_options());
+  ASSERT_EQ(ret, controller_interface::return_type::ERROR);
+}
+
+TEST_F(TestBatchedDiffDriveController, configure_fails_with_mismatching_wheel_side_size)
+{
+  ASSERT_EQ(
+    InitController({rclcpp::Parameter(
+      "fleet.robot_a.right_wheel_names", std::vector<std::string>{"a_right", "extra_wheel"})}),
+    controller_interface::return_type::OK);
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), CallbackReturn::ERROR);
+}
+
+TEST_F(TestBatchedDiffDriveController, interface_configuration_in_order_of_robots)
+{
+  ASSERT_EQ(
+    InitController({rclcpp::Parameter("open_loop", false)}),
+    controller_interface::return_type::OK);
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), CallbackReturn::SUCCESS);
+
+  EXPECT_THAT(
+    controller_->command_interface_configuration().names,
+    ElementsAre(
+      "a_left/velocity", "a_right/velocity", "b_left_1/velocity", "b_left_2/velocity",
+      "b_right_1/velocity", "b_right_2/velocity"));
+  EXPECT_THAT(
+    controller_->state_interface_configuration().names,
+    ElementsAre(
+      "a_left/position", "a_right/position", "b_left_1/position", "b_left_2/position",
+      "b_right_1/position", "b_right_2/position"));
+}
+
+TEST_F(TestBatchedDiffDriveController, activate_fails_without_command_interfaces)
+{
+  ASSERT_EQ(InitController(), controller_interface::return_type::OK);
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), CallbackReturn::SUCCESS);
+
+  std::vector<LoanedCommandInterface> command_ifs;
+  command_ifs.emplace_back(a_left_cmd_);
+  command_ifs.emplace_back(a_right_cmd_);
+  controller_->assign_interfaces(std::move(command_ifs), {});
+
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), CallbackReturn::ERROR);
+}
+
+TEST_F(TestBatchedDiffDriveController, commands_robots_independently)
+{
+  ASSERT_EQ(InitController(), controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResources();
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  // only robot_b is commanded
+  const double linear = 1.0;
+  const double angular = 0.5;
+  publish(linear, angular);
+  controller_->wait_for_twist(executor);
+
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+
+  EXPECT_EQ(0.0, command_values_[0]);
+  EXPECT_EQ(0.0, command_values_[1]);
+  const double left = (linear - angular * 0.4 / 2.0) / 0.2;
+  const double right = (linear + angular * 0.4 / 2.0) / 0.2;
+  EXPECT_DOUBLE_EQ(left, command_values_[2]);
+  EXPECT_DOUBLE_EQ(left, command_values_[3]);
+  EXPECT_DOUBLE_EQ(right, command_values_[4]);
+  EXPECT_DOUBLE_EQ(right, command_values_[5]);
+
+  // odometry of all robots in one message, in the order of robots
+  constexpr size_t offset = TestableBatchedDiffDriveController::ODOMETRY_DATA_OFFSET;
+  constexpr size_t values = TestableBatchedDiffDriveController::ODOMETRY_VALUES_PER_ROBOT;
+  const auto & odometry_message = controller_->get_odometry_message();
+  ASSERT_EQ(odometry_message.data.size(), offset + 2 * values);
+  EXPECT_EQ(odometry_message.layout.data_offset, offset);
+  EXPECT_EQ(odometry_message.data[offset + 3], 0.0);
+  EXPECT_EQ(odometry_message.data[offset + values + 3], linear);
+  EXPECT_EQ(odometry_message.data[offset + values + 4], angular);
+
+  const auto & transforms = controller_->get_transform_message().transforms;
+  ASSERT_EQ(transforms.size(), 2u);
+  EXPECT_EQ(transforms[0].header.frame_id, "robot_a/odom");
+  EXPECT_EQ(transforms[1].child_frame_id, "robot_b/base_link");
+  EXPECT_GT(transforms[1].transform.translation.x, 0.0);
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  for (const double value : command_values_)
+  {
+    EXPECT_EQ(0.0, value) << "Wheels are halted on deactivate()";
+  }
+
+  executor.cancel();
+}
+
+TEST_F(TestBatchedDiffDriveController, limits_robots_independently)
+{
+  // only robot_b is limited, with the parameters of diff_drive_controller under fleet.robot_b
+  ASSERT_EQ(
+    InitController(
+      {rclcpp::Parameter("fleet.robot_b.linear.x.max_velocity", 0.5),
+       rclcpp::Parameter("fleet.robot_b.wheel_separation_multiplier", 2.0)}),
+    controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResources();
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  const double angular = 0.5;
+  publish(1.0, angular);
+  controller_->wait_for_twist(executor);
+
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+
+  const double linear = 0.5;
+  const double wheel_separation = 2.0 * 0.4;
+  EXPECT_DOUBLE_EQ((linear - angular * wheel_separation / 2.0) / 0.2, command_values_[2]);
+  EXPECT_DOUBLE_EQ((linear + angular * wheel_separation / 2.0) / 0.2, command_values_[5]);
+
+  executor.cancel();
+}
+
+TEST_F(TestBatchedDiffDriveController, odometry_is_reset_on_activate)
+{
+  ASSERT_EQ(InitController(), controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResources();
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  publish(1.0, 0.5);
+  controller_->wait_for_twist(executor);
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_EQ(
+      controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+      controller_interface::return_type::OK);
+  }
+  ASSERT_GT(controller_->get_odometry().getX()[1], 0.0);
+  ASSERT_GT(controller_->get_odometry().getLinear()[1], 0.0);
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResources();
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    EXPECT_EQ(0.0, controller_->get_odometry().getX()[i]);
+    EXPECT_EQ(0.0, controller_->get_odometry().getY()[i]);
+    EXPECT_EQ(0.0, controller_->get_odometry().getHeading()[i]);
+    EXPECT_EQ(0.0, controller_->get_odometry().getLinear()[i]);
+    EXPECT_EQ(0.0, controller_->get_odometry().getAngular()[i]);
+  }
+
+  executor.cancel();
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -0,0 +1,184 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "diff_drive_controller/batched_odometry.hpp"
+#include "diff_drive_controller/odometry.hpp"
+
+using diff_drive_controller::BatchedOdometry;
+using diff_drive_controller::Odometry;
+using ros2_controllers_utils::VelocityEstimator;
+
+namespace
+{
+constexpr size_t kRobots = 5;
+constexpr double kDt = 0.01;
+constexpr int64_t kDtNanoseconds = 10000000;
+
+class TestBatchedOdometry : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    batched_.resize(kRobots);
+    for (size_t i = 0; i < kRobots; ++i)
+    {
+      const double wheel_separation = 0.4 + 0.1 * static_cast<double>(i);
+      const double left_wheel_radius = 0.1 + 0.01 * static_cast<double>(i);
+      const double right_wheel_radius = 0.1 - 0.005 * static_cast<double>(i);
+      batched_.setWheelParams(i, wheel_separation, left_wheel_radius, right_wheel_radius);
+
+      single_.emplace_back(kWindow);
+      single_.back().setWheelParams(wheel_separation, left_wheel_radius, right_wheel_radius);
+      single_.back().setVelocityEstimatorType(VelocityEstimator::Type::EXPONENTIAL);
+      single_.back().init(rclcpp::Time(0));
+    }
+    batched_.setVelocityRollingWindowSize(kWindow);
+    batched_.init();
+  }
+
+  void expect_same_odometry()
+  {
+    for (size_t i = 0; i < kRobots; ++i)
+    {
+      EXPECT_DOUBLE_EQ(batched_.getX()[i], single_[i].getX()) << "robot " << i;
+      EXPECT_DOUBLE_EQ(batched_.getY()[i], single_[i].getY()) << "robot " << i;
+      EXPECT_DOUBLE_EQ(batched_.getHeading()[i], single_[i].getHeading()) << "robot " << i;
+      EXPECT_DOUBLE_EQ(batched_.getLinear()[i], single_[i].getLinear()) << "robot " << i;
+      EXPECT_DOUBLE_EQ(batched_.getAngular()[i], single_[i].getAngular()) << "robot " << i;
+    }
+  }
+
+  static constexpr size_t kWindow = 5;
+  BatchedOdometry batched_;
+  std::deque<Odometry> single_;
+  std::mt19937 gen_{42};
+};
+}  // namespace
+
+TEST_F(TestBatchedOdometry, resize)
+{
+  ASSERT_EQ(batched_.size(), kRobots);
+  for (size_t i = 0; i < kRobots; ++i)
+  {
+    EXPECT_EQ(batched_.getX()[i], 0.0);
+    EXPECT_EQ(batched_.getY()[i], 0.0);
+    EXPECT_EQ(batched_.getHeading()[i], 0.0);
+    EXPECT_EQ(batched_.getLinear()[i], 0.0);
+    EXPECT_EQ(batched_.getAngular()[i], 0.0);
+  }
+}
+
+TEST_F(TestBatchedOdometry, update_from_position_as_single_odometry)
+{
+  std::uniform_real_distribution<double> velocity(-5.0, 5.0);
+  std::vector<double> left_pos(kRobots, 0.0);
+  std::vector<double> right_pos(kRobots, 0.0);
+  rclcpp::Time previous_time(0);
+  for (int64_t step = 1; step <= 200; ++step)
+  {
+    const rclcpp::Time time(step * kDtNanoseconds);
+    // same rounding as the time step of the single odometry
+    const double dt = time.seconds() - previous_time.seconds();
+    previous_time = time;
+    for (size_t i = 0; i < kRobots; ++i)
+    {
+      // every other robot drives straight
+      left_pos[i] += velocity(gen_) * dt;
+      right_pos[i] = i % 2 ? left_pos[i] : right_pos[i] + velocity(gen_) * dt;
+      ASSERT_TRUE(single_[i].update(left_pos[i], right_pos[i], time));
+    }
+    ASSERT_TRUE(batched_.update(left_pos, right_pos, dt));
+  }
+  expect_same_odometry();
+}
+
+TEST_F(TestBatchedOdometry, update_from_velocity_as_single_odometry)
+{
+  std::uniform_real_distribution<double> velocity(-5.0, 5.0);
+  std::vector<double> left_vel(kRobots);
+  std::vector<double> right_vel(kRobots);
+  rclcpp::Time previous_time(0);
+  for (int64_t step = 1; step <= 200; ++step)
+  {
+    const rclcpp::Time time(step * kDtNanoseconds);
+    // same rounding as the time step of the single odometry
+    const double dt = time.seconds() - previous_time.seconds();
+    previous_time = time;
+    for (size_t i = 0; i < kRobots; ++i)
+    {
+      left_vel[i] = velocity(gen_);
+      right_vel[i] = i % 2 ? left_vel[i] : velocity(gen_);
+      const double left_wheel_radius = 0.1 + 0.01 * static_cast<double>(i);
+      const double right_wheel_radius = 0.1 - 0.005 * static_cast<double>(i);
+      ASSERT_TRUE(single_[i].updateFromVelocity(
+        left_vel[i] * left_wheel_radius * dt, right_vel[i] * right_wheel_radius * dt, time));
+    }
+    ASSERT_TRUE(batched_.updateFromVelocity(left_vel, right_vel, dt));
+  }
+  expect_same_odometry();
+}
+
+TEST_F(TestBatchedOdometry, update_open_loop_as_single_odometry)
+{
+  std::uniform_real_distribution<double> velocity(-1.0, 1.0);
+  std::vector<double> linear(kRobots);
+  std::vector<double> angular(kRobots);
+  rclcpp::Time previous_time(0);
+  for (int64_t step = 1; step <= 200; ++step)
+  {
+    const rclcpp::Time time(step * kDtNanoseconds);
+    // same rounding as the time step of the single odometry
+    const double dt = time.seconds() - previous_time.seconds();
+    previous_time = time;
+    for (size_t i = 0; i < kRobots; ++i)
+    {
+      linear[i] = velocity(gen_);
+      angular[i] = i % 2 ? 0.0 : velocity(gen_);
+      single_[i].updateOpenLoop(linear[i], angular[i], time);
+    }
+    batched_.updateOpenLoop(linear, angular, dt);
+  }
+  expect_same_odometry();
+}
+
+TEST_F(TestBatchedOdometry, small_time_step_is_ignored)
+{
+  const std::vector<double> pos(kRobots, 1.0);
+  EXPECT_FALSE(batched_.update(pos, pos, 0.00001));
+  EXPECT_FALSE(batched_.updateFromVelocity(pos, pos, 0.00001));
+  EXPECT_EQ(batched_.getX()[0], 0.0);
+  EXPECT_EQ(batched_.getLinear()[0], 0.0);
+}
+
+TEST_F(TestBatchedOdometry, reset_odometry)
+{
+  const std::vector<double> velocity(kRobots, 1.0);
+  batched_.updateOpenLoop(velocity, velocity, kDt);
+  ASSERT_NE(batched_.getX()[0], 0.0);
+
+  batched_.resetOdometry();
+  for (size_t i = 0; i < kRobots; ++i)
+  {
+    EXPECT_EQ(batched_.getX()[i], 0.0);
+    EXPECT_EQ(batched_.getY()[i], 0.0);
+    EXPECT_EQ(batched_.getHeading()[i], 0.0);
+  }
+}
@@ -78,6 +78,7 @@ public:
   FRIEND_TEST(TestDiffDriveController, chainable_controller_unchained_mode);
   FRIEND_TEST(TestDiffDriveController, chainable_controller_chained_mode);
   FRIEND_TEST(TestDiffDriveController, deactivate_then_activate);
+  FRIEND_TEST(TestDiffDriveController, odometry_is_exported_as_state_interfaces);
 };
 
 class TestDiffDriveController : public ::testing::Test
@@ -1071,6 +1072,61 @@ TEST_F(TestDiffDriveController, reference_interfaces_are_properly_exported)
   EXPECT_EQ(reference_interfaces[1]->get_interface_name(), hardware_interface::HW_IF_VELOCITY);
 }
 
+TEST_F(TestDiffDriveController, odometry_is_exported_as_state_interfaces)
+{
+  ASSERT_EQ(
+    InitController(
+      left_wheel_names, right_wheel_names,
+      {rclcpp::Parameter("open_loop", true), rclcpp::Parameter("publish_odom", false)}),
+    controller_interface::return_type::OK);
+
+  ASSERT_TRUE(controller_->set_chained_mode(true));
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResourcesNoFeedback();
+
+  auto state_interfaces = controller_->export_state_interfaces();
+  ASSERT_EQ(state_interfaces.size(), 5)
+    << "Expected exactly 5 state interfaces: x, y, yaw, linear and angular";
+
+  const std::string prefix = controller_->get_node()->get_name();
+  const std::vector<std::pair<std::string, std::string>> expected_interfaces = {
+    {"/x", hardware_interface::HW_IF_POSITION},
+    {"/y", hardware_interface::HW_IF_POSITION},
+    {"/yaw", hardware_interface::HW_IF_POSITION},
+    {"/linear", hardware_interface::HW_IF_VELOCITY},
+    {"/angular", hardware_interface::HW_IF_VELOCITY}};
+  for (size_t i = 0; i < expected_interfaces.size(); ++i)
+  {
+    EXPECT_EQ(state_interfaces[i]->get_prefix_name(), prefix + expected_interfaces[i].first);
+    EXPECT_EQ(state_interfaces[i]->get_interface_name(), expected_interfaces[i].second);
+    // the odometry is not exported before the first update
+    EXPECT_TRUE(std::isnan(state_interfaces[i]->get_optional().value()));
+  }
+
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  const double linear = 3.0;
+  const double angular = 0.5;
+  controller_->reference_interfaces_[0] = linear;
+  controller_->reference_interfaces_[1] = angular;
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.1)),
+    controller_interface::return_type::OK);
+  ASSERT_EQ(
+    controller_->update(
+      rclcpp::Time(0, 100000000, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.1)),
+    controller_interface::return_type::OK);
+
+  // the exported values are updated in the same cycle as the odometry
+  EXPECT_GT(state_interfaces[0]->get_optional().value(), 0.0);
+  EXPECT_GT(state_interfaces[1]->get_optional().value(), 0.0);
+  EXPECT_NEAR(state_interfaces[2]->get_optional().value(), angular * 0.1, 1e-9);
+  EXPECT_NEAR(state_interfaces[3]->get_optional().value(), linear, 1e-9);
+  EXPECT_NEAR(state_interfaces[4]->get_optional().value(), angular, 1e-9);
+}
+
 // Make sure that the controller is properly reset when deactivated
 // and accepts new commands as expected when it is activated again.
 TEST_F(TestDiffDriveController, deactivate_then_activate)
@@ -1215,6 +1271,65 @@ TEST_F(TestDiffDriveController, command_with_zero_timestamp_is_accepted_with_war
   executor.cancel();
 }
 
+TEST_F(TestDiffDriveController, scheduled_commands_take_effect_at_their_stamps)
+{
+  ASSERT_EQ(
+    InitController(
+      left_wheel_names, right_wheel_names,
+      {rclcpp::Parameter("wheel_separation", 0.4), rclcpp::Parameter("wheel_radius", 1.0),
+       rclcpp::Parameter("schedule_cmd_vel", true)}),
+    controller_interface::return_type::OK);
+  // choose radius = 1 so that the command values (rev/s) are the same as the linear velocity (m/s)
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  ASSERT_TRUE(controller_->set_chained_mode(false));
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResourcesPosFeedback();
+
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  waitForSetup();
+
+  // the second command is stamped in the future and published first
+  const rclcpp::Time start = pub_node->get_clock()->now();
+  publish_timestamped(2.0, 0.0, start + rclcpp::Duration::from_seconds(0.2));
+  publish_timestamped(1.0, 0.0, start);
+  controller_->wait_for_twist(executor);
+
+  ASSERT_EQ(
+    controller_->update(
+      start + rclcpp::Duration::from_seconds(0.1), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(1.0, left_wheel_vel_cmd_.get_optional().value());
+  EXPECT_EQ(1.0, right_wheel_vel_cmd_.get_optional().value());
+
+  ASSERT_EQ(
+    controller_->update(
+      start + rclcpp::Duration::from_seconds(0.2), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(2.0, left_wheel_vel_cmd_.get_optional().value());
+  EXPECT_EQ(2.0, right_wheel_vel_cmd_.get_optional().value());
+
+  // the timeout applies from the stamp of the command in effect
+  ASSERT_EQ(
+    controller_->update(
+      start + rclcpp::Duration::from_seconds(0.8), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(0.0, left_wheel_vel_cmd_.get_optional().value());
+  EXPECT_EQ(0.0, right_wheel_vel_cmd_.get_optional().value());
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(state.id(), State::PRIMARY_STATE_INACTIVE);
+  state = controller_->get_node()->cleanup();
+  ASSERT_EQ(state.id(), State::PRIMARY_STATE_UNCONFIGURED);
+  executor.cancel();
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -81,7 +81,7 @@ private:
     std::size_t command_interface_index) const;
   bool should_broadcast_all_interfaces_of_configured_gpios() const;
   void set_all_state_interfaces_of_configured_gpios();
-  InterfacesNames get_gpios_state_interfaces_names(const std::string & gpio_name) const;
+  std::unordered_map<std::string, InterfacesNames> get_gpios_state_interfaces_names() const;
   bool update_dynamic_map_parameters();
   std::vector<hardware_interface::ComponentInfo> get_gpios_from_urdf() const;
 
@@ -15,6 +15,9 @@
 #include "gpio_controllers/gpio_command_controller.hpp"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "controller_interface/helpers.hpp"
 #include "hardware_interface/component_parser.hpp"
@@ -213,18 +216,26 @@ catch (const std::exception & e)
 void GpioCommandController::set_all_state_interfaces_of_configured_gpios()
 {
   const auto gpios{get_gpios_from_urdf()};
+  std::unordered_map<std::string, std::vector<const hardware_interface::ComponentInfo *>>
+    gpios_by_name;
+  for (const auto & gpio : gpios)
+  {
+    gpios_by_name[gpio.name].push_back(&gpio);
+  }
   for (const auto & gpio_name : params_.gpios)
   {
-    for (const auto & gpio : gpios)
+    const auto it = gpios_by_name.find(gpio_name);
+    if (it == gpios_by_name.cend())
+    {
+      continue;
+    }
+    for (const auto * gpio : it->second)
     {
-      if (gpio_name == gpio.name)
-      {
-        std::transform(
-          gpio.state_interfaces.begin(), gpio.state_interfaces.end(),
-          std::back_insert_iterator(state_interface_types_),
-          [&gpio_name](const auto & interface_name)
-          { return gpio_name + '/' + interface_name.name; });
-      }
+      std::transform(
+        gpio->state_interfaces.begin(), gpio->state_interfaces.end(),
+        std::back_insert_iterator(state_interface_types_),
+        [&gpio_name](const auto & interface_name)
+        { return gpio_name + '/' + interface_name.name; });
     }
   }
 }
@@ -257,28 +268,31 @@ void GpioCommandController::initialize_gpio_state_msg()
   gpio_state_msg.interface_groups.resize(params_.gpios.size());
   gpio_state_msg.interface_values.resize(params_.gpios.size());
 
+  auto gpios_state_interfaces_names = get_gpios_state_interfaces_names();
   for (std::size_t gpio_index = 0; gpio_index < params_.gpios.size(); ++gpio_index)
   {
     const auto gpio_name = params_.gpios[gpio_index];
     gpio_state_msg.interface_groups[gpio_index] = gpio_name;
     gpio_state_msg.interface_values[gpio_index].interface_names =
-      get_gpios_state_interfaces_names(gpio_name);
+      std::move(gpios_state_interfaces_names[gpio_name]);
     gpio_state_msg.interface_values[gpio_index].values = std::vector<double>(
       gpio_state_msg.interface_values[gpio_index].interface_names.size(),
       std::numeric_limits<double>::quiet_NaN());
   }
 }
 
-InterfacesNames GpioCommandController::get_gpios_state_interfaces_names(
-  const std::string & gpio_name) const
+std::unordered_map<std::string, InterfacesNames>
+GpioCommandController::get_gpios_state_interfaces_names() const
 {
-  InterfacesNames result;
+  // group the names of all state interfaces by gpio in a single pass
+  std::unordered_map<std::string, InterfacesNames> result;
   for (const auto & interface_name : state_interface_types_)
   {
     const auto it = state_interfaces_map_.find(interface_name);
-    if (it != state_interfaces_map_.cend() && it->second.get().get_prefix_name() == gpio_name)
+    if (it != state_interfaces_map_.cend())
     {
-      result.emplace_back(it->second.get().get_interface_name());
+      result[it->second.get().get_prefix_name()].emplace_back(
+        it->second.get().get_interface_name());
     }
   }
   return result;
@@ -289,19 +303,17 @@ std::unordered_map<std::string, std::reference_wrapper<T>>
 GpioCommandController::create_map_of_references_to_interfaces(
   const InterfacesNames & interfaces_from_params, std::vector<T> & configured_interfaces)
 {
+  // single pass over the configured interfaces instead of searching them for every name
+  const std::unordered_set<std::string> names(
+    interfaces_from_params.cbegin(), interfaces_from_params.cend());
   std::unordered_map<std::string, std::reference_wrapper<T>> map;
-  for (const auto & interface_name : interfaces_from_params)
+  map.reserve(names.size());
+  for (auto & configured_interface : configured_interfaces)
   {
-    auto interface = std::find_if(
-      configured_interfaces.begin(), configured_interfaces.end(),
-      [&](const auto & configured_interface)
-      {
-        const auto full_name_interface_name = configured_interface.get_name();
-        return full_name_interface_name == interface_name;
-      });
-    if (interface != configured_interfaces.end())
+    auto full_name_interface_name = configured_interface.get_name();
+    if (names.count(full_name_interface_name) > 0)
     {
-      map.emplace(interface_name, std::ref(*interface));
+      map.emplace(std::move(full_name_interface_name), std::ref(configured_interface));
     }
   }
   return map;
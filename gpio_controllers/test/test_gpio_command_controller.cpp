@@ -11,6 +11,7 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -85,6 +86,9 @@ class FriendGpioCommandController : public gpio_controllers::GpioCommandControll
   FRIEND_TEST(
     GpioCommandControllerTestSuite,
     WhenGivenCmdContainsWrongGpioInterfacesOrWrongGpioNameThenCommandInterfacesShouldNotBeUpdated);
+  FRIEND_TEST(
+    GpioCommandControllerTestSuite,
+    WhenGivenManyInterfacesInDifferentOrderThenCommandsAndStatesShouldBeMatchedByName);
 };
 
 class GpioCommandControllerTestSuite : public ::testing::Test
@@ -704,3 +708,87 @@ TEST_F(
   ASSERT_EQ(gpio_state_msg.interface_values.at(0).values.at(0), 1.0);
   ASSERT_EQ(gpio_state_msg.interface_values.at(1).values.at(0), 3.1);
 }
+
+TEST_F(
+  GpioCommandControllerTestSuite,
+  WhenGivenManyInterfacesInDifferentOrderThenCommandsAndStatesShouldBeMatchedByName)
+{
+  // 500 gpios with 5 command and 5 state interfaces each
+  constexpr size_t kNumGpios = 500;
+  const std::vector<std::string> interface_names = {"dig.1", "dig.2", "dig.3", "ana.1", "ana.2"};
+
+  std::vector<std::string> gpios;
+  std::vector<rclcpp::Parameter> parameters;
+  for (size_t i = 0; i < kNumGpios; ++i)
+  {
+    gpios.push_back("gpio_" + std::to_string(i));
+    parameters.emplace_back("command_interfaces." + gpios.back() + ".interfaces", interface_names);
+    parameters.emplace_back("state_interfaces." + gpios.back() + ".interfaces", interface_names);
+  }
+  parameters.emplace_back("gpios", gpios);
+  ASSERT_EQ(
+    controller_->init(
+      "test_gpio_command_controller", "", 0, "",
+      create_node_options_with_overriden_parameters(parameters)),
+    controller_interface::return_type::OK);
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), CallbackReturn::SUCCESS);
+
+  const size_t num_values = kNumGpios * interface_names.size();
+  std::vector<double> command_values(num_values, 0.0);
+  std::vector<double> state_values(num_values, 0.0);
+  std::vector<CommandInterface> command_handles;
+  std::vector<StateInterface> state_handles;
+  command_handles.reserve(num_values);
+  state_handles.reserve(num_values);
+  for (size_t i = 0; i < kNumGpios; ++i)
+  {
+    for (size_t j = 0; j < interface_names.size(); ++j)
+    {
+      const size_t index = i * interface_names.size() + j;
+      state_values[index] = static_cast<double>(index);
+      command_handles.emplace_back(gpios[i], interface_names[j], &command_values[index]);
+      state_handles.emplace_back(gpios[i], interface_names[j], &state_values[index]);
+    }
+  }
+  // the interfaces are loaned in the reverse order of the parameters
+  std::vector<LoanedCommandInterface> command_interfaces;
+  std::vector<LoanedStateInterface> state_interfaces;
+  for (auto it = command_handles.rbegin(); it != command_handles.rend(); ++it)
+  {
+    command_interfaces.emplace_back(*it);
+  }
+  for (auto it = state_handles.rbegin(); it != state_handles.rend(); ++it)
+  {
+    state_interfaces.emplace_back(*it);
+  }
+  controller_->assign_interfaces(std::move(command_interfaces), std::move(state_interfaces));
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), CallbackReturn::SUCCESS);
+
+  CmdType command;
+  command.interface_groups = gpios;
+  for (size_t i = 0; i < kNumGpios; ++i)
+  {
+    std::vector<double> values;
+    for (size_t j = 0; j < interface_names.size(); ++j)
+    {
+      values.push_back(-static_cast<double>(i * interface_names.size() + j));
+    }
+    command.interface_values.push_back(createInterfaceValue(interface_names, values));
+  }
+  controller_->rt_command_.set(command);
+  update_controller_loop();
+
+  const auto & gpio_state_msg = controller_->realtime_gpio_state_publisher_->msg_;
+  ASSERT_EQ(gpio_state_msg.interface_groups, gpios);
+  ASSERT_EQ(gpio_state_msg.interface_values.size(), kNumGpios);
+  for (size_t i = 0; i < kNumGpios; ++i)
+  {
+    ASSERT_EQ(gpio_state_msg.interface_values[i].interface_names, interface_names);
+    for (size_t j = 0; j < interface_names.size(); ++j)
+    {
+      const size_t index = i * interface_names.size() + j;
+      EXPECT_EQ(command_values[index], -static_cast<double>(index));
+      EXPECT_EQ(gpio_state_msg.interface_values[i].values[j], static_cast<double>(index));
+    }
+  }
+}
@@ -22,8 +22,12 @@
 
 #include "control_msgs/msg/dynamic_joint_state.hpp"
 #include "controller_interface/controller_interface.hpp"
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
+#include "ros2_controllers_utils/urdf_model_cache.hpp"
 #include "sensor_msgs/msg/joint_state.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
 
 #include "rclcpp/version.h"
 #if RCLCPP_VERSION_GTE(29, 0, 0)
@@ -54,12 +58,22 @@ namespace joint_state_broadcaster
  * \param interfaces Names of interfaces to publish.
  * \param map_interface_to_joint_state.{HW_IF_POSITION|HW_IF_VELOCITY|HW_IF_EFFORT} mapping
  * between custom interface names and standard names in sensor_msgs::msg::JointState message.
+ * \param joint_groups Names of groups of joints published on their own topic.
+ * \param groups.<group_name>.joints Names of the joints of a group.
+ * \param joint_states_publish_rate Publishing rate of joint_states, every cycle if zero.
+ * \param dynamic_joint_states_publish_rate Publishing rate of dynamic_joint_states, every cycle
+ * if zero.
  *
  * Publishes to:
  * - \b joint_states (sensor_msgs::msg::JointState): Joint states related to movement
  * (position, velocity, effort).
+ * - \b joint_states/<group_name> (sensor_msgs::msg::JointState): Joint states of the joints of
+ * a group.
  * - \b dynamic_joint_states (control_msgs::msg::DynamicJointState): Joint states regardless of
  * its interface type.
+ * - \b dynamic_joint_states/schema (control_msgs::msg::DynamicJointState) and
+ * \b dynamic_joint_states/values (std_msgs::msg::Float64MultiArray): Instead of
+ * dynamic_joint_states if compact_dynamic_joint_states is set.
  */
 class JointStateBroadcaster : public controller_interface::ControllerInterface
 {
@@ -86,9 +100,11 @@ public:
 
 protected:
   bool init_joint_data();
+  bool init_joint_state_group_msgs();
   void init_auxiliary_data();
   void init_joint_state_msg();
   void init_dynamic_joint_state_msg();
+  void init_dynamic_joint_state_values_msg();
   bool use_all_available_interfaces() const;
 
 protected:
@@ -105,35 +121,60 @@ protected:
   std::shared_ptr<rclcpp::Publisher<sensor_msgs::msg::JointState>> joint_state_publisher_;
   std::shared_ptr<realtime_tools::RealtimePublisher<sensor_msgs::msg::JointState>>
     realtime_joint_state_publisher_;
+  rclcpp::Duration joint_state_publish_period_ = rclcpp::Duration::from_nanoseconds(0);
+  rclcpp::Time joint_state_previous_publish_timestamp_{0, 0, RCL_CLOCK_UNINITIALIZED};
 
-  //  For the DynamicJointState format, we use a map to buffer values in for easier lookup
-  //  This allows to preserve whatever order or names/interfaces were initialized.
+  //  JointState messages of the joint groups, published at the rate of joint_states
+  struct JointStateGroup
+  {
+    std::string name;
+    std::shared_ptr<rclcpp::Publisher<sensor_msgs::msg::JointState>> publisher;
+    std::shared_ptr<realtime_tools::RealtimePublisher<sensor_msgs::msg::JointState>>
+      realtime_publisher;
+    /// message is locked for publishing in the current update cycle
+    bool publish = false;
+  };
+  std::vector<JointStateGroup> joint_state_groups_;
+
+  //  For the DynamicJointState format, we collect the names and initial values of all
+  //  interfaces per joint when activating. This defines the layout of the messages and is not
+  //  used in update().
   std::unordered_map<std::string, std::unordered_map<std::string, double>> name_if_value_mapping_;
   std::shared_ptr<rclcpp::Publisher<control_msgs::msg::DynamicJointState>>
     dynamic_joint_state_publisher_;
   std::shared_ptr<realtime_tools::RealtimePublisher<control_msgs::msg::DynamicJointState>>
     realtime_dynamic_joint_state_publisher_;
-
-  urdf::Model model_;
+  //  In the compact format, the layout is published once as schema, and the values message only
+  //  holds the schema version, the stamp, and the values in the order of the schema.
+  std::shared_ptr<rclcpp::Publisher<control_msgs::msg::DynamicJointState>>
+    dynamic_joint_state_schema_publisher_;
+  control_msgs::msg::DynamicJointState dynamic_joint_state_schema_;
+  std::shared_ptr<rclcpp::Publisher<std_msgs::msg::Float64MultiArray>>
+    dynamic_joint_state_values_publisher_;
+  std::shared_ptr<realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>>
+    realtime_dynamic_joint_state_values_publisher_;
+  rclcpp::Duration dynamic_joint_state_publish_period_ = rclcpp::Duration::from_nanoseconds(0);
+  rclcpp::Time dynamic_joint_state_previous_publish_timestamp_{0, 0, RCL_CLOCK_UNINITIALIZED};
+
+  std::shared_ptr<const urdf::Model> model_;
   bool is_model_loaded_ = false;
 
-  std::vector<double *> mapped_values_;
-
-  struct JointStateData
+  /// Destinations of one state interface in the preallocated messages.
+  struct StateInterfaceCopy
   {
-    JointStateData(const double & position, const double & velocity, const double & effort)
-    : position_(position), velocity_(velocity), effort_(effort)
-    {
-    }
-
-    const double & position_;
-    const double & velocity_;
-    const double & effort_;
+    /// element of position, velocity or effort in the joint state message, nullptr if none
+    double * joint_state_value = nullptr;
+    /// same element in the message of the joint group, nullptr if none
+    double * joint_state_group_value = nullptr;
+    size_t joint_state_group = 0;
+    /// element of the interface values in the dynamic joint state message
+    double * dynamic_joint_state_value = nullptr;
   };
 
-  std::vector<JointStateData> joint_states_data_;
-
-  std::vector<std::vector<const double *>> dynamic_joint_states_data_;
+  //  Flat copy table in the order of state_interfaces_, built on activation after the messages
+  //  are initialized. The messages are not resized afterwards, so update() copies every state
+  //  value straight into the message arrays without any lookup.
+  std::vector<StateInterfaceCopy> state_interface_copies_;
 };
 
 }  // namespace joint_state_broadcaster
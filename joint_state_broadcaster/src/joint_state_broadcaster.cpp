@@ -14,16 +14,23 @@
 
 #include "joint_state_broadcaster/joint_state_broadcaster.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "builtin_interfaces/msg/time.hpp"
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
 #include "rclcpp/qos.hpp"
 #include "rclcpp/time.hpp"
+#include "ros2_controllers_utils/publish_rate.hpp"
 #include "std_msgs/msg/header.hpp"
 
 namespace rclcpp_lifecycle
@@ -38,6 +45,30 @@ using hardware_interface::HW_IF_EFFORT;
 using hardware_interface::HW_IF_POSITION;
 using hardware_interface::HW_IF_VELOCITY;
 
+// Layout of the data of the compact dynamic joint state values message: the stamp of the schema
+// as its version, the stamp of the values, and the interface values in the order of the schema
+constexpr size_t kCompactSchemaStampSec = 0;
+constexpr size_t kCompactSchemaStampNanosec = 1;
+constexpr size_t kCompactStampSec = 2;
+constexpr size_t kCompactStampNanosec = 3;
+constexpr size_t kCompactValuesOffset = 4;
+
+double get_value(
+  const std::unordered_map<std::string, std::unordered_map<std::string, double>> & map,
+  const std::string & name, const std::string & interface_name)
+{
+  const auto & interfaces_and_values = map.at(name);
+  const auto interface_and_value = interfaces_and_values.find(interface_name);
+  if (interface_and_value != interfaces_and_values.cend())
+  {
+    return interface_and_value->second;
+  }
+  else
+  {
+    return kUninitializedValue;
+  }
+}
+
 JointStateBroadcaster::JointStateBroadcaster() {}
 
 controller_interface::CallbackReturn JointStateBroadcaster::on_init()
@@ -133,6 +164,21 @@ controller_interface::CallbackReturn JointStateBroadcaster::on_configure(
   get_map_interface_parameter(HW_IF_VELOCITY, params_.map_interface_to_joint_state.velocity);
   get_map_interface_parameter(HW_IF_EFFORT, params_.map_interface_to_joint_state.effort);
 
+  std::unordered_map<std::string, std::string> group_of_joint;
+  for (const auto & group_name : params_.joint_groups)
+  {
+    for (const auto & joint : params_.groups.joint_groups_map.at(group_name).joints)
+    {
+      if (!group_of_joint.emplace(joint, group_name).second)
+      {
+        RCLCPP_ERROR(
+          get_node()->get_logger(), "Joint '%s' is part of joint groups '%s' and '%s'.",
+          joint.c_str(), group_of_joint.at(joint).c_str(), group_name.c_str());
+        return CallbackReturn::ERROR;
+      }
+    }
+  }
+
   try
   {
     const std::string topic_name_prefix = params_.use_local_topics ? "~/" : "";
@@ -144,13 +190,46 @@ controller_interface::CallbackReturn JointStateBroadcaster::on_configure(
       std::make_shared<realtime_tools::RealtimePublisher<sensor_msgs::msg::JointState>>(
         joint_state_publisher_);
 
-    dynamic_joint_state_publisher_ =
-      get_node()->create_publisher<control_msgs::msg::DynamicJointState>(
-        topic_name_prefix + "dynamic_joint_states", rclcpp::SystemDefaultsQoS());
+    joint_state_groups_.clear();
+    joint_state_groups_.reserve(params_.joint_groups.size());
+    for (const auto & group_name : params_.joint_groups)
+    {
+      JointStateGroup group;
+      group.name = group_name;
+      group.publisher = get_node()->create_publisher<sensor_msgs::msg::JointState>(
+        topic_name_prefix + "joint_states/" + group_name, rclcpp::SystemDefaultsQoS());
+      group.realtime_publisher =
+        std::make_shared<realtime_tools::RealtimePublisher<sensor_msgs::msg::JointState>>(
+          group.publisher);
+      joint_state_groups_.push_back(group);
+    }
 
-    realtime_dynamic_joint_state_publisher_ =
-      std::make_shared<realtime_tools::RealtimePublisher<control_msgs::msg::DynamicJointState>>(
-        dynamic_joint_state_publisher_);
+    if (params_.compact_dynamic_joint_states)
+    {
+      // latched, such that subscribers always get the layout of the values
+      dynamic_joint_state_schema_publisher_ =
+        get_node()->create_publisher<control_msgs::msg::DynamicJointState>(
+          topic_name_prefix + "dynamic_joint_states/schema",
+          rclcpp::QoS(1).reliable().transient_local());
+
+      dynamic_joint_state_values_publisher_ =
+        get_node()->create_publisher<std_msgs::msg::Float64MultiArray>(
+          topic_name_prefix + "dynamic_joint_states/values", rclcpp::SystemDefaultsQoS());
+
+      realtime_dynamic_joint_state_values_publisher_ =
+        std::make_shared<realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>>(
+          dynamic_joint_state_values_publisher_);
+    }
+    else
+    {
+      dynamic_joint_state_publisher_ =
+        get_node()->create_publisher<control_msgs::msg::DynamicJointState>(
+          topic_name_prefix + "dynamic_joint_states", rclcpp::SystemDefaultsQoS());
+
+      realtime_dynamic_joint_state_publisher_ =
+        std::make_shared<realtime_tools::RealtimePublisher<control_msgs::msg::DynamicJointState>>(
+          dynamic_joint_state_publisher_);
+    }
   }
   catch (const std::exception & e)
   {
@@ -161,7 +240,8 @@ controller_interface::CallbackReturn JointStateBroadcaster::on_configure(
 
   const std::string & urdf = get_robot_description();
 
-  is_model_loaded_ = !urdf.empty() && model_.initString(urdf);
+  model_ = ros2_controllers_utils::get_urdf_model(urdf);
+  is_model_loaded_ = model_ != nullptr;
   if (!is_model_loaded_)
   {
     RCLCPP_ERROR(
@@ -171,8 +251,9 @@ controller_interface::CallbackReturn JointStateBroadcaster::on_configure(
   }
 
   // joint_names reserve space for all joints
+  const auto model_joints_size = is_model_loaded_ ? model_->joints_.size() : 0;
   const auto max_joints_size =
-    (params_.joints.empty() ? model_.joints_.size() : params_.joints.size()) +
+    (params_.joints.empty() ? model_joints_size : params_.joints.size()) +
     params_.extra_joints.size();
   joint_names_.reserve(max_joints_size);
   auto & joint_state_msg = realtime_joint_state_publisher_->msg_;
@@ -181,6 +262,15 @@ controller_interface::CallbackReturn JointStateBroadcaster::on_configure(
   joint_state_msg.velocity.reserve(max_joints_size);
   joint_state_msg.effort.reserve(max_joints_size);
 
+  auto get_publish_period = [](const double publish_rate)
+  {
+    return publish_rate > 0.0 ? rclcpp::Duration::from_seconds(1.0 / publish_rate)
+                              : rclcpp::Duration::from_nanoseconds(0);
+  };
+  joint_state_publish_period_ = get_publish_period(params_.joint_states_publish_rate);
+  dynamic_joint_state_publish_period_ =
+    get_publish_period(params_.dynamic_joint_states_publish_rate);
+
   frame_id_ = params_.frame_id;
   if (frame_id_.empty())
   {
@@ -201,9 +291,24 @@ controller_interface::CallbackReturn JointStateBroadcaster::on_activate(
     return CallbackReturn::ERROR;
   }
 
-  init_auxiliary_data();
   init_joint_state_msg();
+  if (!init_joint_state_group_msgs())
+  {
+    return CallbackReturn::ERROR;
+  }
   init_dynamic_joint_state_msg();
+  if (params_.compact_dynamic_joint_states)
+  {
+    init_dynamic_joint_state_values_msg();
+  }
+  init_auxiliary_data();
+
+  // publish in the first update cycle
+  const rclcpp::Time now = get_node()->now();
+  joint_state_previous_publish_timestamp_ =
+    ros2_controllers_utils::get_initial_publish_timestamp(now, joint_state_publish_period_);
+  dynamic_joint_state_previous_publish_timestamp_ =
+    ros2_controllers_utils::get_initial_publish_timestamp(now, dynamic_joint_state_publish_period_);
 
   return CallbackReturn::SUCCESS;
 }
@@ -213,6 +318,7 @@ controller_interface::CallbackReturn JointStateBroadcaster::on_deactivate(
 {
   joint_names_.clear();
   name_if_value_mapping_.clear();
+  state_interface_copies_.clear();
 
   return CallbackReturn::SUCCESS;
 }
@@ -229,6 +335,9 @@ bool JointStateBroadcaster::init_joint_data()
   // loop in reverse order, this maintains the order of values at retrieval time
   const std::vector<std::string> joint_state_interfaces = {
     HW_IF_POSITION, HW_IF_VELOCITY, HW_IF_EFFORT};
+  // hash index of joint_names_, to resolve the names of many interfaces in linear time
+  std::unordered_set<std::string> joint_names_set;
+  joint_names_set.reserve(state_interfaces_.size());
   for (auto si = state_interfaces_.crbegin(); si != state_interfaces_.crend(); si++)
   {
     const std::string prefix_name = si->get_prefix_name();
@@ -253,9 +362,9 @@ bool JointStateBroadcaster::init_joint_data()
     {
       if (
         !params_.use_urdf_to_filter || !params_.joints.empty() || !is_model_loaded_ ||
-        model_.getJoint(prefix_name))
+        model_->getJoint(prefix_name))
       {
-        if (std::find(joint_names_.begin(), joint_names_.end(), prefix_name) == joint_names_.end())
+        if (joint_names_set.insert(prefix_name).second)
         {
           joint_names_.push_back(prefix_name);
         }
@@ -266,11 +375,11 @@ bool JointStateBroadcaster::init_joint_data()
   if (is_model_loaded_ && params_.use_urdf_to_filter && params_.joints.empty())
   {
     std::vector<std::string> joint_names_filtered;
-    for (const auto & [joint_name, urdf_joint] : model_.joints_)
+    for (const auto & [joint_name, urdf_joint] : model_->joints_)
     {
       if (urdf_joint && urdf_joint->type != urdf::Joint::FIXED)
       {
-        if (std::find(joint_names_.begin(), joint_names_.end(), joint_name) != joint_names_.end())
+        if (joint_names_set.count(joint_name) > 0)
         {
           joint_names_filtered.push_back(joint_name);
         }
@@ -296,17 +405,101 @@ bool JointStateBroadcaster::init_joint_data()
 
 void JointStateBroadcaster::init_auxiliary_data()
 {
-  // save the mapping of state interfaces to joint states
-  mapped_values_.clear();
-  for (auto i = 0u; i < state_interfaces_.size(); ++i)
+  // save the destinations of every state interface in the messages
+  auto & joint_state_msg = realtime_joint_state_publisher_->msg_;
+  const bool compact = params_.compact_dynamic_joint_states;
+  auto & dynamic_joint_state_msg =
+    compact ? dynamic_joint_state_schema_ : realtime_dynamic_joint_state_publisher_->msg_;
+
+  std::unordered_map<std::string, size_t> joint_state_indices;
+  for (auto i = 0u; i < joint_names_.size(); ++i)
   {
-    std::string interface_name = state_interfaces_[i].get_interface_name();
+    joint_state_indices.emplace(joint_names_[i], i);
+  }
+  // group index and index in the group message
+  std::unordered_map<std::string, std::pair<size_t, size_t>> joint_state_group_indices;
+  for (auto g = 0u; g < joint_state_groups_.size(); ++g)
+  {
+    const auto & names = joint_state_groups_[g].realtime_publisher->msg_.name;
+    for (auto i = 0u; i < names.size(); ++i)
+    {
+      joint_state_group_indices.emplace(names[i], std::make_pair(g, i));
+    }
+  }
+  std::unordered_map<std::string, size_t> dynamic_joint_state_indices;
+  for (auto i = 0u; i < dynamic_joint_state_msg.joint_names.size(); ++i)
+  {
+    dynamic_joint_state_indices.emplace(dynamic_joint_state_msg.joint_names[i], i);
+  }
+
+  // element of an interface in a JointState message, nullptr if it is not published there
+  auto get_joint_state_value = [](
+                                 sensor_msgs::msg::JointState & msg, const size_t index,
+                                 const std::string & interface_name) -> double *
+  {
+    if (interface_name == HW_IF_POSITION)
+    {
+      return &msg.position[index];
+    }
+    else if (interface_name == HW_IF_VELOCITY)
+    {
+      return &msg.velocity[index];
+    }
+    else if (interface_name == HW_IF_EFFORT)
+    {
+      return &msg.effort[index];
+    }
+    return nullptr;
+  };
+
+  state_interface_copies_.clear();
+  state_interface_copies_.reserve(state_interfaces_.size());
+  for (const auto & state_interface : state_interfaces_)
+  {
+    const std::string prefix_name = state_interface.get_prefix_name();
+    std::string interface_name = state_interface.get_interface_name();
     if (map_interface_to_joint_state_.count(interface_name) > 0)
     {
       interface_name = map_interface_to_joint_state_[interface_name];
     }
-    mapped_values_.push_back(
-      &name_if_value_mapping_[state_interfaces_[i].get_prefix_name()][interface_name]);
+
+    StateInterfaceCopy copy;
+    const auto joint_state_index = joint_state_indices.find(prefix_name);
+    if (joint_state_index != joint_state_indices.end())
+    {
+      copy.joint_state_value =
+        get_joint_state_value(joint_state_msg, joint_state_index->second, interface_name);
+    }
+    const auto joint_state_group_index = joint_state_group_indices.find(prefix_name);
+    if (joint_state_group_index != joint_state_group_indices.end())
+    {
+      const auto [group, index] = joint_state_group_index->second;
+      auto & group_msg = joint_state_groups_[group].realtime_publisher->msg_;
+      copy.joint_state_group = group;
+      copy.joint_state_group_value = get_joint_state_value(group_msg, index, interface_name);
+    }
+
+    // every state interface is part of the dynamic joint state message, see init_joint_data()
+    auto & interface_values =
+      dynamic_joint_state_msg.interface_values[dynamic_joint_state_indices.at(prefix_name)];
+    const auto interface_index = static_cast<size_t>(std::distance(
+      interface_values.interface_names.cbegin(),
+      std::find(
+        interface_values.interface_names.cbegin(), interface_values.interface_names.cend(),
+        interface_name)));
+    if (compact)
+    {
+      // the schema holds the index of the value
+      auto & values = realtime_dynamic_joint_state_values_publisher_->msg_.data;
+      copy.dynamic_joint_state_value =
+        &values.at(static_cast<size_t>(interface_values.values.at(interface_index)));
+    }
+    else
+    {
+      copy.dynamic_joint_state_value = &interface_values.values.at(interface_index);
+    }
+
+    state_interface_copies_.push_back(copy);
   }
 }
 
@@ -321,38 +514,62 @@ void JointStateBroadcaster::init_joint_state_msg()
   auto & joint_state_msg = realtime_joint_state_publisher_->msg_;
   joint_state_msg.header.frame_id = frame_id_;
   joint_state_msg.name = joint_names_;
-  joint_state_msg.position.resize(num_joints, kUninitializedValue);
-  joint_state_msg.velocity.resize(num_joints, kUninitializedValue);
-  joint_state_msg.effort.resize(num_joints, kUninitializedValue);
-
-  // save joint state data
-  auto get_address =
-    [&](const std::string & joint_name, const std::string & interface_name) -> const double &
+  joint_state_msg.position.resize(num_joints);
+  joint_state_msg.velocity.resize(num_joints);
+  joint_state_msg.effort.resize(num_joints);
+  for (auto i = 0u; i < num_joints; ++i)
   {
-    const auto & interfaces_and_values = name_if_value_mapping_.at(joint_name);
-    const auto interface_and_value = interfaces_and_values.find(interface_name);
-    if (interface_and_value != interfaces_and_values.cend())
-    {
-      return interface_and_value->second;
-    }
-    else
-    {
-      return kUninitializedValue;
-    }
-  };
+    const auto & joint_name = joint_names_[i];
+    joint_state_msg.position[i] = get_value(name_if_value_mapping_, joint_name, HW_IF_POSITION);
+    joint_state_msg.velocity[i] = get_value(name_if_value_mapping_, joint_name, HW_IF_VELOCITY);
+    joint_state_msg.effort[i] = get_value(name_if_value_mapping_, joint_name, HW_IF_EFFORT);
+  }
+}
 
-  joint_states_data_.clear();
+bool JointStateBroadcaster::init_joint_state_group_msgs()
+{
+  const auto & joint_state_msg = realtime_joint_state_publisher_->msg_;
+  std::unordered_map<std::string, size_t> joint_state_indices;
   for (auto i = 0u; i < joint_names_.size(); ++i)
   {
-    joint_states_data_.push_back(JointStateData(
-      get_address(joint_names_[i], HW_IF_POSITION), get_address(joint_names_[i], HW_IF_VELOCITY),
-      get_address(joint_names_[i], HW_IF_EFFORT)));
+    joint_state_indices.emplace(joint_names_[i], i);
   }
+
+  for (auto & group : joint_state_groups_)
+  {
+    const auto & joints = params_.groups.joint_groups_map.at(group.name).joints;
+
+    auto & msg = group.realtime_publisher->msg_;
+    msg.header.frame_id = frame_id_;
+    msg.name = joints;
+    msg.position.resize(joints.size());
+    msg.velocity.resize(joints.size());
+    msg.effort.resize(joints.size());
+    for (auto i = 0u; i < joints.size(); ++i)
+    {
+      const auto joint_state_index = joint_state_indices.find(joints[i]);
+      if (joint_state_index == joint_state_indices.end())
+      {
+        RCLCPP_ERROR(
+          get_node()->get_logger(),
+          "Joint '%s' of joint group '%s' is not published in the joint states.",
+          joints[i].c_str(), group.name.c_str());
+        return false;
+      }
+      const auto index = joint_state_index->second;
+      msg.position[i] = joint_state_msg.position[index];
+      msg.velocity[i] = joint_state_msg.velocity[index];
+      msg.effort[i] = joint_state_msg.effort[index];
+    }
+  }
+  return true;
 }
 
 void JointStateBroadcaster::init_dynamic_joint_state_msg()
 {
-  auto & dynamic_joint_state_msg = realtime_dynamic_joint_state_publisher_->msg_;
+  auto & dynamic_joint_state_msg = params_.compact_dynamic_joint_states
+                                     ? dynamic_joint_state_schema_
+                                     : realtime_dynamic_joint_state_publisher_->msg_;
   dynamic_joint_state_msg.header.frame_id = frame_id_;
   dynamic_joint_state_msg.joint_names.clear();
   dynamic_joint_state_msg.interface_values.clear();
@@ -365,26 +582,47 @@ void JointStateBroadcaster::init_dynamic_joint_state_msg()
     for (const auto & interface_and_value : interfaces_and_values)
     {
       if_value.interface_names.emplace_back(interface_and_value.first);
-      if_value.values.emplace_back(kUninitializedValue);
+      if_value.values.emplace_back(interface_and_value.second);
     }
     dynamic_joint_state_msg.interface_values.emplace_back(if_value);
   }
+}
 
-  // save dynamic joint state data
-  dynamic_joint_states_data_.clear();
-  const auto & msg = realtime_dynamic_joint_state_publisher_->msg_;
-  for (auto ji = 0u; ji < msg.joint_names.size(); ++ji)
-  {
-    dynamic_joint_states_data_.push_back(std::vector<const double *>());
-
-    const auto & name = msg.joint_names[ji];
+void JointStateBroadcaster::init_dynamic_joint_state_values_msg()
+{
+  auto & schema = dynamic_joint_state_schema_;
 
-    for (auto ii = 0u; ii < msg.interface_values[ji].interface_names.size(); ++ii)
+  // the stamp of the schema is its version, it has to change with every new layout
+  rclcpp::Time schema_stamp = get_node()->now();
+  const rclcpp::Time previous_schema_stamp(schema.header.stamp, schema_stamp.get_clock_type());
+  if (schema_stamp <= previous_schema_stamp)
+  {
+    schema_stamp = previous_schema_stamp + rclcpp::Duration::from_nanoseconds(1);
+  }
+  schema.header.stamp = schema_stamp;
+
+  auto & values_msg = realtime_dynamic_joint_state_values_publisher_->msg_;
+  values_msg.layout.dim.resize(1);
+  values_msg.layout.dim[0].label = "interface_values";
+  values_msg.layout.data_offset = kCompactValuesOffset;
+  values_msg.data.assign(kCompactValuesOffset, 0.0);
+  values_msg.data[kCompactSchemaStampSec] = schema.header.stamp.sec;
+  values_msg.data[kCompactSchemaStampNanosec] = schema.header.stamp.nanosec;
+
+  // move the initial values to the values message, and replace them with their index
+  for (auto & interface_values : schema.interface_values)
+  {
+    for (auto & value : interface_values.values)
     {
-      const auto & interface_name = msg.interface_values[ji].interface_names[ii];
-      dynamic_joint_states_data_[ji].push_back(&name_if_value_mapping_[name][interface_name]);
+      values_msg.data.push_back(value);
+      value = static_cast<double>(values_msg.data.size() - 1);
     }
   }
+  const auto num_values = static_cast<uint32_t>(values_msg.data.size() - kCompactValuesOffset);
+  values_msg.layout.dim[0].size = num_values;
+  values_msg.layout.dim[0].stride = num_values;
+
+  dynamic_joint_state_schema_publisher_->publish(schema);
 }
 
 bool JointStateBroadcaster::use_all_available_interfaces() const
@@ -392,64 +630,86 @@ bool JointStateBroadcaster::use_all_available_interfaces() const
   return params_.joints.empty() || params_.interfaces.empty();
 }
 
-double get_value(
-  const std::unordered_map<std::string, std::unordered_map<std::string, double>> & map,
-  const std::string & name, const std::string & interface_name)
-{
-  const auto & interfaces_and_values = map.at(name);
-  const auto interface_and_value = interfaces_and_values.find(interface_name);
-  if (interface_and_value != interfaces_and_values.cend())
-  {
-    return interface_and_value->second;
-  }
-  else
-  {
-    return kUninitializedValue;
-  }
-}
-
 controller_interface::return_type JointStateBroadcaster::update(
   const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
 {
-  for (auto i = 0u; i < state_interfaces_.size(); ++i)
+  // messages are only filled in the cycles they are published
+  const bool joint_state_due =
+    realtime_joint_state_publisher_ &&
+    ros2_controllers_utils::is_publish_due(
+      joint_state_publish_period_, joint_state_previous_publish_timestamp_, time);
+  const bool publish_joint_state = joint_state_due && realtime_joint_state_publisher_->trylock();
+  bool publish_joint_state_group = false;
+  for (auto & group : joint_state_groups_)
   {
-    // no retries, just try to get the latest value once
-    const auto & opt = state_interfaces_[i].get_optional(0);
-    if (opt.has_value())
+    group.publish = joint_state_due && group.realtime_publisher->trylock();
+    publish_joint_state_group = publish_joint_state_group || group.publish;
+  }
+  const bool publish_dynamic_joint_state =
+    (realtime_dynamic_joint_state_publisher_ || realtime_dynamic_joint_state_values_publisher_) &&
+    ros2_controllers_utils::is_publish_due(
+      dynamic_joint_state_publish_period_, dynamic_joint_state_previous_publish_timestamp_,
+      time) &&
+    (realtime_dynamic_joint_state_publisher_
+       ? realtime_dynamic_joint_state_publisher_->trylock()
+       : realtime_dynamic_joint_state_values_publisher_->trylock());
+
+  if (publish_joint_state || publish_joint_state_group || publish_dynamic_joint_state)
+  {
+    // copy the state values straight into the message arrays, the messages are only written while
+    // their publisher is locked
+    for (auto i = 0u; i < state_interfaces_.size(); ++i)
     {
-      *mapped_values_[i] = opt.value();
+      // no retries, just try to get the latest value once
+      const auto & opt = state_interfaces_[i].get_optional(0);
+      if (!opt.has_value())
+      {
+        continue;
+      }
+      const auto & copy = state_interface_copies_[i];
+      if (publish_joint_state && copy.joint_state_value)
+      {
+        *copy.joint_state_value = opt.value();
+      }
+      if (copy.joint_state_group_value && joint_state_groups_[copy.joint_state_group].publish)
+      {
+        *copy.joint_state_group_value = opt.value();
+      }
+      if (publish_dynamic_joint_state)
+      {
+        *copy.dynamic_joint_state_value = opt.value();
+      }
     }
   }
 
-  if (realtime_joint_state_publisher_ && realtime_joint_state_publisher_->trylock())
+  if (publish_joint_state)
   {
-    auto & joint_state_msg = realtime_joint_state_publisher_->msg_;
-
-    joint_state_msg.header.stamp = time;
-
-    // update joint state message and dynamic joint state message
-    for (size_t i = 0; i < joint_names_.size(); ++i)
-    {
-      joint_state_msg.position[i] = joint_states_data_[i].position_;
-      joint_state_msg.velocity[i] = joint_states_data_[i].velocity_;
-      joint_state_msg.effort[i] = joint_states_data_[i].effort_;
-    }
+    realtime_joint_state_publisher_->msg_.header.stamp = time;
     realtime_joint_state_publisher_->unlockAndPublish();
   }
 
-  if (realtime_dynamic_joint_state_publisher_ && realtime_dynamic_joint_state_publisher_->trylock())
+  for (auto & group : joint_state_groups_)
   {
-    auto & msg = realtime_dynamic_joint_state_publisher_->msg_;
-    msg.header.stamp = time;
-    for (auto ji = 0u; ji < msg.joint_names.size(); ++ji)
+    if (group.publish)
     {
-      for (auto ii = 0u; ii < msg.interface_values[ji].interface_names.size(); ++ii)
-      {
-        msg.interface_values[ji].values[ii] = *dynamic_joint_states_data_[ji][ii];
-      }
+      group.realtime_publisher->msg_.header.stamp = time;
+      group.realtime_publisher->unlockAndPublish();
     }
+  }
+
+  if (publish_dynamic_joint_state && realtime_dynamic_joint_state_publisher_)
+  {
+    realtime_dynamic_joint_state_publisher_->msg_.header.stamp = time;
     realtime_dynamic_joint_state_publisher_->unlockAndPublish();
   }
+  else if (publish_dynamic_joint_state)
+  {
+    const builtin_interfaces::msg::Time stamp = time;
+    auto & values = realtime_dynamic_joint_state_values_publisher_->msg_.data;
+    values[kCompactStampSec] = stamp.sec;
+    values[kCompactStampNanosec] = stamp.nanosec;
+    realtime_dynamic_joint_state_values_publisher_->unlockAndPublish();
+  }
 
   return controller_interface::return_type::OK;
 }
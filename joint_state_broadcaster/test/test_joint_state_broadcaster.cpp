@@ -12,11 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
 #include <cstddef>
 
 #include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -965,6 +967,216 @@ TEST_F(JointStateBroadcasterTest, UpdateTest)
     controller_interface::return_type::OK);
 }
 
+TEST_F(JointStateBroadcasterTest, UpdateCopiesStateValuesIntoMessages)
+{
+  SetUpStateBroadcaster();
+  const std::vector<std::string> extra_joint_names = {"extra1"};
+  state_broadcaster_->get_node()->set_parameter({"extra_joints", extra_joint_names});
+
+  ASSERT_EQ(state_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(state_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  // change the values behind the state interfaces after activation
+  for (auto & value : joint_values_)
+  {
+    value += 10.0;
+  }
+  ASSERT_EQ(
+    state_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+
+  // extra joints keep their zero state
+  const std::vector<double> expected_values = {
+    joint_values_[0], joint_values_[1], joint_values_[2], 0.0};
+  const auto & joint_state_msg = state_broadcaster_->realtime_joint_state_publisher_->msg_;
+  EXPECT_THAT(joint_state_msg.position, ElementsAreArray(expected_values));
+  EXPECT_THAT(joint_state_msg.velocity, ElementsAreArray(expected_values));
+  EXPECT_THAT(joint_state_msg.effort, ElementsAreArray(expected_values));
+
+  const auto & dynamic_joint_state_msg =
+    state_broadcaster_->realtime_dynamic_joint_state_publisher_->msg_;
+  ASSERT_THAT(dynamic_joint_state_msg.joint_names, SizeIs(expected_values.size()));
+  for (size_t i = 0; i < dynamic_joint_state_msg.joint_names.size(); ++i)
+  {
+    const auto & name = dynamic_joint_state_msg.joint_names[i];
+    const auto joint = std::find(joint_names_.cbegin(), joint_names_.cend(), name);
+    const double expected_value =
+      joint == joint_names_.cend()
+        ? 0.0
+        : joint_values_[static_cast<size_t>(std::distance(joint_names_.cbegin(), joint))];
+    EXPECT_THAT(dynamic_joint_state_msg.interface_values[i].values, Each(expected_value))
+      << "joint " << name;
+  }
+}
+
+TEST_F(JointStateBroadcasterTest, PublishRateDecimation)
+{
+  SetUpStateBroadcaster();
+  state_broadcaster_->get_node()->set_parameter({"joint_states_publish_rate", 10.0});
+
+  ASSERT_EQ(state_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(state_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  const auto & joint_state_msg = state_broadcaster_->realtime_joint_state_publisher_->msg_;
+  const auto & dynamic_joint_state_msg =
+    state_broadcaster_->realtime_dynamic_joint_state_publisher_->msg_;
+  auto update = [&](const rclcpp::Time & time)
+  {
+    // give the publishing threads time to release the messages
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(
+      state_broadcaster_->update(time, rclcpp::Duration::from_seconds(0.01)),
+      controller_interface::return_type::OK);
+  };
+
+  const auto stamp = [](const builtin_interfaces::msg::Time & msg_stamp)
+  {
+    return rclcpp::Time(msg_stamp, RCL_ROS_TIME);
+  };
+
+  // both messages are published in the first cycle after activation
+  const rclcpp::Time start = state_broadcaster_->get_node()->now();
+  update(start);
+  EXPECT_EQ(start, stamp(joint_state_msg.header.stamp));
+  EXPECT_EQ(start, stamp(dynamic_joint_state_msg.header.stamp));
+  const double published_position = joint_state_msg.position[0];
+
+  // joint_states is skipped and its values are not copied, dynamic_joint_states is published
+  joint_values_[0] += 1.0;
+  const auto skipped = start + rclcpp::Duration::from_seconds(0.05);
+  update(skipped);
+  EXPECT_EQ(start, stamp(joint_state_msg.header.stamp));
+  EXPECT_EQ(published_position, joint_state_msg.position[0]);
+  EXPECT_EQ(skipped, stamp(dynamic_joint_state_msg.header.stamp));
+
+  // joint_states is published again after its publish period
+  const auto published = start + rclcpp::Duration::from_seconds(0.11);
+  update(published);
+  EXPECT_EQ(published, stamp(joint_state_msg.header.stamp));
+  EXPECT_EQ(joint_values_[0], joint_state_msg.position[0]);
+}
+
+TEST_F(JointStateBroadcasterTest, CompactDynamicJointStates)
+{
+  SetUpStateBroadcaster();
+  state_broadcaster_->get_node()->set_parameter({"compact_dynamic_joint_states", true});
+
+  ASSERT_EQ(state_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(state_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  // the compact messages replace dynamic_joint_states
+  ASSERT_FALSE(state_broadcaster_->realtime_dynamic_joint_state_publisher_);
+  ASSERT_TRUE(state_broadcaster_->dynamic_joint_state_schema_publisher_);
+  ASSERT_TRUE(state_broadcaster_->realtime_dynamic_joint_state_values_publisher_);
+
+  const rclcpp::Time time(1, 500);
+  ASSERT_EQ(
+    state_broadcaster_->update(time, rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+
+  const auto & schema = state_broadcaster_->dynamic_joint_state_schema_;
+  const auto & values_msg =
+    state_broadcaster_->realtime_dynamic_joint_state_values_publisher_->msg_;
+  const size_t NUM_VALUES = joint_names_.size() * interface_names_.size();
+  ASSERT_EQ(schema.header.frame_id, frame_id_);
+  ASSERT_THAT(schema.joint_names, SizeIs(joint_names_.size()));
+  ASSERT_THAT(values_msg.layout.dim, SizeIs(1));
+  ASSERT_EQ(NUM_VALUES, values_msg.layout.dim[0].size);
+  ASSERT_THAT(values_msg.data, SizeIs(values_msg.layout.data_offset + NUM_VALUES));
+
+  // version and stamp
+  EXPECT_EQ(schema.header.stamp.sec, values_msg.data[0]);
+  EXPECT_EQ(schema.header.stamp.nanosec, values_msg.data[1]);
+  EXPECT_EQ(1.0, values_msg.data[2]);
+  EXPECT_EQ(500.0, values_msg.data[3]);
+
+  // the schema holds the index of every value
+  for (size_t i = 0; i < schema.joint_names.size(); ++i)
+  {
+    const auto joint = std::find(joint_names_.cbegin(), joint_names_.cend(), schema.joint_names[i]);
+    ASSERT_NE(joint, joint_names_.cend());
+    const double expected_value =
+      joint_values_[static_cast<size_t>(std::distance(joint_names_.cbegin(), joint))];
+    ASSERT_THAT(schema.interface_values[i].interface_names, SizeIs(interface_names_.size()));
+    for (const auto index : schema.interface_values[i].values)
+    {
+      ASSERT_LT(static_cast<size_t>(index), values_msg.data.size());
+      EXPECT_EQ(expected_value, values_msg.data[static_cast<size_t>(index)]);
+    }
+  }
+
+  // a new layout on reactivation gets a new version
+  const rclcpp::Time first_version(schema.header.stamp);
+  ASSERT_EQ(state_broadcaster_->on_deactivate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(state_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  EXPECT_GT(rclcpp::Time(schema.header.stamp), first_version);
+}
+
+TEST_F(JointStateBroadcasterTest, JointGroupsPublishedOnOwnTopics)
+{
+  auto node_options = state_broadcaster_->define_custom_node_options();
+  node_options.parameter_overrides(
+    {rclcpp::Parameter("joint_groups", std::vector<std::string>{"arm", "head"}),
+     rclcpp::Parameter("groups.arm.joints", std::vector<std::string>{"joint3", "joint1"}),
+     rclcpp::Parameter("groups.head.joints", std::vector<std::string>{"joint2"}),
+     rclcpp::Parameter("frame_id", frame_id_)});
+  ASSERT_EQ(
+    state_broadcaster_->init("joint_state_broadcaster", "", 0, "", node_options),
+    controller_interface::return_type::OK);
+  assign_state_interfaces();
+
+  ASSERT_EQ(state_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_THAT(state_broadcaster_->joint_state_groups_, SizeIs(2));
+  ASSERT_EQ(
+    state_broadcaster_->joint_state_groups_[0].publisher->get_topic_name(),
+    std::string("/joint_states/arm"));
+  ASSERT_EQ(
+    state_broadcaster_->joint_state_groups_[1].publisher->get_topic_name(),
+    std::string("/joint_states/head"));
+  ASSERT_EQ(state_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  for (auto & value : joint_values_)
+  {
+    value += 10.0;
+  }
+  const rclcpp::Time time(1, 0);
+  ASSERT_EQ(
+    state_broadcaster_->update(time, rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+
+  // the joints of a group are in the order of the group
+  const auto & arm_msg = state_broadcaster_->joint_state_groups_[0].realtime_publisher->msg_;
+  EXPECT_EQ(arm_msg.header.frame_id, frame_id_);
+  EXPECT_EQ(time, rclcpp::Time(arm_msg.header.stamp));
+  EXPECT_THAT(arm_msg.name, ElementsAreArray({joint_names_[2], joint_names_[0]}));
+  EXPECT_THAT(arm_msg.position, ElementsAreArray({joint_values_[2], joint_values_[0]}));
+  EXPECT_THAT(arm_msg.velocity, ElementsAreArray({joint_values_[2], joint_values_[0]}));
+  EXPECT_THAT(arm_msg.effort, ElementsAreArray({joint_values_[2], joint_values_[0]}));
+
+  const auto & head_msg = state_broadcaster_->joint_state_groups_[1].realtime_publisher->msg_;
+  EXPECT_THAT(head_msg.name, ElementsAreArray({joint_names_[1]}));
+  EXPECT_THAT(head_msg.position, ElementsAreArray({joint_values_[1]}));
+
+  // joint_states still contains all joints
+  const auto & joint_state_msg = state_broadcaster_->realtime_joint_state_publisher_->msg_;
+  EXPECT_THAT(joint_state_msg.position, ElementsAreArray(joint_values_));
+}
+
+TEST_F(JointStateBroadcasterTest, JointGroupsWithUnknownJoint)
+{
+  auto node_options = state_broadcaster_->define_custom_node_options();
+  node_options.parameter_overrides(
+    {rclcpp::Parameter("joint_groups", std::vector<std::string>{"arm"}),
+     rclcpp::Parameter("groups.arm.joints", std::vector<std::string>{"joint1", "joint4"})});
+  ASSERT_EQ(
+    state_broadcaster_->init("joint_state_broadcaster", "", 0, "", node_options),
+    controller_interface::return_type::OK);
+  assign_state_interfaces();
+
+  ASSERT_EQ(state_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(state_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_ERROR);
+}
+
 TEST_F(JointStateBroadcasterTest, UpdatePerformanceTest)
 {
   const auto result = state_broadcaster_->init(
@@ -1078,6 +1290,71 @@ TEST_F(JointStateBroadcasterTest, UpdatePerformanceTest)
   RCLCPP_INFO(state_broadcaster_->get_node()->get_logger(), "Variance: %lf us", variance);
 }
 
+TEST_F(JointStateBroadcasterTest, ActivateTestWithManyInterfaces)
+{
+  const auto result = state_broadcaster_->init(
+    "joint_state_broadcaster", "", 0, "", state_broadcaster_->define_custom_node_options());
+  ASSERT_EQ(result, controller_interface::return_type::OK);
+
+  // 1000 joints with 5 state interfaces each, the interfaces of a joint are not adjacent
+  constexpr auto kNumJoints = 1000u;
+  const std::vector<std::string> interface_names = {
+    HW_IF_POSITION, HW_IF_VELOCITY, HW_IF_EFFORT, "temperature", "current"};
+  std::vector<std::string> joint_names;
+  for (auto joint = 0u; joint < kNumJoints; ++joint)
+  {
+    joint_names.push_back("joint_" + std::to_string(joint));
+  }
+  std::vector<double> values(kNumJoints * interface_names.size());
+  test_interfaces_.reserve(values.size());
+  for (size_t interface = 0; interface < interface_names.size(); ++interface)
+  {
+    for (size_t joint = 0; joint < kNumJoints; ++joint)
+    {
+      const size_t index = joint * interface_names.size() + interface;
+      values[index] = static_cast<double>(index);
+      test_interfaces_.emplace_back(
+        hardware_interface::StateInterface{
+          joint_names[joint], interface_names[interface], &values[index]});
+    }
+  }
+
+  std::vector<LoanedStateInterface> state_interfaces;
+  for (const auto & tif : test_interfaces_)
+  {
+    state_interfaces.emplace_back(tif);
+  }
+  state_broadcaster_->assign_interfaces({}, std::move(state_interfaces));
+
+  auto node_state = state_broadcaster_->configure();
+  ASSERT_EQ(node_state.id(), lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+  node_state = state_broadcaster_->get_node()->activate();
+  ASSERT_EQ(node_state.id(), lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE);
+  ASSERT_THAT(state_broadcaster_->joint_names_, ElementsAreArray(joint_names));
+
+  ASSERT_EQ(
+    state_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+
+  const auto & joint_state_msg = state_broadcaster_->realtime_joint_state_publisher_->msg_;
+  ASSERT_THAT(joint_state_msg.name, ElementsAreArray(joint_names));
+  const auto & dynamic_joint_state_msg =
+    state_broadcaster_->realtime_dynamic_joint_state_publisher_->msg_;
+  ASSERT_THAT(dynamic_joint_state_msg.joint_names, ElementsAreArray(joint_names));
+  for (size_t joint = 0; joint < kNumJoints; ++joint)
+  {
+    const std::vector<double> expected_values(
+      values.cbegin() + static_cast<std::ptrdiff_t>(joint * interface_names.size()),
+      values.cbegin() + static_cast<std::ptrdiff_t>((joint + 1) * interface_names.size()));
+    EXPECT_EQ(joint_state_msg.position[joint], expected_values[0]);
+    EXPECT_EQ(joint_state_msg.velocity[joint], expected_values[1]);
+    EXPECT_EQ(joint_state_msg.effort[joint], expected_values[2]);
+    const auto & interface_values = dynamic_joint_state_msg.interface_values[joint];
+    EXPECT_THAT(interface_values.interface_names, ElementsAreArray(interface_names));
+    EXPECT_THAT(interface_values.values, ElementsAreArray(expected_values));
+  }
+}
+
 void JointStateBroadcasterTest::activate_and_get_joint_state_message(
   const std::string & topic, sensor_msgs::msg::JointState & joint_state_msg)
 {
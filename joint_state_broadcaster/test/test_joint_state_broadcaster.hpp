@@ -49,6 +49,12 @@ class FriendJointStateBroadcaster : public joint_state_broadcaster::JointStateBr
   FRIEND_TEST(JointStateBroadcasterTest, TestCustomInterfaceMapping);
   FRIEND_TEST(JointStateBroadcasterTest, TestCustomInterfaceMappingUpdate);
   FRIEND_TEST(JointStateBroadcasterTest, ExtraJointStatePublishTest);
+  FRIEND_TEST(JointStateBroadcasterTest, UpdateCopiesStateValuesIntoMessages);
+  FRIEND_TEST(JointStateBroadcasterTest, PublishRateDecimation);
+  FRIEND_TEST(JointStateBroadcasterTest, CompactDynamicJointStates);
+  FRIEND_TEST(JointStateBroadcasterTest, JointGroupsPublishedOnOwnTopics);
+  FRIEND_TEST(JointStateBroadcasterTest, JointGroupsWithUnknownJoint);
+  FRIEND_TEST(JointStateBroadcasterTest, ActivateTestWithManyInterfaces);
 };
 
 class JointStateBroadcasterTest : public ::testing::Test
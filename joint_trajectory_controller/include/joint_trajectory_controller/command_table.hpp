@@ -0,0 +1,147 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER__COMMAND_TABLE_HPP_
+#define JOINT_TRAJECTORY_CONTROLLER__COMMAND_TABLE_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "joint_trajectory_controller/interpolation_methods.hpp"
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+
+namespace joint_trajectory_controller
+{
+/**
+ * Table of trajectory samples at a fixed period, filled by a low-priority worker thread.
+ *
+ * On Linux, the worker runs with the SCHED_IDLE policy, so it never delays the realtime thread.
+ *
+ * The realtime thread hands over the trajectory with request() when it starts executing it. The
+ * worker then samples the trajectory at `start_time + k * period` for increasing cycles `k`, so
+ * that the realtime thread only has to interpolate between the samples around the time of its
+ * current cycle with sample(). This also works if the update period jitters or the trajectory is
+ * executed with a speed scaling factor.
+ */
+class CommandTable
+{
+public:
+  /**
+   * \param[in] capacity Maximum number of cycles which are precomputed for a trajectory.
+   * \param[in] number_of_joints Number of joints of the trajectories, to preallocate the request.
+   */
+  CommandTable(size_t capacity, size_t number_of_joints);
+
+  ~CommandTable();
+
+  CommandTable(const CommandTable &) = delete;
+  CommandTable & operator=(const CommandTable &) = delete;
+
+  /// Start precomputing a new trajectory, samples of the previous one are not returned anymore.
+  /**
+   * The arguments correspond to the calls of Trajectory::set_point_before_trajectory_msg() and the
+   * first Trajectory::sample() of the realtime thread. The worker samples \p trajectory itself,
+   * which modifies it, so it must be a copy which is not sampled by the realtime thread.
+   *
+   * Never blocks and does not allocate memory: if the worker is just taking over the previous
+   * request, false is returned and no samples are available for this trajectory.
+   */
+  bool request(
+    const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> & trajectory,
+    const rclcpp::Time & time_before,
+    const trajectory_msgs::msg::JointTrajectoryPoint & point_before,
+    const std::vector<bool> & joints_angle_wraparound, const rclcpp::Time & start_time,
+    const rclcpp::Duration & period,
+    const interpolation_methods::InterpolationMethod interpolation_method);
+
+  /// Interpolate the precomputed samples at \p sample_time.
+  /**
+   * The samples of the cycles before and after \p sample_time are interpolated linearly. After the
+   * end of the trajectory, the last sample is returned. Does not allocate memory if the fields of
+   * \p point have the size of the samples already.
+   *
+   * \param[out] point sample at \p sample_time, like the output of Trajectory::sample().
+   * \param[out] start_index index of the segment start point in the trajectory message.
+   * \param[out] end_index index of the segment end point, equals the number of points after the
+   *   end of the trajectory.
+   * \return false if the samples around \p sample_time are not computed yet, are not valid, or
+   *   belong to different segments. The caller has to sample the trajectory itself then.
+   */
+  bool sample(
+    const rclcpp::Time & sample_time, trajectory_msgs::msg::JointTrajectoryPoint & point,
+    size_t & start_index, size_t & end_index) const;
+
+  /// True if the samples of the last request are computed up to the end of its trajectory.
+  bool is_complete() const
+  {
+    return ready_generation_.load(std::memory_order_acquire) == rt_generation_ &&
+           complete_.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const { return entries_.size(); }
+
+private:
+  /// Sample of the trajectory at one cycle, equivalent to the output of Trajectory::sample().
+  struct Entry
+  {
+    trajectory_msgs::msg::JointTrajectoryPoint point;
+    size_t start_index = 0;
+    size_t end_index = 0;
+    /// return value of Trajectory::sample()
+    bool valid = false;
+  };
+
+  void worker();
+
+  std::vector<Entry> entries_;
+  const size_t number_of_joints_;
+
+  // only accessed by the thread calling request() and sample()
+  rclcpp::Time rt_start_time_;
+  int64_t rt_period_ns_ = 0;
+  uint64_t rt_generation_ = 0;
+
+  // request handed over to the worker, guarded by mutex_
+  std::mutex mutex_;
+  std::condition_variable request_cv_;
+  bool request_pending_ = false;
+  std::atomic<bool> stop_{false};
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> request_msg_;
+  rclcpp::Time request_time_before_;
+  trajectory_msgs::msg::JointTrajectoryPoint request_point_before_;
+  std::vector<bool> request_joints_angle_wraparound_;
+  rclcpp::Time request_start_time_;
+  rclcpp::Duration request_period_{0, 0};
+  interpolation_methods::InterpolationMethod request_interpolation_method_{
+    interpolation_methods::DEFAULT_INTERPOLATION};
+
+  std::atomic<uint64_t> requested_generation_{0};
+  std::atomic<uint64_t> ready_generation_{0};
+  std::atomic<size_t> filled_{0};
+  std::atomic<bool> complete_{false};
+
+  std::thread worker_thread_;
+};
+
+}  // namespace joint_trajectory_controller
+
+#endif  // JOINT_TRAJECTORY_CONTROLLER__COMMAND_TABLE_HPP_
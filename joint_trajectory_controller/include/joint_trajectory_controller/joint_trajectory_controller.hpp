@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "control_msgs/action/follow_joint_trajectory.hpp"
+#include "control_msgs/msg/dynamic_joint_state.hpp"
 #include "control_msgs/msg/joint_trajectory_controller_state.hpp"
 #include "control_msgs/msg/speed_scaling_factor.hpp"
 #include "control_msgs/srv/query_trajectory_state.hpp"
@@ -29,8 +30,10 @@
 #include "controller_interface/controller_interface.hpp"
 #include "hardware_interface/loaned_command_interface.hpp"
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "joint_trajectory_controller/command_table.hpp"
 #include "joint_trajectory_controller/interpolation_methods.hpp"
 #include "joint_trajectory_controller/tolerances.hpp"
+#include "joint_trajectory_controller/tracking_statistics.hpp"
 #include "joint_trajectory_controller/trajectory.hpp"
 #include "rclcpp/duration.hpp"
 #include "rclcpp/subscription.hpp"
@@ -41,6 +44,7 @@
 #include "realtime_tools/realtime_buffer.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "realtime_tools/realtime_server_goal_handle.hpp"
+#include "ros2_controllers_utils/urdf_model_cache.hpp"
 #include "trajectory_msgs/msg/joint_trajectory.hpp"
 #include "trajectory_msgs/msg/joint_trajectory_point.hpp"
 
@@ -114,11 +118,8 @@ protected:
   Params params_;
   rclcpp::Duration update_period_{0, 0};
 
-  rclcpp::Time traj_time_;
-
   // variables for storing internal data for open-loop control
   trajectory_msgs::msg::JointTrajectoryPoint last_commanded_state_;
-  rclcpp::Time last_commanded_time_;
   /// Specify interpolation method. Default to splines.
   interpolation_methods::InterpolationMethod interpolation_method_{
     interpolation_methods::DEFAULT_INTERPOLATION};
@@ -153,29 +154,24 @@ protected:
   // Configuration for every joint if it wraps around (ie. is continuous, position error is
   // normalized)
   std::vector<bool> joints_angle_wraparound_;
+  // parsed robot description, shared with the other controllers of the process
+  std::shared_ptr<const urdf::Model> model_;
   // reserved storage for result of the command when closed loop pid adapter is used
   std::vector<double> tmp_command_;
 
-  // Things around speed scaling
-  std::atomic<double> scaling_factor_{1.0};
-  std::atomic<double> scaling_factor_cmd_{1.0};
-
   // Timeout to consider commands old
   double cmd_timeout_;
-  // True if holding position or repeating last trajectory point in case of success
-  std::atomic<bool> rt_is_holding_{false};
+
+  // Things around speed scaling, written by non-RT threads. Together with subscriber_is_active_
+  // they get their own cache line, so that these writes don't evict the members used in update().
+  alignas(64) std::atomic<double> scaling_factor_{1.0};
+  std::atomic<double> scaling_factor_cmd_{1.0};
   // TODO(karsten1987): eventually activate and deactivate subscriber directly when its supported
   std::atomic<bool> subscriber_is_active_{false};
-  rclcpp::Subscription<trajectory_msgs::msg::JointTrajectory>::SharedPtr joint_command_subscriber_ =
-    nullptr;
-
-  rclcpp::Service<control_msgs::srv::QueryTrajectoryState>::SharedPtr query_state_srv_;
 
-  std::shared_ptr<Trajectory> current_trajectory_ = nullptr;
-  realtime_tools::RealtimeBuffer<std::shared_ptr<trajectory_msgs::msg::JointTrajectory>>
-    new_trajectory_msg_;
-
-  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> hold_position_msg_ptr_ = nullptr;
+  // starts the next cache line, after the members written by non-RT threads
+  alignas(64) rclcpp::Service<control_msgs::srv::QueryTrajectoryState>::SharedPtr
+    query_state_srv_;
 
   using ControllerStateMsg = control_msgs::msg::JointTrajectoryControllerState;
   using StatePublisher = realtime_tools::RealtimePublisher<ControllerStateMsg>;
@@ -183,29 +179,143 @@ protected:
   rclcpp::Publisher<ControllerStateMsg>::SharedPtr publisher_;
   StatePublisherPtr state_publisher_;
 
+  using TrackingStatisticsMsg = control_msgs::msg::DynamicJointState;
+  using TrackingStatisticsPublisher = realtime_tools::RealtimePublisher<TrackingStatisticsMsg>;
+
   using FollowJTrajAction = control_msgs::action::FollowJointTrajectory;
   using RealtimeGoalHandle = realtime_tools::RealtimeServerGoalHandle<FollowJTrajAction>;
   using RealtimeGoalHandlePtr = std::shared_ptr<RealtimeGoalHandle>;
   using RealtimeGoalHandleBuffer = realtime_tools::RealtimeBuffer<RealtimeGoalHandlePtr>;
 
-  rclcpp_action::Server<FollowJTrajAction>::SharedPtr action_server_;
-  RealtimeGoalHandleBuffer rt_active_goal_;       ///< Currently active action goal, if any.
-  std::atomic<bool> rt_has_pending_goal_{false};  ///< Is there a pending action goal?
-  rclcpp::TimerBase::SharedPtr goal_handle_timer_;
   rclcpp::Duration action_monitor_period_ = rclcpp::Duration(50ms);
 
+  using JointTrajectoryPoint = trajectory_msgs::msg::JointTrajectoryPoint;
+
+  /// What a joint group is executing, switched by the realtime thread.
+  enum class ExecutionState
+  {
+    /// a trajectory received by topic or action
+    EXECUTING,
+    /// the position at which the trajectory was stopped, e.g. after aborting or canceling
+    HOLDING,
+    /// the last point of the trajectory after it succeeded
+    HOLDING_LAST_POINT
+  };
+
+  /**
+   * Subset of the controller joints that executes its own trajectory.
+   *
+   * Every group has its own trajectory, action goal, tolerances and ROS interfaces, so that a
+   * trajectory sent to one group does not interrupt the motion of the other groups. If the
+   * ``joint_groups`` parameter is empty, a single group containing all joints is used, with its
+   * interfaces in the namespace of the controller.
+   */
+  struct JointGroup
+  {
+    std::string name;
+    // joint names of the group, in the order of the 'joints' parameter
+    std::vector<std::string> joint_names;
+    // index of every group joint in the 'joints' parameter
+    std::vector<size_t> joint_indices;
+    // true if the group contains all joints of the controller in the same order
+    bool is_identity = false;
+    std::vector<bool> joints_angle_wraparound;
+
+    std::shared_ptr<Trajectory> current_trajectory = nullptr;
+    realtime_tools::RealtimeBuffer<std::shared_ptr<trajectory_msgs::msg::JointTrajectory>>
+      new_trajectory_msg;
+    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> hold_position_msg_ptr = nullptr;
+    rclcpp::Time traj_time;
+    rclcpp::Time last_commanded_time;
+
+    // the following members are only accessed by the realtime thread
+    ExecutionState execution_state = ExecutionState::HOLDING;
+    // last message taken from new_trajectory_msg, executed unless holding
+    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> last_external_msg;
+    // preallocated single-point trajectory executed when holding
+    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> rt_hold_msg;
+    // True if holding position or repeating last trajectory point in case of success
+    bool is_holding() const { return execution_state != ExecutionState::EXECUTING; }
+    // the tolerances used for the current goal
+    realtime_tools::RealtimeBuffer<SegmentTolerances> active_tolerances;
+
+    rclcpp::Subscription<trajectory_msgs::msg::JointTrajectory>::SharedPtr
+      joint_command_subscriber = nullptr;
+    rclcpp_action::Server<FollowJTrajAction>::SharedPtr action_server;
+    RealtimeGoalHandleBuffer rt_active_goal;  ///< Currently active action goal, if any.
+    /// Is there a pending action goal? Written by the action callbacks, on its own cache line.
+    alignas(64) std::atomic<bool> rt_has_pending_goal{false};
+    rclcpp::TimerBase::SharedPtr goal_handle_timer;
+
+    // Preallocated states in the joint order of the group, unused if is_identity is true
+    JointTrajectoryPoint state_current;
+    JointTrajectoryPoint state_desired;
+    JointTrajectoryPoint command_next;
+    JointTrajectoryPoint state_error;
+    JointTrajectoryPoint last_commanded_state;
+
+    // set in every update(), true if the commands of the group are written to the hardware
+    bool write_commands = false;
+
+    // joints of the group with the same actuator latency, their commands are sampled ahead
+    struct CommandLookahead
+    {
+      rclcpp::Duration duration{0, 0};
+      // indices in the joint order of the group
+      std::vector<size_t> joint_indices;
+    };
+    std::vector<CommandLookahead> command_lookaheads;
+    JointTrajectoryPoint lookahead_point;
+
+    // precomputed samples of the current trajectory, nullptr if not enabled
+    std::unique_ptr<CommandTable> command_table;
+    // true if the samples of command_table belong to the current trajectory
+    bool use_command_table = false;
+    // number of update cycles which used the samples of command_table
+    size_t command_table_cycles = 0;
+    // copy of a full goal sent to new_trajectory_msg, made by the non-RT thread sending it
+    struct TableMsg
+    {
+      std::shared_ptr<trajectory_msgs::msg::JointTrajectory> source;
+      // sorted to the joint order of the group, sampled by the worker of command_table
+      std::shared_ptr<trajectory_msgs::msg::JointTrajectory> copy;
+    };
+    realtime_tools::RealtimeBuffer<TableMsg> new_table_msg;
+    // copy of last_external_msg for command_table, nullptr if there is none
+    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> table_msg;
+
+    // tracking error of the current action goal, in the joint order of the group
+    TrackingStatistics tracking_statistics;
+    // publishes tracking_statistics once per goal, nullptr if not enabled
+    rclcpp::Publisher<TrackingStatisticsMsg>::SharedPtr tracking_statistics_publisher;
+    std::unique_ptr<TrackingStatisticsPublisher> tracking_statistics_rt_publisher;
+  };
+  std::vector<std::unique_ptr<JointGroup>> joint_groups_;
+  // index of the group in joint_groups_ for every command joint
+  std::vector<size_t> map_cmd_to_group_;
+
   // callback for topic interface
-  void topic_callback(const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> msg);
+  void topic_callback(
+    const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> msg, JointGroup & group);
 
-  // callbacks for action_server_
+  // callbacks for action_server
   rclcpp_action::GoalResponse goal_received_callback(
-    const rclcpp_action::GoalUUID & uuid, std::shared_ptr<const FollowJTrajAction::Goal> goal);
+    const rclcpp_action::GoalUUID & uuid, std::shared_ptr<const FollowJTrajAction::Goal> goal,
+    JointGroup & group);
   rclcpp_action::CancelResponse goal_cancelled_callback(
-    const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle);
+    const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle,
+    JointGroup & group);
   void goal_accepted_callback(
-    std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle);
+    std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle,
+    JointGroup & group);
 
-  using JointTrajectoryPoint = trajectory_msgs::msg::JointTrajectoryPoint;
+  /**
+   * Samples the trajectory of \p group, checks its tolerances and handles its action goal.
+   *
+   * The sampled states are written to state_desired_ and command_next_ at the indices of the
+   * group joints, and \p group.write_commands is set if they should be sent to the hardware.
+   */
+  void update_group(JointGroup & group, const rclcpp::Time & time, const rclcpp::Duration & period);
 
   /**
    * Computes the error for a specific joint in the trajectory.
@@ -218,36 +328,45 @@ protected:
   void compute_error_for_joint(
     JointTrajectoryPoint & error, const size_t index, const JointTrajectoryPoint & current,
     const JointTrajectoryPoint & desired) const;
-  // fill trajectory_msg so it matches joints controlled by this controller
+  // fill trajectory_msg so it matches joints of the group
   // positions set to current position, velocities, accelerations and efforts to 0.0
   void fill_partial_goal(
-    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg) const;
-  // sorts the joints of the incoming message to our local order
+    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg,
+    const JointGroup & group) const;
+  // sorts the joints of the incoming message to the order of joint_names
   void sort_to_local_joint_order(
-    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg) const;
+    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg,
+    const std::vector<std::string> & joint_names) const;
+  // validates the trajectory against all joints of the controller
   bool validate_trajectory_msg(const trajectory_msgs::msg::JointTrajectory & trajectory) const;
+  // validates the trajectory against the given subset of joints of the controller
+  bool validate_trajectory_msg(
+    const trajectory_msgs::msg::JointTrajectory & trajectory,
+    const std::vector<std::string> & joint_names) const;
   void add_new_trajectory_msg(
-    const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> & traj_msg);
+    const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> & traj_msg, JointGroup & group);
   bool validate_trajectory_point_field(
     size_t joint_names_size, const std::vector<double> & vector_field,
     const std::string & string_for_vector_field, size_t i, bool allow_empty) const;
 
   // the tolerances from the node parameter
   SegmentTolerances default_tolerances_;
-  // the tolerances used for the current goal
-  realtime_tools::RealtimeBuffer<SegmentTolerances> active_tolerances_;
 
-  void preempt_active_goal();
+  void preempt_active_goal(JointGroup & group);
 
-  /** @brief set the current position with zero velocity and acceleration as new command
+  /** @brief set the current position of the group with zero velocity and acceleration as new
+   * command
    */
-  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> set_hold_position();
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> set_hold_position(JointGroup & group);
 
-  /** @brief set last trajectory point to be repeated at success
+  /** @brief switch the group to holding from the realtime thread, effective in this cycle
    *
-   * no matter if it has nonzero velocity or acceleration
+   * Executes the preallocated JointGroup::rt_hold_msg, without writing to
+   * JointGroup::new_trajectory_msg. With ExecutionState::HOLDING, the current position is held
+   * with zero velocity and acceleration. With ExecutionState::HOLDING_LAST_POINT, the last point
+   * of the trajectory is repeated, no matter if it has nonzero velocity or acceleration.
    */
-  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> set_success_trajectory_point();
+  void start_holding(JointGroup & group, ExecutionState state, const rclcpp::Time & time);
 
   bool reset();
 
@@ -278,7 +397,31 @@ private:
   bool contains_interface_type(
     const std::vector<std::string> & interface_type_list, const std::string & interface_type);
 
-  void init_hold_position_msg();
+  /**
+   * @brief Create the joint groups from the ``joint_groups`` parameter, including their ROS
+   * interfaces.
+   *
+   * @return false if the groups don't split the controller joints into disjoint subsets.
+   */
+  bool configure_joint_groups();
+  /**
+   * @brief Group the joints of every joint group by their ``command_lookahead``.
+   *
+   * Has to be called after update_period_ is known.
+   */
+  void configure_command_lookahead();
+  void init_hold_position_msg(JointGroup & group);
+  // publish the tracking statistics of the goal of \p group which just terminated
+  void publish_tracking_statistics(JointGroup & group, const rclcpp::Time & time);
+
+  // copy the entries of the group joints from point to group_point
+  void gather_group_point(
+    const JointGroup & group, const JointTrajectoryPoint & point,
+    JointTrajectoryPoint & group_point) const;
+  // copy the entries of group_point to the group joints in point
+  void scatter_group_point(
+    const JointGroup & group, const JointTrajectoryPoint & group_point,
+    JointTrajectoryPoint & point) const;
   void resize_joint_trajectory_point(
     trajectory_msgs::msg::JointTrajectoryPoint & point, size_t size, double value = 0.0);
   void resize_joint_trajectory_point_command(
@@ -319,7 +462,12 @@ private:
   {
     for (size_t index = 0; index < num_cmd_joints_; ++index)
     {
-      joint_interface[index].get().set_value(trajectory_point_interface[map_cmd_to_joints_[index]]);
+      // skip joints whose group didn't meet its tolerances in this cycle
+      if (joint_groups_[map_cmd_to_group_[index]]->write_commands)
+      {
+        joint_interface[index].get().set_value(
+          trajectory_point_interface[map_cmd_to_joints_[index]]);
+      }
     }
   }
 };
@@ -0,0 +1,129 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER__TRACKING_STATISTICS_HPP_
+#define JOINT_TRAJECTORY_CONTROLLER__TRACKING_STATISTICS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace joint_trajectory_controller
+{
+/**
+ * \brief Per-joint statistics of the tracking error over the execution of one trajectory.
+ *
+ * Memory is only allocated by resize(), all other methods can be called from the realtime loop.
+ */
+class TrackingStatistics
+{
+public:
+  struct Joint
+  {
+    double position_error_squared_sum = 0.0;
+    double position_error_max = 0.0;
+    double velocity_error_squared_sum = 0.0;
+    double velocity_error_max = 0.0;
+    /// accumulated time the state tolerance was violated while moving
+    double time_outside_path_tolerance = 0.0;
+    /// time after the last point of the trajectory, from which on the goal tolerance was satisfied
+    double settle_time = std::numeric_limits<double>::quiet_NaN();
+    bool settled = false;
+  };
+
+  explicit TrackingStatistics(size_t size = 0) : joints_(size) {}
+
+  void resize(size_t size) { joints_.resize(size); }
+
+  size_t size() const { return joints_.size(); }
+
+  /// Start the statistics of a new trajectory.
+  void reset()
+  {
+    std::fill(joints_.begin(), joints_.end(), Joint());
+    num_samples_ = 0;
+  }
+
+  /**
+   * \brief Add the tracking error of one joint in the current control cycle.
+   *
+   * \param[in] period Duration of the control cycle.
+   */
+  void add_error(
+    const size_t index, const double position_error, const double velocity_error,
+    const bool outside_path_tolerance, const double period)
+  {
+    auto & joint = joints_[index];
+    joint.position_error_squared_sum += position_error * position_error;
+    joint.position_error_max = std::max(joint.position_error_max, std::abs(position_error));
+    joint.velocity_error_squared_sum += velocity_error * velocity_error;
+    joint.velocity_error_max = std::max(joint.velocity_error_max, std::abs(velocity_error));
+    if (outside_path_tolerance)
+    {
+      joint.time_outside_path_tolerance += period;
+    }
+  }
+
+  /**
+   * \brief Track the settling of one joint after the last point of the trajectory.
+   *
+   * \param[in] time_after_end Time since the last point of the trajectory should have been reached.
+   */
+  void add_goal_check(
+    const size_t index, const bool within_goal_tolerance, const double time_after_end)
+  {
+    auto & joint = joints_[index];
+    if (!within_goal_tolerance)
+    {
+      joint.settled = false;
+      joint.settle_time = std::numeric_limits<double>::quiet_NaN();
+    }
+    else if (!joint.settled)
+    {
+      joint.settled = true;
+      joint.settle_time = std::max(0.0, time_after_end);
+    }
+  }
+
+  /// Count one control cycle, call once after the add_error() calls of all joints.
+  void finish_cycle() { ++num_samples_; }
+
+  size_t num_samples() const { return num_samples_; }
+
+  const Joint & joint(const size_t index) const { return joints_[index]; }
+
+  double position_error_rms(const size_t index) const
+  {
+    return rms(joints_[index].position_error_squared_sum);
+  }
+
+  double velocity_error_rms(const size_t index) const
+  {
+    return rms(joints_[index].velocity_error_squared_sum);
+  }
+
+private:
+  double rms(const double squared_sum) const
+  {
+    return num_samples_ > 0 ? std::sqrt(squared_sum / static_cast<double>(num_samples_)) : 0.0;
+  }
+
+  std::vector<Joint> joints_;
+  size_t num_samples_ = 0;
+};
+
+}  // namespace joint_trajectory_controller
+
+#endif  // JOINT_TRAJECTORY_CONTROLLER__TRACKING_STATISTICS_HPP_
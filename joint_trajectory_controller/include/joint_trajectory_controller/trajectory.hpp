@@ -15,7 +15,10 @@
 #ifndef JOINT_TRAJECTORY_CONTROLLER__TRAJECTORY_HPP_
 #define JOINT_TRAJECTORY_CONTROLLER__TRAJECTORY_HPP_
 
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "joint_trajectory_controller/interpolation_methods.hpp"
@@ -120,11 +123,15 @@ public:
    * \param[in] state_b State at time \p time_b.
    * \param[in] sample_time The time to sample, between time_a and time_b.
    * \param[out] output The state at \p sample_time.
+   * \param[in] joint_indices If set, only these joints are interpolated. All other joints have to
+   *     stand still at the same position in \p state_a and \p state_b, up to
+   *     IDLE_JOINT_TOLERANCE. The position of \p state_a is copied to \p output.
    */
   void interpolate_between_points(
     const rclcpp::Time & time_a, const trajectory_msgs::msg::JointTrajectoryPoint & state_a,
     const rclcpp::Time & time_b, const trajectory_msgs::msg::JointTrajectoryPoint & state_b,
-    const rclcpp::Time & sample_time, trajectory_msgs::msg::JointTrajectoryPoint & output);
+    const rclcpp::Time & sample_time, trajectory_msgs::msg::JointTrajectoryPoint & output,
+    const std::vector<size_t> * joint_indices = nullptr);
 
   TrajectoryPointConstIter begin() const;
 
@@ -150,12 +157,33 @@ public:
    */
   size_t last_sample_index() const { return last_sample_idx_; }
 
+  /// Largest change of position, and largest velocity, acceleration and change of effort, of a
+  /// joint that is considered to stand still in a segment.
+  static constexpr double IDLE_JOINT_TOLERANCE = 1e-9;
+
+  /// True if some joints stand still in the segment last sampled by \p sample().
+  /**
+   * Idle joints are detected for each segment between two points of the trajectory message, when
+   * \p sample() enters it. They are not interpolated, which saves most of the sampling time for
+   * trajectories where only few joints of a large system move at a time. The segment from the
+   * point before the trajectory starts at the measured state and is always fully interpolated.
+   */
+  bool has_idle_joints() const { return has_idle_joints_; }
+
+  /// Get the indices of the joints which move in the segment last sampled, see has_idle_joints().
+  const std::vector<size_t> & active_joints() const { return active_joints_; }
+
 private:
   void deduce_from_derivatives(
     trajectory_msgs::msg::JointTrajectoryPoint & first_state,
     trajectory_msgs::msg::JointTrajectoryPoint & second_state, const size_t dim,
     const double delta_t);
 
+  /// Find the joints that move in the segment \p segment_index between \p point_a and \p point_b.
+  void update_active_joints(
+    const size_t segment_index, const trajectory_msgs::msg::JointTrajectoryPoint & point_a,
+    const trajectory_msgs::msg::JointTrajectoryPoint & point_b);
+
   std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg_;
   rclcpp::Time trajectory_start_time_;
 
@@ -164,6 +192,11 @@ private:
 
   bool sampled_already_ = false;
   size_t last_sample_idx_ = 0;
+
+  bool has_idle_joints_ = false;
+  std::vector<size_t> active_joints_;
+  /// index of the segment active_joints_ belongs to
+  size_t active_joints_segment_ = std::numeric_limits<size_t>::max();
 };
 
 /**
@@ -180,19 +213,27 @@ inline std::vector<size_t> mapping(const T & t1, const T & t2)
     return std::vector<size_t>();
   }
 
+  // index t2 once instead of searching it for every element of t1
+  std::unordered_map<typename T::value_type, size_t> t2_indices;
+  t2_indices.reserve(t2.size());
+  size_t t2_dist = 0;
+  for (const auto & element : t2)
+  {
+    t2_indices.emplace(element, t2_dist++);
+  }
+
   std::vector<size_t> mapping_vector(t1.size());  // Return value
   for (auto t1_it = t1.begin(); t1_it != t1.end(); ++t1_it)
   {
-    auto t2_it = std::find(t2.begin(), t2.end(), *t1_it);
-    if (t2.end() == t2_it)
+    const auto t2_index = t2_indices.find(*t1_it);
+    if (t2_indices.end() == t2_index)
     {
       return std::vector<size_t>();
     }
     else
     {
       const size_t t1_dist = static_cast<size_t>(std::distance(t1.begin(), t1_it));
-      const size_t t2_dist = static_cast<size_t>(std::distance(t2.begin(), t2_it));
-      mapping_vector[t1_dist] = t2_dist;
+      mapping_vector[t1_dist] = t2_index->second;
     }
   }
   return mapping_vector;
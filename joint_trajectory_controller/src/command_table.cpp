@@ -0,0 +1,261 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "joint_trajectory_controller/command_table.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "joint_trajectory_controller/trajectory.hpp"
+
+namespace
+{
+void reserve_point(trajectory_msgs::msg::JointTrajectoryPoint & point, size_t number_of_joints)
+{
+  point.positions.reserve(number_of_joints);
+  point.velocities.reserve(number_of_joints);
+  point.accelerations.reserve(number_of_joints);
+  point.effort.reserve(number_of_joints);
+}
+
+// values are taken from a if b does not have the same size
+void interpolate(
+  const std::vector<double> & a, const std::vector<double> & b, double fraction,
+  std::vector<double> & output)
+{
+  if (a.size() != b.size())
+  {
+    output = a;
+    return;
+  }
+  output.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    output[i] = a[i] + fraction * (b[i] - a[i]);
+  }
+}
+}  // namespace
+
+namespace joint_trajectory_controller
+{
+CommandTable::CommandTable(size_t capacity, size_t number_of_joints)
+: entries_(capacity), number_of_joints_(number_of_joints)
+{
+  // the request arguments are copied into preallocated memory
+  reserve_point(request_point_before_, number_of_joints_);
+  request_joints_angle_wraparound_.reserve(number_of_joints_);
+  worker_thread_ = std::thread(&CommandTable::worker, this);
+}
+
+CommandTable::~CommandTable()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  request_cv_.notify_one();
+  if (worker_thread_.joinable())
+  {
+    worker_thread_.join();
+  }
+}
+
+bool CommandTable::request(
+  const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> & trajectory,
+  const rclcpp::Time & time_before, const trajectory_msgs::msg::JointTrajectoryPoint & point_before,
+  const std::vector<bool> & joints_angle_wraparound, const rclcpp::Time & start_time,
+  const rclcpp::Duration & period,
+  const interpolation_methods::InterpolationMethod interpolation_method)
+{
+  // samples of the previous request must not be used from now on
+  ++rt_generation_;
+  rt_start_time_ = start_time;
+  rt_period_ns_ = period.nanoseconds();
+  if (entries_.empty() || rt_period_ns_ <= 0 || !trajectory)
+  {
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    return false;
+  }
+  // only the pointer is handed over, the other arguments are copied into preallocated memory
+  request_msg_ = trajectory;
+  request_time_before_ = time_before;
+  request_point_before_ = point_before;
+  request_joints_angle_wraparound_ = joints_angle_wraparound;
+  request_start_time_ = start_time;
+  request_period_ = period;
+  request_interpolation_method_ = interpolation_method;
+  request_pending_ = true;
+  requested_generation_.store(rt_generation_);
+  lock.unlock();
+
+  request_cv_.notify_one();
+  return true;
+}
+
+bool CommandTable::sample(
+  const rclcpp::Time & sample_time, trajectory_msgs::msg::JointTrajectoryPoint & point,
+  size_t & start_index, size_t & end_index) const
+{
+  if (ready_generation_.load(std::memory_order_acquire) != rt_generation_)
+  {
+    return false;
+  }
+  const int64_t offset_ns = (sample_time - rt_start_time_).nanoseconds();
+  if (offset_ns < 0)
+  {
+    return false;
+  }
+  size_t cycle = static_cast<size_t>(offset_ns / rt_period_ns_);
+  const double fraction =
+    static_cast<double>(offset_ns % rt_period_ns_) / static_cast<double>(rt_period_ns_);
+  size_t next_cycle = fraction > 0.0 ? cycle + 1 : cycle;
+
+  // read complete_ first, filled_ is final then
+  const bool complete = complete_.load(std::memory_order_acquire);
+  const size_t filled = filled_.load(std::memory_order_acquire);
+  if (next_cycle >= filled)
+  {
+    if (!complete || filled == 0)
+    {
+      return false;
+    }
+    // the trajectory has ended, all later samples equal the last one
+    next_cycle = filled - 1;
+    cycle = std::min(cycle, next_cycle);
+  }
+
+  const Entry & before = entries_[cycle];
+  const Entry & after = entries_[next_cycle];
+  // the segment at sample_time is unknown if the samples belong to different segments
+  if (
+    !before.valid || !after.valid || before.start_index != after.start_index ||
+    before.end_index != after.end_index)
+  {
+    return false;
+  }
+  interpolate(before.point.positions, after.point.positions, fraction, point.positions);
+  interpolate(before.point.velocities, after.point.velocities, fraction, point.velocities);
+  interpolate(before.point.accelerations, after.point.accelerations, fraction, point.accelerations);
+  interpolate(before.point.effort, after.point.effort, fraction, point.effort);
+  point.time_from_start = before.point.time_from_start;
+  start_index = before.start_index;
+  end_index = before.end_index;
+  return true;
+}
+
+void CommandTable::worker()
+{
+#ifdef __linux__
+  // The thread inherits the realtime policy of the thread constructing the table, if any. Run it
+  // only if the CPU is idle otherwise, the update loop samples the trajectory itself meanwhile.
+  // Best effort: lowering the priority needs no privileges, and the table also works without it.
+  sched_param param{};
+  param.sched_priority = 0;
+  pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> msg;
+  // swapped with the request, so that both keep their preallocated memory
+  trajectory_msgs::msg::JointTrajectoryPoint point_before;
+  reserve_point(point_before, number_of_joints_);
+  std::vector<bool> joints_angle_wraparound;
+  joints_angle_wraparound.reserve(number_of_joints_);
+
+  while (true)
+  {
+    rclcpp::Time time_before;
+    rclcpp::Time start_time;
+    rclcpp::Duration period(0, 0);
+    interpolation_methods::InterpolationMethod interpolation_method =
+      interpolation_methods::DEFAULT_INTERPOLATION;
+    uint64_t generation = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      request_cv_.wait(lock, [this] { return request_pending_ || stop_.load(); });
+      if (stop_.load())
+      {
+        return;
+      }
+      // the previous trajectory is released in this thread
+      msg = std::move(request_msg_);
+      request_msg_.reset();
+      std::swap(point_before, request_point_before_);
+      std::swap(joints_angle_wraparound, request_joints_angle_wraparound_);
+      time_before = request_time_before_;
+      start_time = request_start_time_;
+      period = request_period_;
+      interpolation_method = request_interpolation_method_;
+      generation = requested_generation_.load();
+      request_pending_ = false;
+    }
+
+    filled_.store(0, std::memory_order_relaxed);
+    complete_.store(false, std::memory_order_relaxed);
+    ready_generation_.store(generation, std::memory_order_release);
+    if (!msg || msg->points.empty())
+    {
+      continue;
+    }
+
+    // sample the copy exactly as the realtime thread samples its trajectory
+    Trajectory trajectory(msg);
+    trajectory.set_point_before_trajectory_msg(time_before, point_before, joints_angle_wraparound);
+    TrajectoryPointConstIter start_segment_itr, end_segment_itr;
+    for (size_t cycle = 0; cycle < entries_.size(); ++cycle)
+    {
+      // abort if a new trajectory arrived in the meantime
+      if (requested_generation_.load(std::memory_order_relaxed) != generation || stop_.load())
+      {
+        break;
+      }
+      auto & entry = entries_[cycle];
+      const rclcpp::Time sample_time =
+        start_time +
+        rclcpp::Duration::from_nanoseconds(period.nanoseconds() * static_cast<int64_t>(cycle));
+      entry.valid = trajectory.sample(
+        sample_time, interpolation_method, entry.point, start_segment_itr, end_segment_itr);
+      if (!entry.valid)
+      {
+        // the segment is not set if sampling before the point before the trajectory
+        entry.start_index = entry.end_index = 0;
+        filled_.store(cycle + 1, std::memory_order_release);
+        continue;
+      }
+      entry.start_index = static_cast<size_t>(std::distance(trajectory.begin(), start_segment_itr));
+      entry.end_index = static_cast<size_t>(std::distance(trajectory.begin(), end_segment_itr));
+      filled_.store(cycle + 1, std::memory_order_release);
+
+      if (end_segment_itr == trajectory.end())
+      {
+        complete_.store(true, std::memory_order_release);
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace joint_trajectory_controller
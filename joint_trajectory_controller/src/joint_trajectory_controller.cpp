@@ -20,10 +20,10 @@
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "angles/angles.h"
-#include "controller_interface/helpers.hpp"
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
 #include "joint_trajectory_controller/trajectory.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
@@ -33,16 +33,49 @@
 #include "rclcpp_action/create_server.hpp"
 #include "rclcpp_action/server_goal_handle.hpp"
 #include "rclcpp_lifecycle/state.hpp"
-
-#include "rclcpp/version.h"
-#if RCLCPP_VERSION_GTE(29, 0, 0)
-#include "urdf/model.hpp"
-#else
-#include "urdf/model.h"
-#endif
+#include "ros2_controllers_utils/urdf_model_cache.hpp"
 
 namespace joint_trajectory_controller
 {
+namespace
+{
+/// Index of the interfaces by their full name.
+template <typename T>
+std::unordered_map<std::string, size_t> index_interfaces_by_name(const std::vector<T> & interfaces)
+{
+  std::unordered_map<std::string, size_t> index;
+  index.reserve(interfaces.size());
+  for (size_t i = 0; i < interfaces.size(); ++i)
+  {
+    index.emplace(interfaces[i].get_name(), i);
+  }
+  return index;
+}
+
+/**
+ * Same as controller_interface::get_ordered_interfaces(), but looks up the interfaces in
+ * \p index instead of searching all interfaces for every joint, which is quadratic in the number
+ * of interfaces.
+ */
+template <typename T>
+bool get_ordered_interfaces(
+  std::vector<T> & unordered_interfaces, const std::unordered_map<std::string, size_t> & index,
+  const std::vector<std::string> & ordered_names, const std::string & interface_type,
+  std::vector<std::reference_wrapper<T>> & ordered_interfaces)
+{
+  ordered_interfaces.reserve(ordered_names.size());
+  for (const auto & name : ordered_names)
+  {
+    const auto it = index.find(name + "/" + interface_type);
+    if (it != index.end())
+    {
+      ordered_interfaces.push_back(std::ref(unordered_interfaces[it->second]));
+    }
+  }
+  return ordered_names.size() == ordered_interfaces.size();
+}
+}  // namespace
+
 JointTrajectoryController::JointTrajectoryController()
 : controller_interface::ControllerInterface(), dof_(0), num_cmd_joints_(0)
 {
@@ -65,8 +98,9 @@ controller_interface::CallbackReturn JointTrajectoryController::on_init()
   const std::string & urdf = get_robot_description();
   if (!urdf.empty())
   {
-    urdf::Model model;
-    if (!model.initString(urdf))
+    // keep the model, such that further controllers of the process share it instead of parsing
+    model_ = ros2_controllers_utils::get_urdf_model(urdf);
+    if (!model_)
     {
       RCLCPP_ERROR(get_node()->get_logger(), "Failed to parse robot description!");
       return CallbackReturn::ERROR;
@@ -78,7 +112,7 @@ controller_interface::CallbackReturn JointTrajectoryController::on_init()
       joints_angle_wraparound_.resize(params_.joints.size(), false);
       for (size_t i = 0; i < params_.joints.size(); ++i)
       {
-        auto urdf_joint = model.getJoint(params_.joints[i]);
+        auto urdf_joint = model_->getJoint(params_.joints[i]);
         if (urdf_joint && urdf_joint->type == urdf::Joint::CONTINUOUS)
         {
           RCLCPP_DEBUG(
@@ -171,286 +205,458 @@ controller_interface::return_type JointTrajectoryController::update(
     }
   }
 
+  // current state update
+  state_current_.time_from_start.sec = 0;
+  state_current_.time_from_start.nanosec = 0;
+  read_state_from_state_interfaces(state_current_);
+
+  // sample the trajectories of all groups in one pass over the shared state
+  bool write_commands = false;
+  for (auto & group : joint_groups_)
+  {
+    update_group(*group, time, period);
+    write_commands = write_commands || group->write_commands;
+  }
+
+  // set values for next hardware write() if tolerance is met
+  if (write_commands)
+  {
+    if (use_closed_loop_pid_adapter_)
+    {
+      // Update PIDs
+      for (auto i = 0ul; i < num_cmd_joints_; ++i)
+      {
+        if (!joint_groups_[map_cmd_to_group_[i]]->write_commands)
+        {
+          continue;
+        }
+        // If effort interface only, add desired effort as feed forward
+        // If velocity interface, ignore desired effort
+        size_t index_cmd_joint = map_cmd_to_joints_[i];
+        tmp_command_[index_cmd_joint] =
+          (command_next_.velocities[index_cmd_joint] * ff_velocity_scale_[i]) +
+          (has_effort_command_interface_ ? command_next_.effort[index_cmd_joint] : 0.0) +
+          pids_[i]->compute_command(
+            state_error_.positions[index_cmd_joint], state_error_.velocities[index_cmd_joint],
+            period);
+      }
+    }
+
+    // set values for next hardware write()
+    if (has_position_command_interface_)
+    {
+      assign_interface_from_point(joint_command_interface_[0], command_next_.positions);
+    }
+    if (has_velocity_command_interface_)
+    {
+      if (use_closed_loop_pid_adapter_)
+      {
+        assign_interface_from_point(joint_command_interface_[1], tmp_command_);
+      }
+      else
+      {
+        assign_interface_from_point(joint_command_interface_[1], command_next_.velocities);
+      }
+    }
+    if (has_acceleration_command_interface_)
+    {
+      assign_interface_from_point(joint_command_interface_[2], command_next_.accelerations);
+    }
+    if (has_effort_command_interface_)
+    {
+      if (use_closed_loop_pid_adapter_)
+      {
+        assign_interface_from_point(joint_command_interface_[3], tmp_command_);
+      }
+      else
+      {
+        // If position and effort command interfaces, only pass desired effort
+        assign_interface_from_point(joint_command_interface_[3], state_desired_.effort);
+      }
+    }
+
+    // store the previous command used in open-loop control mode
+    for (const auto & group : joint_groups_)
+    {
+      if (!group->write_commands)
+      {
+        continue;
+      }
+      if (group->is_identity)
+      {
+        last_commanded_state_ = command_next_;
+      }
+      else
+      {
+        scatter_group_point(*group, group->command_next, last_commanded_state_);
+      }
+    }
+  }
+
+  publish_state(time, state_desired_, state_current_, state_error_);
+  return controller_interface::return_type::OK;
+}
+
+void JointTrajectoryController::update_group(
+  JointGroup & group, const rclcpp::Time & time, const rclcpp::Duration & period)
+{
+  auto logger = this->get_node()->get_logger();
+  group.write_commands = false;
+
   // don't update goal after we sampled the trajectory to avoid any racecondition
-  const auto active_goal = *rt_active_goal_.readFromRT();
+  const auto active_goal = *group.rt_active_goal.readFromRT();
 
   // Check if a new trajectory message has been received from Non-RT threads
-  const auto current_trajectory_msg = current_trajectory_->get_trajectory_msg();
-  auto new_external_msg = new_trajectory_msg_.readFromRT();
-  // Discard, if a goal is pending but still not active (somewhere stuck in goal_handle_timer_)
+  auto new_external_msg = group.new_trajectory_msg.readFromRT();
+  // Discard, if a goal is pending but still not active (somewhere stuck in goal_handle_timer)
   if (
-    current_trajectory_msg != *new_external_msg && (rt_has_pending_goal_ && !active_goal) == false)
-  {
-    fill_partial_goal(*new_external_msg);
-    sort_to_local_joint_order(*new_external_msg);
+    *new_external_msg && group.last_external_msg != *new_external_msg &&
+    (group.rt_has_pending_goal && !active_goal) == false)
+  {
+    group.last_external_msg = *new_external_msg;
+    // the copy for the command table is only sent together with this message
+    const auto new_table_msg = group.new_table_msg.readFromRT();
+    group.table_msg = new_table_msg->source == *new_external_msg ? new_table_msg->copy : nullptr;
+    fill_partial_goal(*new_external_msg, group);
+    sort_to_local_joint_order(*new_external_msg, group.joint_names);
+    // the non-RT threads send hold_position_msg_ptr on activation and when canceling a goal
+    group.execution_state = *new_external_msg == group.hold_position_msg_ptr
+                              ? ExecutionState::HOLDING
+                              : ExecutionState::EXECUTING;
     // TODO(denis): Add here integration of position and velocity
-    current_trajectory_->update(*new_external_msg);
+    group.current_trajectory->update(*new_external_msg);
   }
 
-  // current state update
-  state_current_.time_from_start.sec = 0;
-  state_current_.time_from_start.nanosec = 0;
-  read_state_from_state_interfaces(state_current_);
-
   // currently carrying out a trajectory
-  if (has_active_trajectory())
+  if (!group.current_trajectory->has_trajectory_msg())
   {
-    bool first_sample = false;
-    TrajectoryPointConstIter start_segment_itr, end_segment_itr;
-    // if sampling the first time, set the point before you sample
-    if (!current_trajectory_->is_sampled_already())
+    return;
+  }
+
+  // the trajectory of the group is sampled in the joint order of the group
+  JointTrajectoryPoint & state_current = group.is_identity ? state_current_ : group.state_current;
+  JointTrajectoryPoint & state_desired = group.is_identity ? state_desired_ : group.state_desired;
+  JointTrajectoryPoint & command_next = group.is_identity ? command_next_ : group.command_next;
+  if (!group.is_identity)
+  {
+    gather_group_point(group, state_current_, group.state_current);
+  }
+
+  bool first_sample = false;
+  TrajectoryPointConstIter start_segment_itr, end_segment_itr;
+  // if sampling the first time, set the point before you sample
+  if (!group.current_trajectory->is_sampled_already())
+  {
+    first_sample = true;
+    if (params_.interpolate_from_desired_state)
     {
-      first_sample = true;
-      if (params_.interpolate_from_desired_state)
+      if (std::abs(group.last_commanded_time.seconds()) < std::numeric_limits<float>::epsilon())
       {
-        if (std::abs(last_commanded_time_.seconds()) < std::numeric_limits<float>::epsilon())
-        {
-          last_commanded_time_ = time;
-        }
-        current_trajectory_->set_point_before_trajectory_msg(
-          last_commanded_time_, last_commanded_state_, joints_angle_wraparound_);
+        group.last_commanded_time = time;
+      }
+      if (group.is_identity)
+      {
+        group.current_trajectory->set_point_before_trajectory_msg(
+          group.last_commanded_time, last_commanded_state_, group.joints_angle_wraparound);
       }
       else
       {
-        current_trajectory_->set_point_before_trajectory_msg(
-          time, state_current_, joints_angle_wraparound_);
+        gather_group_point(group, last_commanded_state_, group.last_commanded_state);
+        group.current_trajectory->set_point_before_trajectory_msg(
+          group.last_commanded_time, group.last_commanded_state, group.joints_angle_wraparound);
       }
-      traj_time_ = time;
     }
     else
     {
-      traj_time_ += period * scaling_factor_.load();
+      group.current_trajectory->set_point_before_trajectory_msg(
+        time, state_current, group.joints_angle_wraparound);
     }
+    group.traj_time = time;
+    group.tracking_statistics.reset();
 
+    // hand the trajectory over to the worker thread, holding is cheap enough to sample directly
+    group.use_command_table = false;
+    if (group.command_table && group.table_msg && !group.is_holding())
+    {
+      const bool from_commanded_state = params_.interpolate_from_desired_state;
+      group.use_command_table = group.command_table->request(
+        group.table_msg, from_commanded_state ? group.last_commanded_time : time,
+        from_commanded_state
+          ? (group.is_identity ? last_commanded_state_ : group.last_commanded_state)
+          : state_current,
+        group.joints_angle_wraparound, time, update_period_, interpolation_method_);
+    }
+  }
+  else
+  {
+    group.traj_time += period * scaling_factor_.load();
+  }
+
+  // Look up the precomputed samples, interpolated between the control cycles
+  size_t table_start_index = 0;
+  size_t table_end_index = 0;
+  const bool from_table =
+    group.use_command_table && !first_sample &&
+    group.command_table->sample(
+      group.traj_time, state_desired, table_start_index, table_end_index) &&
+    group.command_table->sample(
+      group.traj_time + update_period_, command_next, table_start_index, table_end_index);
+
+  bool valid_point = false;
+  if (from_table)
+  {
+    ++group.command_table_cycles;
+    start_segment_itr =
+      group.current_trajectory->begin() +
+      static_cast<TrajectoryPointConstIter::difference_type>(table_start_index);
+    end_segment_itr =
+      group.current_trajectory->begin() +
+      static_cast<TrajectoryPointConstIter::difference_type>(table_end_index);
+    valid_point = true;
+  }
+  else
+  {
     // Sample expected state from the trajectory
-    current_trajectory_->sample(
-      traj_time_, interpolation_method_, state_desired_, start_segment_itr, end_segment_itr);
-    state_desired_.time_from_start = traj_time_ - current_trajectory_->time_from_start();
+    group.current_trajectory->sample(
+      group.traj_time, interpolation_method_, state_desired, start_segment_itr, end_segment_itr);
 
     // Sample setpoint for next control cycle
-    const bool valid_point = current_trajectory_->sample(
-      traj_time_ + update_period_, interpolation_method_, command_next_, start_segment_itr,
+    valid_point = group.current_trajectory->sample(
+      group.traj_time + update_period_, interpolation_method_, command_next, start_segment_itr,
       end_segment_itr, false);
+  }
+  state_desired.time_from_start = group.traj_time - group.current_trajectory->time_from_start();
 
-    state_current_.time_from_start = time - current_trajectory_->time_from_start();
-
-    if (valid_point)
-    {
-      const rclcpp::Time traj_start = current_trajectory_->time_from_start();
-      // this is the time instance
-      // - started with the first segment: when the first point will be reached (in the future)
-      // - later: when the point of the current segment was reached
-      const rclcpp::Time segment_time_from_start = traj_start + start_segment_itr->time_from_start;
-      // time_difference is
-      // - negative until first point is reached
-      // - counting from zero to time_from_start of next point
-      double time_difference = traj_time_.seconds() - segment_time_from_start.seconds();
-      bool tolerance_violated_while_moving = false;
-      bool outside_goal_tolerance = false;
-      bool within_goal_time = true;
-      const bool before_last_point = end_segment_itr != current_trajectory_->end();
-      auto active_tol = active_tolerances_.readFromRT();
-
-      // have we reached the end, are not holding position, and is a timeout configured?
-      // Check independently of other tolerances
-      if (
-        !before_last_point && !rt_is_holding_ && cmd_timeout_ > 0.0 &&
-        time_difference > cmd_timeout_)
+  // Sample the commands of joints with actuator latency at the time they take effect. The
+  // tolerances are still checked against state_desired, which is aligned with the current state.
+  for (const auto & lookahead : group.command_lookaheads)
+  {
+    TrajectoryPointConstIter lookahead_start_itr, lookahead_end_itr;
+    if (!group.current_trajectory->sample(
+          group.traj_time + update_period_ + lookahead.duration, interpolation_method_,
+          group.lookahead_point, lookahead_start_itr, lookahead_end_itr, false))
+    {
+      continue;
+    }
+    auto copy_joints = [&lookahead](const std::vector<double> & from, std::vector<double> & to)
+    {
+      if (from.size() != to.size())
       {
-        RCLCPP_WARN(logger, "Aborted due to command timeout");
-
-        new_trajectory_msg_.reset();
-        new_trajectory_msg_.initRT(set_hold_position());
+        return;
       }
-
-      // Check state/goal tolerance
-      for (size_t index = 0; index < dof_; ++index)
+      for (const auto index : lookahead.joint_indices)
       {
-        compute_error_for_joint(state_error_, index, state_current_, state_desired_);
-
-        // Always check the state tolerance on the first sample in case the first sample
-        // is the last point
-        // print output per default, goal will be aborted afterwards
-        if (
-          (before_last_point || first_sample) && !rt_is_holding_ &&
-          !check_state_tolerance_per_joint(
-            state_error_, index, active_tol->state_tolerance[index], true /* show_errors */))
-        {
-          tolerance_violated_while_moving = true;
-        }
-        // past the final point, check that we end up inside goal tolerance
-        if (
-          !before_last_point && !rt_is_holding_ &&
-          !check_state_tolerance_per_joint(
-            state_error_, index, active_tol->goal_state_tolerance[index], false /* show_errors */))
-        {
-          outside_goal_tolerance = true;
-
-          if (active_tol->goal_time_tolerance != 0.0)
-          {
-            // if we exceed goal_time_tolerance set it to aborted
-            if (time_difference > active_tol->goal_time_tolerance)
-            {
-              within_goal_time = false;
-              // print once, goal will be aborted afterwards
-              check_state_tolerance_per_joint(
-                state_error_, index, default_tolerances_.goal_state_tolerance[index],
-                true /* show_errors */);
-            }
-          }
-        }
+        to[index] = from[index];
       }
+    };
+    copy_joints(group.lookahead_point.positions, command_next.positions);
+    copy_joints(group.lookahead_point.velocities, command_next.velocities);
+    copy_joints(group.lookahead_point.accelerations, command_next.accelerations);
+    copy_joints(group.lookahead_point.effort, command_next.effort);
+  }
 
-      // set values for next hardware write() if tolerance is met
-      if (!tolerance_violated_while_moving && within_goal_time)
-      {
-        if (use_closed_loop_pid_adapter_)
-        {
-          // Update PIDs
-          for (auto i = 0ul; i < num_cmd_joints_; ++i)
-          {
-            // If effort interface only, add desired effort as feed forward
-            // If velocity interface, ignore desired effort
-            size_t index_cmd_joint = map_cmd_to_joints_[i];
-            tmp_command_[index_cmd_joint] =
-              (command_next_.velocities[index_cmd_joint] * ff_velocity_scale_[i]) +
-              (has_effort_command_interface_ ? command_next_.effort[index_cmd_joint] : 0.0) +
-              pids_[i]->compute_command(
-                state_error_.positions[index_cmd_joint], state_error_.velocities[index_cmd_joint],
-                period);
-          }
-        }
+  state_current.time_from_start = time - group.current_trajectory->time_from_start();
 
-        // set values for next hardware write()
-        if (has_position_command_interface_)
-        {
-          assign_interface_from_point(joint_command_interface_[0], command_next_.positions);
-        }
-        if (has_velocity_command_interface_)
-        {
-          if (use_closed_loop_pid_adapter_)
-          {
-            assign_interface_from_point(joint_command_interface_[1], tmp_command_);
-          }
-          else
-          {
-            assign_interface_from_point(joint_command_interface_[1], command_next_.velocities);
-          }
-        }
-        if (has_acceleration_command_interface_)
-        {
-          assign_interface_from_point(joint_command_interface_[2], command_next_.accelerations);
-        }
-        if (has_effort_command_interface_)
-        {
-          if (use_closed_loop_pid_adapter_)
-          {
-            assign_interface_from_point(joint_command_interface_[3], tmp_command_);
-          }
-          else
-          {
-            // If position and effort command interfaces, only pass desired effort
-            assign_interface_from_point(joint_command_interface_[3], state_desired_.effort);
-          }
-        }
+  if (!group.is_identity)
+  {
+    scatter_group_point(group, state_desired, state_desired_);
+    scatter_group_point(group, command_next, command_next_);
+  }
 
-        // store the previous command and time used in open-loop control mode
-        last_commanded_state_ = command_next_;
-        last_commanded_time_ = time;
-      }
+  if (!valid_point)
+  {
+    return;
+  }
+
+  const rclcpp::Time traj_start = group.current_trajectory->time_from_start();
+  // this is the time instance
+  // - started with the first segment: when the first point will be reached (in the future)
+  // - later: when the point of the current segment was reached
+  const rclcpp::Time segment_time_from_start = traj_start + start_segment_itr->time_from_start;
+  // time_difference is
+  // - negative until first point is reached
+  // - counting from zero to time_from_start of next point
+  double time_difference = group.traj_time.seconds() - segment_time_from_start.seconds();
+  bool tolerance_violated_while_moving = false;
+  bool outside_goal_tolerance = false;
+  bool within_goal_time = true;
+  const bool before_last_point = end_segment_itr != group.current_trajectory->end();
+  auto active_tol = group.active_tolerances.readFromRT();
+
+  // have we reached the end, are not holding position, and is a timeout configured?
+  // Check independently of other tolerances
+  if (
+    !before_last_point && !group.is_holding() && cmd_timeout_ > 0.0 &&
+    time_difference > cmd_timeout_)
+  {
+    RCLCPP_WARN(logger, "Aborted due to command timeout");
+
+    start_holding(group, ExecutionState::HOLDING, time);
+  }
+
+  // the statistics are accumulated over the execution of an action goal
+  const bool track_statistics =
+    group.tracking_statistics_rt_publisher && active_goal && !group.is_holding();
+
+  // Check state/goal tolerance
+  for (size_t group_index = 0; group_index < group.joint_indices.size(); ++group_index)
+  {
+    const auto index = group.joint_indices[group_index];
+    compute_error_for_joint(state_error_, index, state_current_, state_desired_);
+
+    // Always check the state tolerance on the first sample in case the first sample
+    // is the last point
+    // print output per default, goal will be aborted afterwards
+    const bool joint_violates_path_tolerance =
+      (before_last_point || first_sample) && !group.is_holding() &&
+      !check_state_tolerance_per_joint(
+        state_error_, index, active_tol->state_tolerance[index], true /* show_errors */);
+    if (joint_violates_path_tolerance)
+    {
+      tolerance_violated_while_moving = true;
+    }
+    if (track_statistics)
+    {
+      // the velocity error is only computed with a velocity state interface
+      group.tracking_statistics.add_error(
+        group_index, state_error_.positions[index],
+        has_velocity_state_interface_ ? state_error_.velocities[index] : 0.0,
+        joint_violates_path_tolerance, period.seconds());
+    }
+    // past the final point, check that we end up inside goal tolerance
+    const bool joint_outside_goal_tolerance =
+      !before_last_point && !group.is_holding() &&
+      !check_state_tolerance_per_joint(
+        state_error_, index, active_tol->goal_state_tolerance[index], false /* show_errors */);
+    if (track_statistics && !before_last_point)
+    {
+      group.tracking_statistics.add_goal_check(
+        group_index, !joint_outside_goal_tolerance, time_difference);
+    }
+    if (joint_outside_goal_tolerance)
+    {
+      outside_goal_tolerance = true;
 
-      if (active_goal)
+      if (active_tol->goal_time_tolerance != 0.0)
       {
-        // send feedback
-        auto feedback = std::make_shared<FollowJTrajAction::Feedback>();
-        feedback->header.stamp = time;
-        feedback->joint_names = params_.joints;
-
-        feedback->actual = state_current_;
-        feedback->desired = state_desired_;
-        feedback->error = state_error_;
-        active_goal->setFeedback(feedback);
-
-        // check abort
-        if (tolerance_violated_while_moving)
-        {
-          auto result = std::make_shared<FollowJTrajAction::Result>();
-          result->set__error_code(FollowJTrajAction::Result::PATH_TOLERANCE_VIOLATED);
-          result->set__error_string("Aborted due to path tolerance violation");
-          active_goal->setAborted(result);
-          // TODO(matthew-reynolds): Need a lock-free write here
-          // See https://github.com/ros-controls/ros2_controllers/issues/168
-          rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
-          rt_has_pending_goal_ = false;
-
-          RCLCPP_WARN(logger, "Aborted due to state tolerance violation");
-
-          new_trajectory_msg_.reset();
-          new_trajectory_msg_.initRT(set_hold_position());
-        }
-        // check goal tolerance
-        else if (!before_last_point)
+        // if we exceed goal_time_tolerance set it to aborted
+        if (time_difference > active_tol->goal_time_tolerance)
         {
-          if (!outside_goal_tolerance)
-          {
-            auto result = std::make_shared<FollowJTrajAction::Result>();
-            result->set__error_code(FollowJTrajAction::Result::SUCCESSFUL);
-            result->set__error_string("Goal successfully reached!");
-            active_goal->setSucceeded(result);
-            // TODO(matthew-reynolds): Need a lock-free write here
-            // See https://github.com/ros-controls/ros2_controllers/issues/168
-            rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
-            rt_has_pending_goal_ = false;
-
-            RCLCPP_INFO(logger, "Goal reached, success!");
-
-            new_trajectory_msg_.reset();
-            new_trajectory_msg_.initRT(set_success_trajectory_point());
-          }
-          else if (!within_goal_time)
-          {
-            const std::string error_string = "Aborted due to goal_time_tolerance exceeding by " +
-                                             std::to_string(time_difference) + " seconds";
-
-            auto result = std::make_shared<FollowJTrajAction::Result>();
-            result->set__error_code(FollowJTrajAction::Result::GOAL_TOLERANCE_VIOLATED);
-            result->set__error_string(error_string);
-            active_goal->setAborted(result);
-            // TODO(matthew-reynolds): Need a lock-free write here
-            // See https://github.com/ros-controls/ros2_controllers/issues/168
-            rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
-            rt_has_pending_goal_ = false;
-
-            RCLCPP_WARN(logger, "%s", error_string.c_str());
-
-            new_trajectory_msg_.reset();
-            new_trajectory_msg_.initRT(set_hold_position());
-          }
+          within_goal_time = false;
+          // print once, goal will be aborted afterwards
+          check_state_tolerance_per_joint(
+            state_error_, index, default_tolerances_.goal_state_tolerance[index],
+            true /* show_errors */);
         }
       }
-      else if (tolerance_violated_while_moving && !rt_has_pending_goal_)
-      {
-        // we need to ensure that there is no pending goal -> we get a race condition otherwise
-        RCLCPP_ERROR(logger, "Holding position due to state tolerance violation");
+    }
+  }
 
-        new_trajectory_msg_.reset();
-        new_trajectory_msg_.initRT(set_hold_position());
+  if (track_statistics)
+  {
+    group.tracking_statistics.finish_cycle();
+  }
+
+  // commands are written for all groups at once after sampling
+  if (!tolerance_violated_while_moving && within_goal_time)
+  {
+    group.write_commands = true;
+    group.last_commanded_time = time;
+  }
+
+  if (active_goal)
+  {
+    // send feedback
+    auto feedback = std::make_shared<FollowJTrajAction::Feedback>();
+    feedback->header.stamp = time;
+    feedback->joint_names = group.joint_names;
+
+    feedback->actual = state_current;
+    feedback->desired = state_desired;
+    if (group.is_identity)
+    {
+      feedback->error = state_error_;
+    }
+    else
+    {
+      gather_group_point(group, state_error_, group.state_error);
+      feedback->error = group.state_error;
+    }
+    active_goal->setFeedback(feedback);
+
+    // check abort
+    if (tolerance_violated_while_moving)
+    {
+      auto result = std::make_shared<FollowJTrajAction::Result>();
+      result->set__error_code(FollowJTrajAction::Result::PATH_TOLERANCE_VIOLATED);
+      result->set__error_string("Aborted due to path tolerance violation");
+      active_goal->setAborted(result);
+      // TODO(matthew-reynolds): Need a lock-free write here
+      // See https://github.com/ros-controls/ros2_controllers/issues/168
+      group.rt_active_goal.writeFromNonRT(RealtimeGoalHandlePtr());
+      group.rt_has_pending_goal = false;
+      publish_tracking_statistics(group, time);
+
+      RCLCPP_WARN(logger, "Aborted due to state tolerance violation");
+
+      start_holding(group, ExecutionState::HOLDING, time);
+    }
+    // check goal tolerance
+    else if (!before_last_point)
+    {
+      if (!outside_goal_tolerance)
+      {
+        auto result = std::make_shared<FollowJTrajAction::Result>();
+        result->set__error_code(FollowJTrajAction::Result::SUCCESSFUL);
+        result->set__error_string("Goal successfully reached!");
+        active_goal->setSucceeded(result);
+        // TODO(matthew-reynolds): Need a lock-free write here
+        // See https://github.com/ros-controls/ros2_controllers/issues/168
+        group.rt_active_goal.writeFromNonRT(RealtimeGoalHandlePtr());
+        group.rt_has_pending_goal = false;
+        publish_tracking_statistics(group, time);
+
+        RCLCPP_INFO(logger, "Goal reached, success!");
+
+        start_holding(group, ExecutionState::HOLDING_LAST_POINT, time);
       }
-      else if (!before_last_point && !within_goal_time && !rt_has_pending_goal_)
+      else if (!within_goal_time)
       {
-        RCLCPP_ERROR(logger, "Exceeded goal_time_tolerance: holding position...");
-
-        new_trajectory_msg_.reset();
-        new_trajectory_msg_.initRT(set_hold_position());
+        const std::string error_string = "Aborted due to goal_time_tolerance exceeding by " +
+                                         std::to_string(time_difference) + " seconds";
+
+        auto result = std::make_shared<FollowJTrajAction::Result>();
+        result->set__error_code(FollowJTrajAction::Result::GOAL_TOLERANCE_VIOLATED);
+        result->set__error_string(error_string);
+        active_goal->setAborted(result);
+        // TODO(matthew-reynolds): Need a lock-free write here
+        // See https://github.com/ros-controls/ros2_controllers/issues/168
+        group.rt_active_goal.writeFromNonRT(RealtimeGoalHandlePtr());
+        group.rt_has_pending_goal = false;
+        publish_tracking_statistics(group, time);
+
+        RCLCPP_WARN(logger, "%s", error_string.c_str());
+
+        start_holding(group, ExecutionState::HOLDING, time);
       }
-      // else, run another cycle while waiting for outside_goal_tolerance
-      // to be satisfied (will stay in this state until new message arrives)
-      // or outside_goal_tolerance violated within the goal_time_tolerance
     }
   }
+  else if (tolerance_violated_while_moving && !group.rt_has_pending_goal)
+  {
+    // we need to ensure that there is no pending goal -> we get a race condition otherwise
+    RCLCPP_ERROR(logger, "Holding position due to state tolerance violation");
 
-  publish_state(time, state_desired_, state_current_, state_error_);
-  return controller_interface::return_type::OK;
+    start_holding(group, ExecutionState::HOLDING, time);
+  }
+  else if (!before_last_point && !within_goal_time && !group.rt_has_pending_goal)
+  {
+    RCLCPP_ERROR(logger, "Exceeded goal_time_tolerance: holding position...");
+
+    start_holding(group, ExecutionState::HOLDING, time);
+  }
+  // else, run another cycle while waiting for outside_goal_tolerance
+  // to be satisfied (will stay in this state until new message arrives)
+  // or outside_goal_tolerance violated within the goal_time_tolerance
 }
 
 void JointTrajectoryController::read_state_from_state_interfaces(JointTrajectoryPoint & state)
@@ -678,29 +884,38 @@ void JointTrajectoryController::query_state_service(
     response->success = false;
     return;
   }
-  const auto active_goal = *rt_active_goal_.readFromRT();
   response->name = params_.joints;
   trajectory_msgs::msg::JointTrajectoryPoint state_requested = state_current_;
   if (has_active_trajectory())
   {
-    TrajectoryPointConstIter start_segment_itr, end_segment_itr;
-    response->success = current_trajectory_->sample(
-      static_cast<rclcpp::Time>(request->time), interpolation_method_, state_requested,
-      start_segment_itr, end_segment_itr);
-    // If the requested sample time precedes the trajectory finish time respond as failure
-    if (response->success)
+    response->success = true;
+    for (const auto & group : joint_groups_)
     {
-      if (end_segment_itr == current_trajectory_->end())
+      TrajectoryPointConstIter start_segment_itr, end_segment_itr;
+      trajectory_msgs::msg::JointTrajectoryPoint group_state;
+      const bool sampled = group->current_trajectory->sample(
+        static_cast<rclcpp::Time>(request->time), interpolation_method_,
+        group->is_identity ? state_requested : group_state, start_segment_itr, end_segment_itr);
+      // If the requested sample time precedes the trajectory finish time respond as failure
+      if (sampled)
+      {
+        if (!group->is_identity)
+        {
+          scatter_group_point(*group, group_state, state_requested);
+        }
+        if (end_segment_itr == group->current_trajectory->end())
+        {
+          RCLCPP_ERROR(logger, "Requested sample time precedes the current trajectory end time.");
+          response->success = false;
+        }
+      }
+      else
       {
-        RCLCPP_ERROR(logger, "Requested sample time precedes the current trajectory end time.");
+        RCLCPP_ERROR(
+          logger, "Requested sample time is earlier than the current trajectory start time.");
         response->success = false;
       }
     }
-    else
-    {
-      RCLCPP_ERROR(
-        logger, "Requested sample time is earlier than the current trajectory start time.");
-    }
   }
   else
   {
@@ -878,7 +1093,6 @@ controller_interface::CallbackReturn JointTrajectoryController::on_configure(
 
   // parse remaining parameters
   default_tolerances_ = get_segment_tolerances(logger, params_);
-  active_tolerances_.initRT(default_tolerances_);
   const std::string interpolation_string =
     get_node()->get_parameter("interpolation_method").as_string();
   interpolation_method_ = interpolation_methods::from_string(interpolation_string);
@@ -886,15 +1100,7 @@ controller_interface::CallbackReturn JointTrajectoryController::on_configure(
     logger, "Using '%s' interpolation method.",
     interpolation_methods::InterpolationMethodMap.at(interpolation_method_).c_str());
 
-  // prepare hold_position_msg
-  init_hold_position_msg();
-
-  // create subscriber and publishers
-  joint_command_subscriber_ =
-    get_node()->create_subscription<trajectory_msgs::msg::JointTrajectory>(
-      "~/joint_trajectory", rclcpp::SystemDefaultsQoS(),
-      std::bind(&JointTrajectoryController::topic_callback, this, std::placeholders::_1));
-
+  // create publishers
   publisher_ = get_node()->create_publisher<ControllerStateMsg>(
     "~/controller_state", rclcpp::SystemDefaultsQoS());
   state_publisher_ = std::make_unique<StatePublisher>(publisher_);
@@ -945,14 +1151,11 @@ controller_interface::CallbackReturn JointTrajectoryController::on_configure(
     logger, "Action status changes will be monitored at %.2f Hz.", params_.action_monitor_rate);
   action_monitor_period_ = rclcpp::Duration::from_seconds(1.0 / params_.action_monitor_rate);
 
-  using namespace std::placeholders;
-  action_server_ = rclcpp_action::create_server<FollowJTrajAction>(
-    get_node()->get_node_base_interface(), get_node()->get_node_clock_interface(),
-    get_node()->get_node_logging_interface(), get_node()->get_node_waitables_interface(),
-    std::string(get_node()->get_name()) + "/follow_joint_trajectory",
-    std::bind(&JointTrajectoryController::goal_received_callback, this, _1, _2),
-    std::bind(&JointTrajectoryController::goal_cancelled_callback, this, _1),
-    std::bind(&JointTrajectoryController::goal_accepted_callback, this, _1));
+  // create the joint groups with their subscribers and action servers
+  if (!configure_joint_groups())
+  {
+    return CallbackReturn::FAILURE;
+  }
 
   resize_joint_trajectory_point(state_current_, dof_);
   resize_joint_trajectory_point_command(
@@ -961,6 +1164,19 @@ controller_interface::CallbackReturn JointTrajectoryController::on_configure(
   resize_joint_trajectory_point(state_error_, dof_);
   resize_joint_trajectory_point(
     last_commanded_state_, dof_, std::numeric_limits<double>::quiet_NaN());
+  if (joint_groups_.size() > 1)
+  {
+    // the groups are sampled separately and copied field by field into these points
+    for (auto * point : {&state_desired_, &command_next_, &last_commanded_state_})
+    {
+      point->positions.resize(dof_, std::numeric_limits<double>::quiet_NaN());
+      point->velocities.resize(dof_, 0.0);
+      point->accelerations.resize(dof_, 0.0);
+      point->effort.resize(dof_, 0.0);
+    }
+  }
+
+  using namespace std::placeholders;
 
   // create services
   query_state_srv_ = get_node()->create_service<control_msgs::srv::QueryTrajectoryState>(
@@ -1009,6 +1225,7 @@ controller_interface::CallbackReturn JointTrajectoryController::on_configure(
   }
   update_period_ =
     rclcpp::Duration(0.0, static_cast<uint32_t>(1.0e9 / static_cast<double>(get_update_rate())));
+  configure_command_lookahead();
 
   return CallbackReturn::SUCCESS;
 }
@@ -1064,13 +1281,16 @@ controller_interface::CallbackReturn JointTrajectoryController::on_activate(
   }
 
   // order all joints in the storage
+  const auto command_interface_index = index_interfaces_by_name(command_interfaces_);
+  const auto state_interface_index = index_interfaces_by_name(state_interfaces_);
   for (const auto & interface : params_.command_interfaces)
   {
     auto it =
       std::find(allowed_interface_types_.begin(), allowed_interface_types_.end(), interface);
     auto index = static_cast<size_t>(std::distance(allowed_interface_types_.begin(), it));
-    if (!controller_interface::get_ordered_interfaces(
-          command_interfaces_, command_joint_names_, interface, joint_command_interface_[index]))
+    if (!get_ordered_interfaces(
+          command_interfaces_, command_interface_index, command_joint_names_, interface,
+          joint_command_interface_[index]))
     {
       RCLCPP_ERROR(
         logger, "Expected %zu '%s' command interfaces, got %zu.", num_cmd_joints_,
@@ -1083,8 +1303,9 @@ controller_interface::CallbackReturn JointTrajectoryController::on_activate(
     auto it =
       std::find(allowed_interface_types_.begin(), allowed_interface_types_.end(), interface);
     auto index = static_cast<size_t>(std::distance(allowed_interface_types_.begin(), it));
-    if (!controller_interface::get_ordered_interfaces(
-          state_interfaces_, params_.joints, interface, joint_state_interface_[index]))
+    if (!get_ordered_interfaces(
+          state_interfaces_, state_interface_index, params_.joints, interface,
+          joint_state_interface_[index]))
     {
       RCLCPP_ERROR(
         logger, "Expected %zu '%s' state interfaces, got %zu.", dof_, interface.c_str(),
@@ -1093,8 +1314,12 @@ controller_interface::CallbackReturn JointTrajectoryController::on_activate(
     }
   }
 
-  current_trajectory_ = std::make_shared<Trajectory>();
-  new_trajectory_msg_.writeFromNonRT(std::shared_ptr<trajectory_msgs::msg::JointTrajectory>());
+  for (auto & group : joint_groups_)
+  {
+    group->current_trajectory = std::make_shared<Trajectory>();
+    group->new_trajectory_msg.writeFromNonRT(
+      std::shared_ptr<trajectory_msgs::msg::JointTrajectory>());
+  }
 
   subscriber_is_active_ = true;
 
@@ -1120,11 +1345,13 @@ controller_interface::CallbackReturn JointTrajectoryController::on_activate(
     read_state_from_state_interfaces(state_current_);
     read_state_from_state_interfaces(last_commanded_state_);
   }
-  last_commanded_time_ = rclcpp::Time();
-
   // The controller should start by holding position at the beginning of active state
-  add_new_trajectory_msg(set_hold_position());
-  rt_is_holding_ = true;
+  for (auto & group : joint_groups_)
+  {
+    group->last_commanded_time = rclcpp::Time();
+    group->last_external_msg.reset();
+    add_new_trajectory_msg(set_hold_position(*group), *group);
+  }
 
   // parse timeout parameter
   if (params_.cmd_timeout > 0.0)
@@ -1153,15 +1380,18 @@ controller_interface::CallbackReturn JointTrajectoryController::on_activate(
 controller_interface::CallbackReturn JointTrajectoryController::on_deactivate(
   const rclcpp_lifecycle::State &)
 {
-  const auto active_goal = *rt_active_goal_.readFromNonRT();
-  if (active_goal)
+  for (auto & group : joint_groups_)
   {
-    rt_has_pending_goal_ = false;
-    auto action_res = std::make_shared<FollowJTrajAction::Result>();
-    action_res->set__error_code(FollowJTrajAction::Result::INVALID_GOAL);
-    action_res->set__error_string("Current goal cancelled during deactivate transition.");
-    active_goal->setAborted(action_res);
-    rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
+    const auto active_goal = *group->rt_active_goal.readFromNonRT();
+    if (active_goal)
+    {
+      group->rt_has_pending_goal = false;
+      auto action_res = std::make_shared<FollowJTrajAction::Result>();
+      action_res->set__error_code(FollowJTrajAction::Result::INVALID_GOAL);
+      action_res->set__error_string("Current goal cancelled during deactivate transition.");
+      active_goal->setAborted(action_res);
+      group->rt_active_goal.writeFromNonRT(RealtimeGoalHandlePtr());
+    }
   }
 
   for (size_t index = 0; index < num_cmd_joints_; ++index)
@@ -1198,7 +1428,10 @@ controller_interface::CallbackReturn JointTrajectoryController::on_deactivate(
 
   subscriber_is_active_ = false;
 
-  current_trajectory_.reset();
+  for (auto & group : joint_groups_)
+  {
+    group->current_trajectory.reset();
+  }
 
   return CallbackReturn::SUCCESS;
 }
@@ -1216,7 +1449,6 @@ controller_interface::CallbackReturn JointTrajectoryController::on_error(
 bool JointTrajectoryController::reset()
 {
   subscriber_is_active_ = false;
-  joint_command_subscriber_.reset();
 
   for (const auto & pid : pids_)
   {
@@ -1226,7 +1458,11 @@ bool JointTrajectoryController::reset()
     }
   }
 
-  current_trajectory_.reset();
+  for (auto & group : joint_groups_)
+  {
+    group->joint_command_subscriber.reset();
+    group->current_trajectory.reset();
+  }
 
   return true;
 }
@@ -1264,9 +1500,9 @@ void JointTrajectoryController::publish_state(
 }
 
 void JointTrajectoryController::topic_callback(
-  const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> msg)
+  const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> msg, JointGroup & group)
 {
-  if (!validate_trajectory_msg(*msg))
+  if (!validate_trajectory_msg(*msg, group.joint_names))
   {
     return;
   }
@@ -1274,13 +1510,13 @@ void JointTrajectoryController::topic_callback(
   // always replace old msg with new one for now
   if (subscriber_is_active_)
   {
-    add_new_trajectory_msg(msg);
-    rt_is_holding_ = false;
+    add_new_trajectory_msg(msg, group);
   }
 };
 
 rclcpp_action::GoalResponse JointTrajectoryController::goal_received_callback(
-  const rclcpp_action::GoalUUID &, std::shared_ptr<const FollowJTrajAction::Goal> goal)
+  const rclcpp_action::GoalUUID &, std::shared_ptr<const FollowJTrajAction::Goal> goal,
+  JointGroup & group)
 {
   RCLCPP_INFO(get_node()->get_logger(), "Received new action goal");
 
@@ -1292,7 +1528,7 @@ rclcpp_action::GoalResponse JointTrajectoryController::goal_received_callback(
     return rclcpp_action::GoalResponse::REJECT;
   }
 
-  if (!validate_trajectory_msg(goal->trajectory))
+  if (!validate_trajectory_msg(goal->trajectory, group.joint_names))
   {
     return rclcpp_action::GoalResponse::REJECT;
   }
@@ -1302,61 +1538,62 @@ rclcpp_action::GoalResponse JointTrajectoryController::goal_received_callback(
 }
 
 rclcpp_action::CancelResponse JointTrajectoryController::goal_cancelled_callback(
-  const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+  const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle,
+  JointGroup & group)
 {
   RCLCPP_INFO(get_node()->get_logger(), "Got request to cancel goal");
 
   // Check that cancel request refers to currently active goal (if any)
-  const auto active_goal = *rt_active_goal_.readFromNonRT();
+  const auto active_goal = *group.rt_active_goal.readFromNonRT();
   if (active_goal && active_goal->gh_ == goal_handle)
   {
     RCLCPP_INFO(
       get_node()->get_logger(), "Canceling active action goal because cancel callback received.");
 
     // Mark the current goal as canceled
-    rt_has_pending_goal_ = false;
+    group.rt_has_pending_goal = false;
     auto action_res = std::make_shared<FollowJTrajAction::Result>();
     active_goal->setCanceled(action_res);
-    rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
+    group.rt_active_goal.writeFromNonRT(RealtimeGoalHandlePtr());
 
     // Enter hold current position mode
-    add_new_trajectory_msg(set_hold_position());
+    add_new_trajectory_msg(set_hold_position(group), group);
   }
   return rclcpp_action::CancelResponse::ACCEPT;
 }
 
 void JointTrajectoryController::goal_accepted_callback(
-  std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+  std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle,
+  JointGroup & group)
 {
   // mark a pending goal
-  rt_has_pending_goal_ = true;
+  group.rt_has_pending_goal = true;
 
   // Update new trajectory
   {
-    preempt_active_goal();
+    preempt_active_goal(group);
     auto traj_msg =
       std::make_shared<trajectory_msgs::msg::JointTrajectory>(goal_handle->get_goal()->trajectory);
 
-    add_new_trajectory_msg(traj_msg);
-    rt_is_holding_ = false;
+    add_new_trajectory_msg(traj_msg, group);
   }
 
   // Update the active goal
   RealtimeGoalHandlePtr rt_goal = std::make_shared<RealtimeGoalHandle>(goal_handle);
-  rt_goal->preallocated_feedback_->joint_names = params_.joints;
+  rt_goal->preallocated_feedback_->joint_names = group.joint_names;
   rt_goal->execute();
-  rt_active_goal_.writeFromNonRT(rt_goal);
+  group.rt_active_goal.writeFromNonRT(rt_goal);
 
   // Update tolerances if specified in the goal
   auto logger = this->get_node()->get_logger();
-  active_tolerances_.writeFromNonRT(get_segment_tolerances(
+  group.active_tolerances.writeFromNonRT(get_segment_tolerances(
     logger, default_tolerances_, *(goal_handle->get_goal()), params_.joints));
 
   // Set smartpointer to expire for create_wall_timer to delete previous entry from timer list
-  goal_handle_timer_.reset();
+  group.goal_handle_timer.reset();
 
   // Setup goal status checking timer
-  goal_handle_timer_ = get_node()->create_wall_timer(
+  group.goal_handle_timer = get_node()->create_wall_timer(
     action_monitor_period_.to_chrono<std::chrono::nanoseconds>(),
     std::bind(&RealtimeGoalHandle::runNonRealtime, rt_goal));
 }
@@ -1390,19 +1627,21 @@ void JointTrajectoryController::compute_error_for_joint(
 }
 
 void JointTrajectoryController::fill_partial_goal(
-  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg) const
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg,
+  const JointGroup & group) const
 {
-  // joint names in the goal are a subset of existing joints, as checked in goal_callback
-  // so if the size matches, the goal contains all controller joints
-  if (dof_ == trajectory_msg->joint_names.size())
+  // joint names in the goal are a subset of the group joints, as checked in goal_callback
+  // so if the size matches, the goal contains all joints of the group
+  if (group.joint_names.size() == trajectory_msg->joint_names.size())
   {
     return;
   }
 
-  trajectory_msg->joint_names.reserve(dof_);
+  trajectory_msg->joint_names.reserve(group.joint_names.size());
 
-  for (size_t index = 0; index < dof_; ++index)
+  for (size_t group_index = 0; group_index < group.joint_names.size(); ++group_index)
   {
+    const size_t index = group.joint_indices[group_index];
     {
       if (
         std::find(
@@ -1450,10 +1689,11 @@ void JointTrajectoryController::fill_partial_goal(
 }
 
 void JointTrajectoryController::sort_to_local_joint_order(
-  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg) const
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg,
+  const std::vector<std::string> & joint_names) const
 {
   // rearrange all points in the trajectory message based on mapping
-  std::vector<size_t> mapping_vector = mapping(trajectory_msg->joint_names, params_.joints);
+  std::vector<size_t> mapping_vector = mapping(trajectory_msg->joint_names, joint_names);
   auto remap = [this](
                  const std::vector<double> & to_remap,
                  const std::vector<size_t> & mapping) -> std::vector<double>
@@ -1519,12 +1759,19 @@ bool JointTrajectoryController::validate_trajectory_point_field(
 
 bool JointTrajectoryController::validate_trajectory_msg(
   const trajectory_msgs::msg::JointTrajectory & trajectory) const
+{
+  return validate_trajectory_msg(trajectory, params_.joints);
+}
+
+bool JointTrajectoryController::validate_trajectory_msg(
+  const trajectory_msgs::msg::JointTrajectory & trajectory,
+  const std::vector<std::string> & joint_names) const
 {
   // CHECK: Partial joint goals
-  // If partial joints goals are not allowed, goal should specify all controller joints
+  // If partial joints goals are not allowed, goal should specify all joints
   if (!params_.allow_partial_joints_goal)
   {
-    if (trajectory.joint_names.size() != dof_)
+    if (trajectory.joint_names.size() != joint_names.size())
     {
       RCLCPP_ERROR(
         get_node()->get_logger(),
@@ -1552,8 +1799,8 @@ bool JointTrajectoryController::validate_trajectory_msg(
   {
     const std::string & incoming_joint_name = trajectory.joint_names[i];
 
-    auto it = std::find(params_.joints.begin(), params_.joints.end(), incoming_joint_name);
-    if (it == params_.joints.end())
+    auto it = std::find(joint_names.begin(), joint_names.end(), incoming_joint_name);
+    if (it == joint_names.end())
     {
       RCLCPP_ERROR(
         get_node()->get_logger(), "Incoming joint %s doesn't match the controller's joints.",
@@ -1665,48 +1912,107 @@ bool JointTrajectoryController::validate_trajectory_msg(
 }
 
 void JointTrajectoryController::add_new_trajectory_msg(
-  const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> & traj_msg)
+  const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> & traj_msg, JointGroup & group)
 {
-  new_trajectory_msg_.writeFromNonRT(traj_msg);
+  // the realtime thread completes partial goals, so the command table only gets full goals
+  if (
+    group.command_table && traj_msg != group.hold_position_msg_ptr &&
+    traj_msg->joint_names.size() == group.joint_names.size())
+  {
+    auto table_msg = std::make_shared<trajectory_msgs::msg::JointTrajectory>(*traj_msg);
+    sort_to_local_joint_order(table_msg, group.joint_names);
+    group.new_table_msg.writeFromNonRT({traj_msg, table_msg});
+  }
+  group.new_trajectory_msg.writeFromNonRT(traj_msg);
 }
 
-void JointTrajectoryController::preempt_active_goal()
+void JointTrajectoryController::preempt_active_goal(JointGroup & group)
 {
-  const auto active_goal = *rt_active_goal_.readFromNonRT();
+  const auto active_goal = *group.rt_active_goal.readFromNonRT();
   if (active_goal)
   {
     auto action_res = std::make_shared<FollowJTrajAction::Result>();
     action_res->set__error_code(FollowJTrajAction::Result::INVALID_GOAL);
     action_res->set__error_string("Current goal cancelled due to new incoming action.");
     active_goal->setCanceled(action_res);
-    rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
+    group.rt_active_goal.writeFromNonRT(RealtimeGoalHandlePtr());
   }
 }
 
 std::shared_ptr<trajectory_msgs::msg::JointTrajectory>
-JointTrajectoryController::set_hold_position()
+JointTrajectoryController::set_hold_position(JointGroup & group)
 {
   // Command to stay at current position
-  hold_position_msg_ptr_->points[0].positions = state_current_.positions;
-
-  // set flag, otherwise tolerances will be checked with holding position too
-  rt_is_holding_ = true;
+  auto & hold_positions = group.hold_position_msg_ptr->points[0].positions;
+  if (group.is_identity)
+  {
+    hold_positions = state_current_.positions;
+  }
+  else
+  {
+    hold_positions.resize(group.joint_indices.size());
+    for (size_t i = 0; i < group.joint_indices.size(); ++i)
+    {
+      hold_positions[i] = state_current_.positions[group.joint_indices[i]];
+    }
+  }
 
-  return hold_position_msg_ptr_;
+  return group.hold_position_msg_ptr;
 }
 
-std::shared_ptr<trajectory_msgs::msg::JointTrajectory>
-JointTrajectoryController::set_success_trajectory_point()
+void JointTrajectoryController::start_holding(
+  JointGroup & group, const ExecutionState state, const rclcpp::Time & time)
 {
-  // set last command to be repeated at success, no matter if it has nonzero velocity or
-  // acceleration
-  hold_position_msg_ptr_->points[0] = current_trajectory_->get_trajectory_msg()->points.back();
-  hold_position_msg_ptr_->points[0].time_from_start = rclcpp::Duration(0, 0);
+  // the memory of all fields is reserved in init_hold_position_msg()
+  auto & hold_point = group.rt_hold_msg->points[0];
+  if (state == ExecutionState::HOLDING_LAST_POINT && group.last_external_msg)
+  {
+    hold_point = group.last_external_msg->points.back();
+  }
+  else
+  {
+    hold_point.positions.resize(group.joint_indices.size());
+    for (size_t i = 0; i < group.joint_indices.size(); ++i)
+    {
+      hold_point.positions[i] = state_current_.positions[group.joint_indices[i]];
+    }
+    const auto & hold_template = group.hold_position_msg_ptr->points[0];
+    hold_point.velocities.assign(hold_template.velocities.size(), 0.0);
+    hold_point.accelerations.assign(hold_template.accelerations.size(), 0.0);
+    hold_point.effort.assign(hold_template.effort.size(), 0.0);
+  }
+  hold_point.time_from_start = rclcpp::Duration(0, 0);
 
-  // set flag, otherwise tolerances will be checked with success_trajectory_point too
-  rt_is_holding_ = true;
+  // set state, otherwise tolerances will be checked with the hold point too
+  group.execution_state = state;
+  group.use_command_table = false;
+  group.current_trajectory->update(group.rt_hold_msg);
 
-  return hold_position_msg_ptr_;
+  // sample the hold point already in this cycle instead of waiting for the next update
+  JointTrajectoryPoint & state_current = group.is_identity ? state_current_ : group.state_current;
+  JointTrajectoryPoint & state_desired = group.is_identity ? state_desired_ : group.state_desired;
+  JointTrajectoryPoint & command_next = group.is_identity ? command_next_ : group.command_next;
+  group.current_trajectory->set_point_before_trajectory_msg(
+    time, state_current, group.joints_angle_wraparound);
+  group.traj_time = time;
+  TrajectoryPointConstIter start_segment_itr, end_segment_itr;
+  group.current_trajectory->sample(
+    time, interpolation_method_, state_desired, start_segment_itr, end_segment_itr);
+  group.current_trajectory->sample(
+    time + update_period_, interpolation_method_, command_next, start_segment_itr,
+    end_segment_itr, false);
+  if (!group.is_identity)
+  {
+    scatter_group_point(group, state_desired, state_desired_);
+    scatter_group_point(group, command_next, command_next_);
+  }
+  // the PIDs act on the error with respect to the hold point
+  for (const auto index : group.joint_indices)
+  {
+    compute_error_for_joint(state_error_, index, state_current_, state_desired_);
+  }
+  group.write_commands = true;
+  group.last_commanded_time = time;
 }
 
 bool JointTrajectoryController::contains_interface_type(
@@ -1788,7 +2094,12 @@ bool JointTrajectoryController::set_scaling_factor(double scaling_factor)
 
 bool JointTrajectoryController::has_active_trajectory() const
 {
-  return current_trajectory_ != nullptr && current_trajectory_->has_trajectory_msg();
+  return !joint_groups_.empty() &&
+         std::all_of(
+           joint_groups_.begin(), joint_groups_.end(),
+           [](const auto & group) {
+             return group->current_trajectory && group->current_trajectory->has_trajectory_msg();
+           });
 }
 
 void JointTrajectoryController::update_pids()
@@ -1818,30 +2129,304 @@ void JointTrajectoryController::update_pids()
   }
 }
 
-void JointTrajectoryController::init_hold_position_msg()
+bool JointTrajectoryController::configure_joint_groups()
+{
+  auto logger = get_node()->get_logger();
+
+  // split the joints into groups, a single group containing all joints is used by default
+  std::vector<std::string> group_names = params_.joint_groups;
+  std::vector<size_t> map_joints_to_group(dof_, group_names.size());
+  std::unordered_map<std::string, size_t> joint_indices;
+  for (size_t index = 0; index < dof_; ++index)
+  {
+    joint_indices.emplace(params_.joints[index], index);
+  }
+  if (group_names.empty())
+  {
+    group_names.push_back("");
+    std::fill(map_joints_to_group.begin(), map_joints_to_group.end(), 0);
+  }
+  else
+  {
+    for (size_t group_index = 0; group_index < group_names.size(); ++group_index)
+    {
+      const auto & group_joints =
+        params_.groups.joint_groups_map.at(group_names[group_index]).joints;
+      if (group_joints.empty())
+      {
+        RCLCPP_ERROR(logger, "Joint group '%s' has no joints.", group_names[group_index].c_str());
+        return false;
+      }
+      for (const auto & joint_name : group_joints)
+      {
+        const auto it = joint_indices.find(joint_name);
+        if (it == joint_indices.end())
+        {
+          RCLCPP_ERROR(
+            logger, "Joint '%s' of group '%s' is not part of the 'joints' parameter.",
+            joint_name.c_str(), group_names[group_index].c_str());
+          return false;
+        }
+        const auto index = it->second;
+        if (map_joints_to_group[index] != group_names.size())
+        {
+          RCLCPP_ERROR(
+            logger, "Joint '%s' is part of the groups '%s' and '%s'.", joint_name.c_str(),
+            group_names[map_joints_to_group[index]].c_str(), group_names[group_index].c_str());
+          return false;
+        }
+        map_joints_to_group[index] = group_index;
+      }
+    }
+    for (size_t index = 0; index < dof_; ++index)
+    {
+      if (map_joints_to_group[index] == group_names.size())
+      {
+        RCLCPP_ERROR(
+          logger, "Joint '%s' is not part of any joint group.", params_.joints[index].c_str());
+        return false;
+      }
+    }
+  }
+
+  joint_groups_.clear();
+  for (size_t group_index = 0; group_index < group_names.size(); ++group_index)
+  {
+    auto group = std::make_unique<JointGroup>();
+    group->name = group_names[group_index];
+    for (size_t index = 0; index < dof_; ++index)
+    {
+      if (map_joints_to_group[index] == group_index)
+      {
+        group->joint_names.push_back(params_.joints[index]);
+        group->joint_indices.push_back(index);
+        if (!joints_angle_wraparound_.empty())
+        {
+          group->joints_angle_wraparound.push_back(joints_angle_wraparound_[index]);
+        }
+      }
+    }
+    const size_t group_dof = group->joint_indices.size();
+    group->is_identity = group_dof == dof_;
+    if (params_.command_table.enable)
+    {
+      group->command_table = std::make_unique<CommandTable>(
+        static_cast<size_t>(params_.command_table.max_cycles), group_dof);
+    }
+    group->active_tolerances.initRT(default_tolerances_);
+    init_hold_position_msg(*group);
+    if (!group->is_identity)
+    {
+      for (auto * point :
+           {&group->state_current, &group->state_desired, &group->command_next, &group->state_error,
+            &group->last_commanded_state})
+      {
+        point->positions.resize(group_dof, 0.0);
+        point->velocities.resize(group_dof, 0.0);
+        point->accelerations.resize(group_dof, 0.0);
+        point->effort.resize(group_dof, 0.0);
+      }
+    }
+
+    // topics and actions of a group are in a sub-namespace with the group name
+    const std::string prefix = group->name.empty() ? "" : group->name + "/";
+    JointGroup * group_ptr = group.get();
+    group->joint_command_subscriber =
+      get_node()->create_subscription<trajectory_msgs::msg::JointTrajectory>(
+        "~/" + prefix + "joint_trajectory", rclcpp::SystemDefaultsQoS(),
+        [this, group_ptr](const std::shared_ptr<trajectory_msgs::msg::JointTrajectory> msg)
+        { topic_callback(msg, *group_ptr); });
+    group->action_server = rclcpp_action::create_server<FollowJTrajAction>(
+      get_node()->get_node_base_interface(), get_node()->get_node_clock_interface(),
+      get_node()->get_node_logging_interface(), get_node()->get_node_waitables_interface(),
+      std::string(get_node()->get_name()) + "/" + prefix + "follow_joint_trajectory",
+      [this, group_ptr](
+        const rclcpp_action::GoalUUID & uuid, std::shared_ptr<const FollowJTrajAction::Goal> goal)
+      { return goal_received_callback(uuid, goal, *group_ptr); },
+      [this, group_ptr](
+        const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+      { return goal_cancelled_callback(goal_handle, *group_ptr); },
+      [this, group_ptr](
+        std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+      { goal_accepted_callback(goal_handle, *group_ptr); });
+
+    if (params_.publish_tracking_statistics)
+    {
+      group->tracking_statistics.resize(group_dof);
+      group->tracking_statistics_publisher = get_node()->create_publisher<TrackingStatisticsMsg>(
+        "~/" + prefix + "tracking_statistics", rclcpp::SystemDefaultsQoS());
+      group->tracking_statistics_rt_publisher =
+        std::make_unique<TrackingStatisticsPublisher>(group->tracking_statistics_publisher);
+
+      auto & rt_publisher = *group->tracking_statistics_rt_publisher;
+      rt_publisher.lock();
+      rt_publisher.msg_.joint_names = group->joint_names;
+      rt_publisher.msg_.interface_values.resize(group_dof);
+      for (auto & interface_value : rt_publisher.msg_.interface_values)
+      {
+        // the order is used by publish_tracking_statistics()
+        interface_value.interface_names = {
+          "position_error_rms", "position_error_max",          "velocity_error_rms",
+          "velocity_error_max", "time_outside_path_tolerance", "settle_time"};
+        interface_value.values.resize(interface_value.interface_names.size(), 0.0);
+      }
+      rt_publisher.unlock();
+    }
+
+    if (!group->name.empty())
+    {
+      RCLCPP_INFO(
+        logger, "Joint group '%s' controls %zu joints.", group->name.c_str(), group_dof);
+    }
+    joint_groups_.push_back(std::move(group));
+  }
+
+  map_cmd_to_group_.resize(num_cmd_joints_);
+  for (size_t i = 0; i < num_cmd_joints_; ++i)
+  {
+    map_cmd_to_group_[i] = map_joints_to_group[map_cmd_to_joints_[i]];
+  }
+  return true;
+}
+
+void JointTrajectoryController::configure_command_lookahead()
+{
+  for (auto & group : joint_groups_)
+  {
+    group->command_lookaheads.clear();
+    for (size_t group_index = 0; group_index < group->joint_names.size(); ++group_index)
+    {
+      const auto & lookahead =
+        params_.command_lookahead.joints_map.at(group->joint_names[group_index]);
+      const auto duration = rclcpp::Duration::from_seconds(
+        lookahead.cycles * update_period_.seconds() + lookahead.seconds);
+      if (duration.nanoseconds() == 0)
+      {
+        continue;
+      }
+      auto it = std::find_if(
+        group->command_lookaheads.begin(), group->command_lookaheads.end(),
+        [&duration](const auto & entry) { return entry.duration == duration; });
+      if (it != group->command_lookaheads.end())
+      {
+        it->joint_indices.push_back(group_index);
+      }
+      else
+      {
+        group->command_lookaheads.push_back({duration, {group_index}});
+      }
+      RCLCPP_INFO(
+        get_node()->get_logger(), "Commands of joint '%s' are sampled %.4f s ahead.",
+        group->joint_names[group_index].c_str(), duration.seconds());
+    }
+  }
+}
+
+void JointTrajectoryController::publish_tracking_statistics(
+  JointGroup & group, const rclcpp::Time & time)
+{
+  const auto & statistics = group.tracking_statistics;
+  if (!group.tracking_statistics_rt_publisher || statistics.num_samples() == 0)
+  {
+    return;
+  }
+  auto & rt_publisher = *group.tracking_statistics_rt_publisher;
+  if (rt_publisher.trylock())
+  {
+    rt_publisher.msg_.header.stamp = time;
+    for (size_t i = 0; i < statistics.size(); ++i)
+    {
+      const auto & joint = statistics.joint(i);
+      auto & values = rt_publisher.msg_.interface_values[i].values;
+      values[0] = statistics.position_error_rms(i);
+      values[1] = joint.position_error_max;
+      values[2] = statistics.velocity_error_rms(i);
+      values[3] = joint.velocity_error_max;
+      values[4] = joint.time_outside_path_tolerance;
+      values[5] = joint.settle_time;
+    }
+    rt_publisher.unlockAndPublish();
+  }
+}
+
+void JointTrajectoryController::init_hold_position_msg(JointGroup & group)
 {
-  hold_position_msg_ptr_ = std::make_shared<trajectory_msgs::msg::JointTrajectory>();
-  hold_position_msg_ptr_->header.stamp =
+  const size_t group_dof = group.joint_names.size();
+  group.hold_position_msg_ptr = std::make_shared<trajectory_msgs::msg::JointTrajectory>();
+  group.hold_position_msg_ptr->header.stamp =
     rclcpp::Time(0.0, 0.0, get_node()->get_clock()->get_clock_type());  // start immediately
-  hold_position_msg_ptr_->joint_names = params_.joints;
-  hold_position_msg_ptr_->points.resize(1);  // a trivial msg only
-  hold_position_msg_ptr_->points[0].velocities.clear();
-  hold_position_msg_ptr_->points[0].accelerations.clear();
-  hold_position_msg_ptr_->points[0].effort.clear();
+  group.hold_position_msg_ptr->joint_names = group.joint_names;
+  group.hold_position_msg_ptr->points.resize(1);  // a trivial msg only
+  group.hold_position_msg_ptr->points[0].velocities.clear();
+  group.hold_position_msg_ptr->points[0].accelerations.clear();
+  group.hold_position_msg_ptr->points[0].effort.clear();
   if (has_velocity_command_interface_ || has_acceleration_command_interface_)
   {
     // add velocity, so that trajectory sampling returns velocity points in any case
-    hold_position_msg_ptr_->points[0].velocities.resize(dof_, 0.0);
+    group.hold_position_msg_ptr->points[0].velocities.resize(group_dof, 0.0);
   }
   if (has_acceleration_command_interface_)
   {
     // add velocity, so that trajectory sampling returns acceleration points in any case
-    hold_position_msg_ptr_->points[0].accelerations.resize(dof_, 0.0);
+    group.hold_position_msg_ptr->points[0].accelerations.resize(group_dof, 0.0);
   }
   if (has_effort_command_interface_)
   {
-    hold_position_msg_ptr_->points[0].effort.resize(dof_, 0.0);
+    group.hold_position_msg_ptr->points[0].effort.resize(group_dof, 0.0);
   }
+
+  // the realtime thread reuses this message for holding, it must not allocate then
+  group.rt_hold_msg =
+    std::make_shared<trajectory_msgs::msg::JointTrajectory>(*group.hold_position_msg_ptr);
+  auto & hold_point = group.rt_hold_msg->points[0];
+  hold_point.positions.reserve(group_dof);
+  hold_point.velocities.reserve(group_dof);
+  hold_point.accelerations.reserve(group_dof);
+  hold_point.effort.reserve(group_dof);
+}
+
+void JointTrajectoryController::gather_group_point(
+  const JointGroup & group, const JointTrajectoryPoint & point,
+  JointTrajectoryPoint & group_point) const
+{
+  auto gather = [&group](const std::vector<double> & from, std::vector<double> & to)
+  {
+    // keep fields empty, as they are ignored during interpolation then
+    if (from.empty())
+    {
+      to.clear();
+      return;
+    }
+    to.resize(group.joint_indices.size());
+    for (size_t i = 0; i < group.joint_indices.size(); ++i)
+    {
+      to[i] = from[group.joint_indices[i]];
+    }
+  };
+  gather(point.positions, group_point.positions);
+  gather(point.velocities, group_point.velocities);
+  gather(point.accelerations, group_point.accelerations);
+  gather(point.effort, group_point.effort);
+  group_point.time_from_start = point.time_from_start;
+}
+
+void JointTrajectoryController::scatter_group_point(
+  const JointGroup & group, const JointTrajectoryPoint & group_point,
+  JointTrajectoryPoint & point) const
+{
+  auto scatter = [this, &group](const std::vector<double> & from, std::vector<double> & to)
+  {
+    // no allocation if the point was preallocated in on_configure
+    to.resize(dof_, 0.0);
+    for (size_t i = 0; i < group.joint_indices.size(); ++i)
+    {
+      to[group.joint_indices[i]] = from.empty() ? 0.0 : from[i];
+    }
+  };
+  scatter(group_point.positions, point.positions);
+  scatter(group_point.velocities, point.velocities);
+  scatter(group_point.accelerations, point.accelerations);
+  scatter(group_point.effort, point.effort);
 }
 
 }  // namespace joint_trajectory_controller
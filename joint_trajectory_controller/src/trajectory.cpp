@@ -14,7 +14,11 @@
 
 #include "joint_trajectory_controller/trajectory.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <vector>
 
 #include "angles/angles.h"
 #include "hardware_interface/macros.hpp"
@@ -85,6 +89,9 @@ void Trajectory::update(std::shared_ptr<trajectory_msgs::msg::JointTrajectory> j
   trajectory_start_time_ = static_cast<rclcpp::Time>(joint_trajectory->header.stamp);
   sampled_already_ = false;
   last_sample_idx_ = 0;
+  // unknown until a segment of the new trajectory is sampled
+  has_idle_joints_ = false;
+  active_joints_segment_ = std::numeric_limits<size_t>::max();
 }
 
 bool Trajectory::sample(
@@ -120,7 +127,9 @@ bool Trajectory::sample(
     return false;
   }
 
-  output_state = trajectory_msgs::msg::JointTrajectoryPoint();
+  // all fields are overwritten below, keep the memory of output_state
+  output_state.time_from_start.sec = 0;
+  output_state.time_from_start.nanosec = 0;
   auto & first_point_in_msg = trajectory_msg_->points[0];
   const rclcpp::Time first_point_timestamp =
     trajectory_start_time_ + first_point_in_msg.time_from_start;
@@ -173,7 +182,10 @@ bool Trajectory::sample(
         deduce_from_derivatives(
           point, next_point, state_before_traj_msg_.positions.size(), (t1 - t0).seconds());
 
-        interpolate_between_points(t0, point, t1, next_point, sample_time, output_state);
+        update_active_joints(i, point, next_point);
+        interpolate_between_points(
+          t0, point, t1, next_point, sample_time, output_state,
+          has_idle_joints_ ? &active_joints_ : nullptr);
       }
       start_segment_itr = begin() + static_cast<TrajectoryPointConstIter::difference_type>(i);
       end_segment_itr = begin() + static_cast<TrajectoryPointConstIter::difference_type>(i + 1);
@@ -209,7 +221,8 @@ bool Trajectory::sample(
 void Trajectory::interpolate_between_points(
   const rclcpp::Time & time_a, const trajectory_msgs::msg::JointTrajectoryPoint & state_a,
   const rclcpp::Time & time_b, const trajectory_msgs::msg::JointTrajectoryPoint & state_b,
-  const rclcpp::Time & sample_time, trajectory_msgs::msg::JointTrajectoryPoint & output)
+  const rclcpp::Time & sample_time, trajectory_msgs::msg::JointTrajectoryPoint & output,
+  const std::vector<size_t> * joint_indices)
 {
   rclcpp::Duration duration_so_far = sample_time - time_a;
   rclcpp::Duration duration_btwn_points = time_b - time_a;
@@ -219,6 +232,9 @@ void Trajectory::interpolate_between_points(
   output.velocities.resize(dim, 0.0);
   output.accelerations.resize(dim, 0.0);
   output.effort.resize(dim, 0.0);
+  // index of the k-th interpolated joint
+  const size_t num_interpolated = joint_indices ? joint_indices->size() : dim;
+  auto joint_index = [joint_indices](size_t k) { return joint_indices ? (*joint_indices)[k] : k; };
 
   auto generate_powers = [](int n, double x, double * powers)
   {
@@ -232,6 +248,24 @@ void Trajectory::interpolate_between_points(
   bool has_velocity = !state_a.velocities.empty() && !state_b.velocities.empty();
   bool has_accel = !state_a.accelerations.empty() && !state_b.accelerations.empty();
   bool has_effort = !state_a.effort.empty() && !state_b.effort.empty();
+
+  // output may contain values of a previous sample
+  std::fill(output.accelerations.begin(), output.accelerations.end(), 0.0);
+  if (!has_effort)
+  {
+    std::fill(output.effort.begin(), output.effort.end(), 0.0);
+  }
+  if (joint_indices)
+  {
+    // joints which are not interpolated stand still at their position
+    std::copy(state_a.positions.begin(), state_a.positions.end(), output.positions.begin());
+    std::fill(output.velocities.begin(), output.velocities.end(), 0.0);
+    if (has_effort)
+    {
+      std::copy(state_a.effort.begin(), state_a.effort.end(), output.effort.begin());
+    }
+  }
+
   if (duration_so_far.seconds() < 0.0)
   {
     duration_so_far = rclcpp::Duration::from_seconds(0.0);
@@ -249,8 +283,9 @@ void Trajectory::interpolate_between_points(
   if (has_effort)
   {
     // do linear interpolation
-    for (size_t i = 0; i < dim; ++i)
+    for (size_t k = 0; k < num_interpolated; ++k)
     {
+      const size_t i = joint_index(k);
       double start_effort = state_a.effort[i];
       double end_effort = state_b.effort[i];
 
@@ -268,8 +303,9 @@ void Trajectory::interpolate_between_points(
   if (!has_velocity && !has_accel)
   {
     // do linear interpolation
-    for (size_t i = 0; i < dim; ++i)
+    for (size_t k = 0; k < num_interpolated; ++k)
     {
+      const size_t i = joint_index(k);
       double start_pos = state_a.positions[i];
       double end_pos = state_b.positions[i];
 
@@ -290,8 +326,9 @@ void Trajectory::interpolate_between_points(
     double T[4];
     generate_powers(3, duration_btwn_points.seconds(), T);
 
-    for (size_t i = 0; i < dim; ++i)
+    for (size_t k = 0; k < num_interpolated; ++k)
     {
+      const size_t i = joint_index(k);
       double start_pos = state_a.positions[i];
       double start_vel = state_a.velocities[i];
       double end_pos = state_b.positions[i];
@@ -321,8 +358,9 @@ void Trajectory::interpolate_between_points(
     double T[6];
     generate_powers(5, duration_btwn_points.seconds(), T);
 
-    for (size_t i = 0; i < dim; ++i)
+    for (size_t k = 0; k < num_interpolated; ++k)
     {
+      const size_t i = joint_index(k);
       double start_pos = state_a.positions[i];
       double start_vel = state_a.velocities[i];
       double start_acc = state_a.accelerations[i];
@@ -359,6 +397,49 @@ void Trajectory::interpolate_between_points(
   }
 }
 
+void Trajectory::update_active_joints(
+  const size_t segment_index, const trajectory_msgs::msg::JointTrajectoryPoint & point_a,
+  const trajectory_msgs::msg::JointTrajectoryPoint & point_b)
+{
+  if (segment_index == active_joints_segment_)
+  {
+    return;
+  }
+  active_joints_segment_ = segment_index;
+  has_idle_joints_ = false;
+  active_joints_.clear();
+
+  const size_t dim = point_a.positions.size();
+  if (point_b.positions.size() != dim)
+  {
+    // the positions could not be deduced from the derivatives, interpolate all joints
+    return;
+  }
+  auto value = [](const std::vector<double> & values, size_t i)
+  { return i < values.size() ? values[i] : 0.0; };
+  auto is_small = [](double value) { return std::abs(value) <= IDLE_JOINT_TOLERANCE; };
+  // a joint is idle if it stands still at the same position at both ends of the segment. Its
+  // interpolation yields this position then, up to the tolerance.
+  auto is_idle = [&](size_t i)
+  {
+    return is_small(point_b.positions[i] - point_a.positions[i]) &&
+           is_small(value(point_a.velocities, i)) && is_small(value(point_b.velocities, i)) &&
+           is_small(value(point_a.accelerations, i)) &&
+           is_small(value(point_b.accelerations, i)) &&
+           is_small(value(point_b.effort, i) - value(point_a.effort, i));
+  };
+
+  active_joints_.reserve(dim);
+  for (size_t i = 0; i < dim; ++i)
+  {
+    if (!is_idle(i))
+    {
+      active_joints_.push_back(i);
+    }
+  }
+  has_idle_joints_ = active_joints_.size() < dim;
+}
+
 void Trajectory::deduce_from_derivatives(
   trajectory_msgs::msg::JointTrajectoryPoint & first_state,
   trajectory_msgs::msg::JointTrajectoryPoint & second_state, const size_t dim, const double delta_t)
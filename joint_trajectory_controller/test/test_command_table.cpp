@@ -0,0 +1,224 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "joint_trajectory_controller/command_table.hpp"
+#include "joint_trajectory_controller/trajectory.hpp"
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+
+using joint_trajectory_controller::CommandTable;
+using namespace joint_trajectory_controller::interpolation_methods;  // NOLINT
+using namespace std::chrono_literals;
+
+namespace
+{
+// Floating-point value comparison threshold
+const double EPS = 1e-8;
+
+std::shared_ptr<trajectory_msgs::msg::JointTrajectory> create_trajectory_msg()
+{
+  auto msg = std::make_shared<trajectory_msgs::msg::JointTrajectory>();
+  msg->header.stamp = rclcpp::Time(0);
+  msg->joint_names = {"joint1", "joint2"};
+  trajectory_msgs::msg::JointTrajectoryPoint p1;
+  p1.positions = {1.0, 2.0};
+  p1.velocities = {0.5, 0.0};
+  p1.time_from_start = rclcpp::Duration::from_seconds(0.3);
+  trajectory_msgs::msg::JointTrajectoryPoint p2;
+  p2.positions = {2.0, -1.0};
+  p2.velocities = {0.0, 0.0};
+  p2.time_from_start = rclcpp::Duration::from_seconds(0.55);
+  msg->points = {p1, p2};
+  return msg;
+}
+
+// the worker may just hold the lock when starting, request() never blocks then
+bool request_until_accepted(
+  CommandTable & table, const trajectory_msgs::msg::JointTrajectory & msg,
+  const trajectory_msgs::msg::JointTrajectoryPoint & point_before, const rclcpp::Time & start_time,
+  const rclcpp::Duration & period)
+{
+  // the worker samples its own copy of the trajectory
+  auto copy = std::make_shared<trajectory_msgs::msg::JointTrajectory>(msg);
+  for (int i = 0; i < 100; ++i)
+  {
+    if (table.request(
+          copy, start_time, point_before, {}, start_time, period, DEFAULT_INTERPOLATION))
+    {
+      return true;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return false;
+}
+
+// waits until the samples around sample_time are computed by the worker thread
+bool wait_for_sample(
+  const CommandTable & table, const rclcpp::Time & sample_time,
+  trajectory_msgs::msg::JointTrajectoryPoint & point, size_t & start_index, size_t & end_index)
+{
+  for (int i = 0; i < 1000; ++i)
+  {
+    if (table.sample(sample_time, point, start_index, end_index))
+    {
+      return true;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return false;
+}
+
+bool wait_for_sample(const CommandTable & table, const rclcpp::Time & sample_time)
+{
+  trajectory_msgs::msg::JointTrajectoryPoint point;
+  size_t start_index, end_index;
+  return wait_for_sample(table, sample_time, point, start_index, end_index);
+}
+}  // namespace
+
+TEST(TestCommandTable, samples_equal_trajectory_samples)
+{
+  auto msg = create_trajectory_msg();
+  const rclcpp::Time start_time(10, 0, RCL_STEADY_TIME);
+  const auto period = rclcpp::Duration::from_seconds(0.01);
+  trajectory_msgs::msg::JointTrajectoryPoint point_before;
+  point_before.positions = {0.0, 0.0};
+  point_before.velocities = {0.0, 0.0};
+
+  CommandTable table(1000, 2);
+  ASSERT_TRUE(request_until_accepted(table, *msg, point_before, start_time, period));
+
+  joint_trajectory_controller::Trajectory trajectory(msg);
+  trajectory.set_point_before_trajectory_msg(start_time, point_before);
+  trajectory_msgs::msg::JointTrajectoryPoint expected, point;
+  joint_trajectory_controller::TrajectoryPointConstIter start, end;
+  size_t start_index, end_index;
+  // sample beyond the end of the trajectory
+  for (int64_t cycle = 0; cycle < 70; ++cycle)
+  {
+    const auto sample_time =
+      start_time + rclcpp::Duration::from_nanoseconds(period.nanoseconds() * cycle);
+    ASSERT_TRUE(trajectory.sample(sample_time, DEFAULT_INTERPOLATION, expected, start, end));
+
+    ASSERT_TRUE(wait_for_sample(table, sample_time, point, start_index, end_index))
+      << "cycle " << cycle;
+    EXPECT_EQ(static_cast<size_t>(std::distance(trajectory.begin(), start)), start_index);
+    EXPECT_EQ(static_cast<size_t>(std::distance(trajectory.begin(), end)), end_index);
+    ASSERT_EQ(expected.positions.size(), point.positions.size());
+    ASSERT_EQ(expected.velocities.size(), point.velocities.size());
+    for (size_t i = 0; i < expected.positions.size(); ++i)
+    {
+      EXPECT_NEAR(expected.positions[i], point.positions[i], EPS);
+      EXPECT_NEAR(expected.velocities[i], point.velocities[i], EPS);
+    }
+  }
+  // the samples after the end of the trajectory are only returned if the table is complete
+  EXPECT_TRUE(table.is_complete());
+}
+
+TEST(TestCommandTable, samples_off_grid_are_interpolated)
+{
+  auto msg = create_trajectory_msg();
+  const rclcpp::Time start_time(10, 0, RCL_STEADY_TIME);
+  const auto period = rclcpp::Duration::from_seconds(0.001);
+  trajectory_msgs::msg::JointTrajectoryPoint point_before;
+  point_before.positions = {0.0, 0.0};
+  point_before.velocities = {0.0, 0.0};
+
+  CommandTable table(1000, 2);
+  ASSERT_TRUE(request_until_accepted(table, *msg, point_before, start_time, period));
+
+  joint_trajectory_controller::Trajectory trajectory(msg);
+  trajectory.set_point_before_trajectory_msg(start_time, point_before);
+  trajectory_msgs::msg::JointTrajectoryPoint expected, point;
+  joint_trajectory_controller::TrajectoryPointConstIter start, end;
+  size_t start_index, end_index;
+  // the trajectory starts at its first sample, as the header stamp is zero
+  ASSERT_TRUE(trajectory.sample(start_time, DEFAULT_INTERPOLATION, expected, start, end));
+  // e.g., with a jittering update period or a speed scaling factor
+  for (const double offset : {0.0004, 0.1237, 0.4002, 0.5486})
+  {
+    const auto sample_time = start_time + rclcpp::Duration::from_seconds(offset);
+    ASSERT_TRUE(trajectory.sample(sample_time, DEFAULT_INTERPOLATION, expected, start, end));
+    ASSERT_TRUE(wait_for_sample(table, sample_time, point, start_index, end_index))
+      << "offset " << offset;
+    EXPECT_EQ(static_cast<size_t>(std::distance(trajectory.begin(), start)), start_index);
+    EXPECT_EQ(static_cast<size_t>(std::distance(trajectory.begin(), end)), end_index);
+    for (size_t i = 0; i < expected.positions.size(); ++i)
+    {
+      // error of the linear interpolation within one period
+      EXPECT_NEAR(expected.positions[i], point.positions[i], 1e-4);
+      EXPECT_NEAR(expected.velocities[i], point.velocities[i], 1e-1);
+    }
+  }
+
+  EXPECT_FALSE(table.sample(start_time - period, point, start_index, end_index));
+}
+
+TEST(TestCommandTable, limited_capacity)
+{
+  auto msg = create_trajectory_msg();
+  const rclcpp::Time start_time(10, 0, RCL_STEADY_TIME);
+  const auto period = rclcpp::Duration::from_seconds(0.01);
+  trajectory_msgs::msg::JointTrajectoryPoint point_before;
+  point_before.positions = {0.0, 0.0};
+
+  // the trajectory takes 55 cycles
+  CommandTable table(10, 2);
+  ASSERT_TRUE(request_until_accepted(table, *msg, point_before, start_time, period));
+  ASSERT_TRUE(wait_for_sample(table, start_time + period * 9.0));
+  trajectory_msgs::msg::JointTrajectoryPoint point;
+  size_t start_index, end_index;
+  EXPECT_FALSE(table.sample(start_time + period * 9.5, point, start_index, end_index));
+  EXPECT_FALSE(table.sample(start_time + period * 10.0, point, start_index, end_index));
+  EXPECT_FALSE(table.is_complete());
+}
+
+TEST(TestCommandTable, new_request_invalidates_samples)
+{
+  auto msg = create_trajectory_msg();
+  const rclcpp::Time start_time(10, 0, RCL_STEADY_TIME);
+  const auto period = rclcpp::Duration::from_seconds(0.01);
+  trajectory_msgs::msg::JointTrajectoryPoint point_before;
+  point_before.positions = {0.0, 0.0};
+
+  CommandTable table(1000, 2);
+  ASSERT_TRUE(request_until_accepted(table, *msg, point_before, start_time, period));
+  ASSERT_TRUE(wait_for_sample(table, start_time));
+
+  // the new trajectory ends at the current position
+  msg->points.resize(1);
+  msg->points[0].positions = {0.0, 0.0};
+  msg->points[0].velocities = {0.0, 0.0};
+  const auto new_start_time = start_time + rclcpp::Duration::from_seconds(0.005);
+  ASSERT_TRUE(request_until_accepted(table, *msg, point_before, new_start_time, period));
+  trajectory_msgs::msg::JointTrajectoryPoint point;
+  size_t start_index, end_index;
+  // the samples of the first trajectory at start_time are not returned anymore
+  EXPECT_FALSE(table.sample(start_time, point, start_index, end_index));
+
+  ASSERT_TRUE(
+    wait_for_sample(table, new_start_time + period * 40.0, point, start_index, end_index));
+  EXPECT_NEAR(0.0, point.positions[0], EPS);
+  EXPECT_NEAR(0.0, point.positions[1], EPS);
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+
+#include "joint_trajectory_controller/tracking_statistics.hpp"
+
+using joint_trajectory_controller::TrackingStatistics;
+
+namespace
+{
+// Floating-point value comparison threshold
+const double EPS = 1e-8;
+}  // namespace
+
+TEST(TestTrackingStatistics, rms_and_max_error)
+{
+  TrackingStatistics statistics(2);
+  const double period = 0.01;
+
+  statistics.add_error(0, 1.0, 0.5, false, period);
+  statistics.add_error(1, 0.0, 0.0, false, period);
+  statistics.finish_cycle();
+  statistics.add_error(0, -3.0, 0.5, true, period);
+  statistics.add_error(1, 0.0, 0.0, false, period);
+  statistics.finish_cycle();
+
+  EXPECT_EQ(2u, statistics.num_samples());
+  EXPECT_NEAR(std::sqrt(5.0), statistics.position_error_rms(0), EPS);
+  EXPECT_NEAR(3.0, statistics.joint(0).position_error_max, EPS);
+  EXPECT_NEAR(0.5, statistics.velocity_error_rms(0), EPS);
+  EXPECT_NEAR(0.5, statistics.joint(0).velocity_error_max, EPS);
+  EXPECT_NEAR(period, statistics.joint(0).time_outside_path_tolerance, EPS);
+
+  EXPECT_NEAR(0.0, statistics.position_error_rms(1), EPS);
+  EXPECT_NEAR(0.0, statistics.joint(1).time_outside_path_tolerance, EPS);
+}
+
+TEST(TestTrackingStatistics, settle_time)
+{
+  TrackingStatistics statistics(1);
+  EXPECT_TRUE(std::isnan(statistics.joint(0).settle_time));
+
+  statistics.add_goal_check(0, false, 0.0);
+  statistics.add_goal_check(0, true, 0.1);
+  EXPECT_NEAR(0.1, statistics.joint(0).settle_time, EPS);
+  // leaving the goal tolerance again restarts settling
+  statistics.add_goal_check(0, false, 0.2);
+  EXPECT_TRUE(std::isnan(statistics.joint(0).settle_time));
+  statistics.add_goal_check(0, true, 0.3);
+  statistics.add_goal_check(0, true, 0.4);
+  EXPECT_NEAR(0.3, statistics.joint(0).settle_time, EPS);
+}
+
+TEST(TestTrackingStatistics, reset)
+{
+  TrackingStatistics statistics(1);
+  statistics.add_error(0, 1.0, 1.0, true, 0.01);
+  statistics.add_goal_check(0, true, 0.1);
+  statistics.finish_cycle();
+
+  statistics.reset();
+  EXPECT_EQ(1u, statistics.size());
+  EXPECT_EQ(0u, statistics.num_samples());
+  EXPECT_NEAR(0.0, statistics.position_error_rms(0), EPS);
+  EXPECT_NEAR(0.0, statistics.joint(0).position_error_max, EPS);
+  EXPECT_NEAR(0.0, statistics.joint(0).time_outside_path_tolerance, EPS);
+  EXPECT_TRUE(std::isnan(statistics.joint(0).settle_time));
+}
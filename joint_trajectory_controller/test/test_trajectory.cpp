@@ -934,6 +934,114 @@ TEST(TestTrajectory, update_trajectory)
   }
 }
 
+TEST(TestTrajectory, sample_trajectory_with_idle_joints)
+{
+  // large system where only a few joints move in each segment
+  const size_t dof = 120;
+  const std::vector<size_t> moving_first = {3, 17, 29, 44};
+  const std::vector<size_t> moving_second = {58, 71, 96, 119};
+
+  // the trajectory starts when the point before it is set
+  const rclcpp::Time time_now(1, 0);
+  auto msg = std::make_shared<trajectory_msgs::msg::JointTrajectory>();
+  msg->header.stamp = time_now;
+  // the measured state is noisy, all joints are interpolated in the segment starting there
+  trajectory_msgs::msg::JointTrajectoryPoint point_before_msg;
+  point_before_msg.positions.resize(dof);
+  point_before_msg.velocities.resize(dof);
+  for (size_t i = 0; i < dof; ++i)
+  {
+    point_before_msg.positions[i] = 0.01 * static_cast<double>(i) + 1e-4;
+    point_before_msg.velocities[i] = i % 2 ? 1e-3 : -1e-3;
+  }
+  // the first segment moves the first joints, the second segment the other joints and in the
+  // last segment all joints stand still. Idle positions differ by rounding errors.
+  for (size_t k = 0; k < 4; ++k)
+  {
+    trajectory_msgs::msg::JointTrajectoryPoint point;
+    point.time_from_start = rclcpp::Duration::from_seconds(0.5 * static_cast<double>(k + 1));
+    point.velocities.resize(dof, 0.0);
+    for (size_t i = 0; i < dof; ++i)
+    {
+      point.positions.push_back(0.01 * static_cast<double>(i) + (k % 2 ? 1e-12 : 0.0));
+    }
+    for (const auto i : moving_first)
+    {
+      point.positions[i] += k >= 1 ? 0.3 : 0.0;
+    }
+    for (const auto i : moving_second)
+    {
+      point.positions[i] += k >= 2 ? 0.3 : 0.0;
+    }
+    msg->points.push_back(point);
+  }
+
+  auto traj = joint_trajectory_controller::Trajectory(msg);
+  traj.set_point_before_trajectory_msg(time_now, point_before_msg);
+
+  trajectory_msgs::msg::JointTrajectoryPoint sparse_state;
+  trajectory_msgs::msg::JointTrajectoryPoint dense_state;
+  joint_trajectory_controller::TrajectoryPointConstIter start, end;
+  auto sample_and_compare = [&](const double t)
+  {
+    const auto sample_time = time_now + rclcpp::Duration::from_seconds(t);
+    ASSERT_TRUE(traj.sample(sample_time, DEFAULT_INTERPOLATION, sparse_state, start, end));
+
+    // interpolate all joints of the same segment
+    const rclcpp::Time end_time = time_now + end->time_from_start;
+    if (start == end)
+    {
+      traj.interpolate_between_points(
+        time_now, point_before_msg, end_time, *end, sample_time, dense_state);
+    }
+    else
+    {
+      traj.interpolate_between_points(
+        time_now + start->time_from_start, *start, end_time, *end, sample_time, dense_state);
+    }
+    ASSERT_EQ(dof, sparse_state.positions.size());
+    for (size_t i = 0; i < dof; ++i)
+    {
+      EXPECT_NEAR(dense_state.positions[i], sparse_state.positions[i], EPS);
+      EXPECT_NEAR(dense_state.velocities[i], sparse_state.velocities[i], EPS);
+      EXPECT_NEAR(dense_state.accelerations[i], sparse_state.accelerations[i], EPS);
+    }
+  };
+
+  for (double t = 0.05; t < 0.5; t += 0.1)
+  {
+    sample_and_compare(t);
+  }
+  EXPECT_FALSE(traj.has_idle_joints());
+
+  for (double t = 0.55; t < 1.0; t += 0.1)
+  {
+    sample_and_compare(t);
+    ASSERT_TRUE(traj.has_idle_joints());
+    EXPECT_EQ(moving_first, traj.active_joints());
+  }
+  for (double t = 1.05; t < 1.5; t += 0.1)
+  {
+    sample_and_compare(t);
+    ASSERT_TRUE(traj.has_idle_joints());
+    EXPECT_EQ(moving_second, traj.active_joints());
+  }
+  for (double t = 1.55; t < 2.0; t += 0.1)
+  {
+    sample_and_compare(t);
+    ASSERT_TRUE(traj.has_idle_joints());
+    EXPECT_TRUE(traj.active_joints().empty());
+  }
+
+  // a joint moving farther than the tolerance is interpolated
+  msg->points[3].positions[0] +=
+    10.0 * joint_trajectory_controller::Trajectory::IDLE_JOINT_TOLERANCE;
+  traj.update(msg);
+  traj.set_point_before_trajectory_msg(time_now, point_before_msg);
+  sample_and_compare(1.75);
+  EXPECT_EQ(std::vector<size_t>{0}, traj.active_joints());
+}
+
 TEST(TestWrapAroundJoint, no_wraparound)
 {
   const std::vector<double> initial_position(3, 0.);
@@ -16,15 +16,18 @@
 #include <cxxabi.h>
 #endif
 #include <chrono>
+#include <cmath>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "control_msgs/action/detail/follow_joint_trajectory__struct.hpp"
+#include "control_msgs/msg/dynamic_joint_state.hpp"
 #include "controller_interface/controller_interface.hpp"
 #include "hardware_interface/resource_manager.hpp"
 #include "rclcpp/clock.hpp"
@@ -444,6 +447,135 @@ TEST_F(TestTrajectoryActions, test_goal_tolerances_single_point_success)
   // i.e., active but trivial trajectory (one point only)
   expectCommandPoint(points_positions.at(0));
 }
+
+TEST_F(TestTrajectoryActions, test_tracking_statistics_published_per_goal)
+{
+  std::vector<rclcpp::Parameter> params = {
+    rclcpp::Parameter("publish_tracking_statistics", true),
+    rclcpp::Parameter("constraints.joint1.goal", 0.1),
+    rclcpp::Parameter("constraints.joint2.goal", 0.1),
+    rclcpp::Parameter("constraints.joint3.goal", 0.1)};
+
+  std::mutex statistics_mutex;
+  std::shared_ptr<control_msgs::msg::DynamicJointState> statistics_msg;
+  auto statistics_subscriber = node_->create_subscription<control_msgs::msg::DynamicJointState>(
+    controller_name_ + "/tracking_statistics", rclcpp::SystemDefaultsQoS(),
+    [&](const std::shared_ptr<control_msgs::msg::DynamicJointState> msg)
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex);
+      statistics_msg = msg;
+    });
+
+  SetUpExecutor(params);
+  SetUpControllerHardware();
+
+  std::shared_future<typename GoalHandle::SharedPtr> gh_future;
+  {
+    std::vector<JointTrajectoryPoint> points;
+    JointTrajectoryPoint point;
+    point.time_from_start = rclcpp::Duration::from_seconds(0.5);
+    point.positions = {1.0, 2.0, 3.0};
+    points.push_back(point);
+
+    gh_future = sendActionGoal(points, 1.0, goal_options_);
+  }
+  controller_hw_thread_.join();
+
+  EXPECT_TRUE(gh_future.get());
+  EXPECT_EQ(rclcpp_action::ResultCode::SUCCEEDED, common_resultcode_);
+
+  // published once when the goal succeeded
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex);
+      if (statistics_msg)
+      {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::lock_guard<std::mutex> lock(statistics_mutex);
+  ASSERT_TRUE(statistics_msg);
+  ASSERT_EQ(joint_names_, statistics_msg->joint_names);
+  ASSERT_EQ(joint_names_.size(), statistics_msg->interface_values.size());
+  for (const auto & interface_value : statistics_msg->interface_values)
+  {
+    ASSERT_EQ(6u, interface_value.values.size());
+    const double position_error_rms = interface_value.values[0];
+    const double position_error_max = interface_value.values[1];
+    EXPECT_GE(position_error_rms, 0.0);
+    EXPECT_LE(position_error_rms, position_error_max);
+    // the goal is reached, no path tolerance is set
+    EXPECT_DOUBLE_EQ(0.0, interface_value.values[4]);
+    EXPECT_FALSE(std::isnan(interface_value.values[5]));
+    EXPECT_GE(interface_value.values[5], 0.0);
+  }
+}
+
+TEST_F(TestTrajectoryActions, test_tracking_statistics_without_velocity_state)
+{
+  // the velocity error is not known without a velocity state interface
+  state_interface_types_ = {"position"};
+  std::vector<rclcpp::Parameter> params = {
+    rclcpp::Parameter("publish_tracking_statistics", true),
+    rclcpp::Parameter("constraints.joint1.goal", 0.1),
+    rclcpp::Parameter("constraints.joint2.goal", 0.1),
+    rclcpp::Parameter("constraints.joint3.goal", 0.1)};
+
+  std::mutex statistics_mutex;
+  std::shared_ptr<control_msgs::msg::DynamicJointState> statistics_msg;
+  auto statistics_subscriber = node_->create_subscription<control_msgs::msg::DynamicJointState>(
+    controller_name_ + "/tracking_statistics", rclcpp::SystemDefaultsQoS(),
+    [&](const std::shared_ptr<control_msgs::msg::DynamicJointState> msg)
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex);
+      statistics_msg = msg;
+    });
+
+  SetUpExecutor(params);
+  SetUpControllerHardware();
+
+  std::shared_future<typename GoalHandle::SharedPtr> gh_future;
+  {
+    std::vector<JointTrajectoryPoint> points;
+    JointTrajectoryPoint point;
+    point.time_from_start = rclcpp::Duration::from_seconds(0.5);
+    point.positions = {1.0, 2.0, 3.0};
+    points.push_back(point);
+
+    gh_future = sendActionGoal(points, 1.0, goal_options_);
+  }
+  controller_hw_thread_.join();
+
+  EXPECT_TRUE(gh_future.get());
+  EXPECT_EQ(rclcpp_action::ResultCode::SUCCEEDED, common_resultcode_);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex);
+      if (statistics_msg)
+      {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::lock_guard<std::mutex> lock(statistics_mutex);
+  ASSERT_TRUE(statistics_msg);
+  ASSERT_EQ(joint_names_.size(), statistics_msg->interface_values.size());
+  for (const auto & interface_value : statistics_msg->interface_values)
+  {
+    ASSERT_EQ(6u, interface_value.values.size());
+    EXPECT_LE(interface_value.values[0], interface_value.values[1]);
+    // velocity error RMS and maximum
+    EXPECT_DOUBLE_EQ(0.0, interface_value.values[2]);
+    EXPECT_DOUBLE_EQ(0.0, interface_value.values[3]);
+  }
+}
+
 /**
  * Makes sense with position command interface only,
  * because no integration to position state interface is implemented
@@ -2451,6 +2451,43 @@ TEST_P(TrajectoryControllerTestParameterized, test_state_tolerances_fail)
   expectCommandPoint(joint_state_pos_);
 }
 
+TEST_P(TrajectoryControllerTestParameterized, test_state_tolerances_fail_holds_in_same_cycle)
+{
+  // set joint tolerance parameters
+  const double state_tol = 0.0001;
+  std::vector<rclcpp::Parameter> params = {
+    rclcpp::Parameter("constraints.joint1.trajectory", state_tol),
+    rclcpp::Parameter("constraints.joint2.trajectory", state_tol),
+    rclcpp::Parameter("constraints.joint3.trajectory", state_tol)};
+
+  rclcpp::executors::MultiThreadedExecutor executor;
+  double kp = 1.0;  // activate feedback control for testing velocity/effort PID
+  SetUpAndActivateTrajectoryController(executor, params, true, kp);
+
+  // send msg
+  constexpr auto FIRST_POINT_TIME = std::chrono::milliseconds(100);
+  builtin_interfaces::msg::Duration time_from_start{rclcpp::Duration(FIRST_POINT_TIME)};
+  // *INDENT-OFF*
+  std::vector<std::vector<double>> points{
+    {{3.3, 4.4, 5.5}}, {{7.7, 8.8, 9.9}}, {{10.10, 11.11, 12.12}}};
+  // *INDENT-ON*
+  publish(time_from_start, points, rclcpp::Time(0, 0, RCL_STEADY_TIME));
+  traj_controller_->wait_for_trajectory(executor);
+
+  const auto period = rclcpp::Duration::from_seconds(0.01);
+  auto time = rclcpp::Clock(RCL_STEADY_TIME).now();
+  // the trajectory starts at the current state
+  traj_controller_->update(time, period);
+  EXPECT_TRUE(traj_controller_->has_nontrivial_traj());
+
+  // the state does not follow the commands, the violation is detected in the next cycle
+  time += period;
+  traj_controller_->update(time, period);
+
+  // the hold position is commanded in the same cycle
+  expectCommandPoint(joint_state_pos_);
+}
+
 TEST_P(TrajectoryControllerTestParameterized, test_goal_tolerances_fail)
 {
   // set joint tolerance parameters
@@ -2839,3 +2876,242 @@ TEST_F(TrajectoryControllerTest, activate_with_scaling_interfaces)
 
   executor.cancel();
 }
+
+TEST_F(TrajectoryControllerTest, command_table_matches_live_sampling)
+{
+  const std::vector<double> points_positions = {1.5, 2.5, 3.5};
+  std::vector<std::vector<double>> commands;
+  for (const bool enable : {false, true})
+  {
+    rclcpp::executors::SingleThreadedExecutor executor;
+    std::vector<rclcpp::Parameter> params = {
+      rclcpp::Parameter("command_table.enable", enable),
+    };
+    SetUpAndActivateTrajectoryController(executor, params);
+
+    trajectory_msgs::msg::JointTrajectory traj_msg;
+    traj_msg.joint_names = joint_names_;
+    traj_msg.header.stamp = rclcpp::Time(0);
+    traj_msg.points.resize(1);
+    traj_msg.points[0].time_from_start = rclcpp::Duration::from_seconds(0.5);
+    traj_msg.points[0].positions = points_positions;
+    traj_msg.points[0].velocities = {0.0, 0.0, 0.0};
+    trajectory_publisher_->publish(traj_msg);
+    traj_controller_->wait_for_trajectory(executor);
+
+    // the first cycles hand the trajectory over to the worker thread
+    auto end_time = updateControllerAsync(rclcpp::Duration::from_seconds(0.01));
+    ASSERT_EQ(traj_controller_->wait_for_command_table(), enable);
+    for (int i = 0; i < 10; ++i)
+    {
+      end_time = updateControllerAsync(rclcpp::Duration::from_seconds(0.05), end_time);
+      commands.push_back(joint_pos_);
+    }
+    if (enable)
+    {
+      EXPECT_GT(traj_controller_->get_command_table_cycles(), 0u);
+    }
+    else
+    {
+      EXPECT_EQ(traj_controller_->get_command_table_cycles(), 0u);
+    }
+    for (size_t i = 0; i < joint_names_.size(); ++i)
+    {
+      EXPECT_NEAR(points_positions[i], joint_pos_[i], COMMON_THRESHOLD);
+    }
+
+    executor.cancel();
+    DeactivateTrajectoryController();
+  }
+
+  // the precomputed commands are equal to the ones sampled in the update loop
+  ASSERT_EQ(commands.size(), 20u);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    for (size_t j = 0; j < joint_names_.size(); ++j)
+    {
+      EXPECT_NEAR(commands[i][j], commands[i + 10][j], COMMON_THRESHOLD);
+    }
+  }
+}
+
+TEST_F(TrajectoryControllerTest, command_lookahead_samples_commands_ahead)
+{
+  rclcpp::executors::SingleThreadedExecutor executor;
+  // joint1 has 3 cycles of actuator latency, controller runs at 100 Hz
+  std::vector<rclcpp::Parameter> params = {
+    rclcpp::Parameter("command_lookahead.joint1.cycles", 2.0),
+    rclcpp::Parameter("command_lookahead.joint1.seconds", 0.01),
+  };
+  SetUpAndActivateTrajectoryController(executor, params);
+
+  // all joints move with the same constant velocity
+  trajectory_msgs::msg::JointTrajectory traj_msg;
+  traj_msg.joint_names = joint_names_;
+  traj_msg.header.stamp = rclcpp::Time(0);
+  traj_msg.points.resize(1);
+  traj_msg.points[0].time_from_start = rclcpp::Duration::from_seconds(1.0);
+  traj_msg.points[0].positions = {
+    INITIAL_POS_JOINT1 + 1.0, INITIAL_POS_JOINT2 + 1.0, INITIAL_POS_JOINT3 + 1.0};
+  trajectory_publisher_->publish(traj_msg);
+  traj_controller_->wait_for_trajectory(executor);
+
+  updateControllerAsync(rclcpp::Duration::from_seconds(0.2));
+
+  // commands of joint1 are 3 cycles ahead of the ones of joint2
+  const double velocity = 1.0;
+  EXPECT_NEAR(
+    joint_pos_[0] - INITIAL_POS_JOINT1, joint_pos_[1] - INITIAL_POS_JOINT2 + 0.03 * velocity,
+    COMMON_THRESHOLD);
+  EXPECT_NEAR(
+    joint_pos_[1] - INITIAL_POS_JOINT2, joint_pos_[2] - INITIAL_POS_JOINT3, COMMON_THRESHOLD);
+  // the desired state used for tolerances is not shifted
+  const auto state_reference = traj_controller_->get_state_reference();
+  EXPECT_NEAR(
+    state_reference.positions[0] - INITIAL_POS_JOINT1,
+    state_reference.positions[1] - INITIAL_POS_JOINT2, COMMON_THRESHOLD);
+
+  executor.cancel();
+}
+
+TEST_F(TrajectoryControllerTest, joint_groups_execute_independent_trajectories)
+{
+  rclcpp::executors::SingleThreadedExecutor executor;
+  std::vector<rclcpp::Parameter> params = {
+    rclcpp::Parameter("joint_groups", std::vector<std::string>{"arm", "wrist"}),
+    rclcpp::Parameter("groups.arm.joints", std::vector<std::string>{"joint1", "joint2"}),
+    rclcpp::Parameter("groups.wrist.joints", std::vector<std::string>{"joint3"}),
+  };
+  SetUpAndActivateTrajectoryController(executor, params);
+  ASSERT_EQ(traj_controller_->get_lifecycle_state().id(), State::PRIMARY_STATE_ACTIVE);
+
+  auto arm_publisher = node_->create_publisher<trajectory_msgs::msg::JointTrajectory>(
+    controller_name_ + "/arm/joint_trajectory", rclcpp::SystemDefaultsQoS());
+  auto wrist_publisher = node_->create_publisher<trajectory_msgs::msg::JointTrajectory>(
+    controller_name_ + "/wrist/joint_trajectory", rclcpp::SystemDefaultsQoS());
+
+  const double initial_joint3_cmd = joint_pos_[2];
+
+  trajectory_msgs::msg::JointTrajectory arm_msg;
+  arm_msg.joint_names = {"joint1", "joint2"};
+  arm_msg.header.stamp = rclcpp::Time(0);
+  arm_msg.points.resize(1);
+  arm_msg.points[0].time_from_start = rclcpp::Duration::from_seconds(0.5);
+  arm_msg.points[0].positions = {1.5, 2.5};
+  arm_publisher->publish(arm_msg);
+  traj_controller_->wait_for_trajectory(executor);
+
+  auto end_time = updateControllerAsync(rclcpp::Duration::from_seconds(0.2));
+  // the wrist group holds its position while the arm group is moving
+  EXPECT_NEAR(initial_joint3_cmd, joint_pos_[2], COMMON_THRESHOLD);
+  EXPECT_GT(std::abs(joint_pos_[0] - INITIAL_POS_JOINTS[0]), COMMON_THRESHOLD);
+
+  // a trajectory of the wrist group does not replace the one of the arm group
+  trajectory_msgs::msg::JointTrajectory wrist_msg;
+  wrist_msg.joint_names = {"joint3"};
+  wrist_msg.header.stamp = rclcpp::Time(0);
+  wrist_msg.points.resize(1);
+  wrist_msg.points[0].time_from_start = rclcpp::Duration::from_seconds(0.3);
+  wrist_msg.points[0].positions = {3.5};
+  wrist_publisher->publish(wrist_msg);
+  traj_controller_->wait_for_trajectory(executor);
+
+  updateControllerAsync(rclcpp::Duration::from_seconds(0.5), end_time);
+  EXPECT_NEAR(1.5, joint_pos_[0], COMMON_THRESHOLD);
+  EXPECT_NEAR(2.5, joint_pos_[1], COMMON_THRESHOLD);
+  EXPECT_NEAR(3.5, joint_pos_[2], COMMON_THRESHOLD);
+
+  executor.cancel();
+}
+
+TEST_F(TrajectoryControllerTest, joint_groups_have_to_cover_all_joints)
+{
+  rclcpp::executors::SingleThreadedExecutor executor;
+  // joint3 is not part of any group
+  std::vector<rclcpp::Parameter> params = {
+    rclcpp::Parameter("joint_groups", std::vector<std::string>{"arm"}),
+    rclcpp::Parameter("groups.arm.joints", std::vector<std::string>{"joint1", "joint2"}),
+  };
+  SetUpTrajectoryController(executor, params);
+
+  auto state = traj_controller_->configure();
+  EXPECT_EQ(state.id(), State::PRIMARY_STATE_UNCONFIGURED);
+
+  // joint1 is part of two groups
+  params = {
+    rclcpp::Parameter("joint_groups", std::vector<std::string>{"arm", "wrist"}),
+    rclcpp::Parameter("groups.arm.joints", std::vector<std::string>{"joint1", "joint2"}),
+    rclcpp::Parameter("groups.wrist.joints", std::vector<std::string>{"joint1", "joint3"}),
+  };
+  SetUpTrajectoryController(executor, params);
+
+  state = traj_controller_->configure();
+  EXPECT_EQ(state.id(), State::PRIMARY_STATE_UNCONFIGURED);
+}
+
+TEST_F(TrajectoryControllerTest, activate_with_many_joints_in_different_order)
+{
+  // a position command and position and velocity state interfaces for every joint
+  constexpr size_t kNumJoints = 1667;
+  joint_names_.clear();
+  for (size_t i = 0; i < kNumJoints; ++i)
+  {
+    joint_names_.push_back("joint_" + std::to_string(i));
+  }
+  joint_pos_.assign(kNumJoints, 0.0);
+  joint_vel_.assign(kNumJoints, 0.0);
+  for (size_t i = 0; i < kNumJoints; ++i)
+  {
+    joint_pos_[i] = 0.001 * static_cast<double>(i);
+    joint_vel_[i] = -0.001 * static_cast<double>(i);
+  }
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  SetUpTrajectoryController(executor);
+
+  const auto configured_state = traj_controller_->configure();
+  ASSERT_EQ(configured_state.id(), lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+
+  std::vector<hardware_interface::LoanedCommandInterface> cmd_interfaces;
+  std::vector<hardware_interface::LoanedStateInterface> state_interfaces;
+  pos_cmd_interfaces_.reserve(kNumJoints);
+  pos_state_interfaces_.reserve(kNumJoints);
+  vel_state_interfaces_.reserve(kNumJoints);
+  for (size_t i = 0; i < kNumJoints; ++i)
+  {
+    pos_cmd_interfaces_.emplace_back(
+      hardware_interface::CommandInterface(
+        joint_names_[i], hardware_interface::HW_IF_POSITION, &joint_pos_[i]));
+    pos_state_interfaces_.emplace_back(
+      hardware_interface::StateInterface(
+        joint_names_[i], hardware_interface::HW_IF_POSITION, &joint_pos_[i]));
+    vel_state_interfaces_.emplace_back(
+      hardware_interface::StateInterface(
+        joint_names_[i], hardware_interface::HW_IF_VELOCITY, &joint_vel_[i]));
+  }
+  // the interfaces are loaned in the reverse order of the joints parameter
+  for (size_t i = kNumJoints; i-- > 0;)
+  {
+    cmd_interfaces.emplace_back(pos_cmd_interfaces_[i]);
+    state_interfaces.emplace_back(vel_state_interfaces_[i]);
+    state_interfaces.emplace_back(pos_state_interfaces_[i]);
+  }
+  traj_controller_->assign_interfaces(std::move(cmd_interfaces), std::move(state_interfaces));
+
+  const auto activated_state = traj_controller_->get_node()->activate();
+  ASSERT_EQ(activated_state.id(), lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE);
+
+  const auto expected_pos = joint_pos_;
+  updateControllerAsync(rclcpp::Duration::from_seconds(0.01));
+
+  // the state is read in the joint order of the parameter, and the position is held
+  const auto state_feedback = traj_controller_->get_state_feedback();
+  ASSERT_EQ(state_feedback.positions.size(), kNumJoints);
+  ASSERT_EQ(state_feedback.velocities.size(), kNumJoints);
+  for (size_t i = 0; i < kNumJoints; ++i)
+  {
+    EXPECT_EQ(state_feedback.positions[i], expected_pos[i]);
+    EXPECT_EQ(state_feedback.velocities[i], -0.001 * static_cast<double>(i));
+    EXPECT_NEAR(joint_pos_[i], expected_pos[i], COMMON_THRESHOLD);
+  }
+}
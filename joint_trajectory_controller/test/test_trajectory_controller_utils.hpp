@@ -15,8 +15,10 @@
 #ifndef TEST_TRAJECTORY_CONTROLLER_UTILS_HPP_
 #define TEST_TRAJECTORY_CONTROLLER_UTILS_HPP_
 
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -170,7 +172,7 @@ public:
 
   joint_trajectory_controller::SegmentTolerances get_active_tolerances()
   {
-    return *(active_tolerances_.readFromRT());
+    return *(joint_groups_.front()->active_tolerances.readFromRT());
   }
 
   std::vector<PidPtr> get_pids() const { return pids_; }
@@ -184,16 +186,39 @@ public:
 
   bool has_trivial_traj() const
   {
-    return has_active_trajectory() && current_trajectory_->has_nontrivial_msg() == false;
+    return has_active_trajectory() &&
+           joint_groups_.front()->current_trajectory->has_nontrivial_msg() == false;
   }
 
   bool has_nontrivial_traj()
   {
-    return has_active_trajectory() && current_trajectory_->has_nontrivial_msg();
+    return has_active_trajectory() &&
+           joint_groups_.front()->current_trajectory->has_nontrivial_msg();
   }
 
   double get_cmd_timeout() { return cmd_timeout_; }
 
+  /**
+   * @brief wait until the command table has computed the samples of the current trajectory
+   * @return false if the table is not enabled or not complete within the timeout
+   */
+  bool wait_for_command_table(
+    const std::chrono::milliseconds & timeout = std::chrono::milliseconds{1000})
+  {
+    const auto & table = joint_groups_.front()->command_table;
+    const auto end_time = std::chrono::steady_clock::now() + timeout;
+    while (table && !table->is_complete() && std::chrono::steady_clock::now() < end_time)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return table && table->is_complete();
+  }
+
+  size_t get_command_table_cycles() const
+  {
+    return joint_groups_.front()->command_table_cycles;
+  }
+
   void set_node_options(const rclcpp::NodeOptions & node_options) { node_options_ = node_options; }
 
   trajectory_msgs::msg::JointTrajectoryPoint get_state_feedback() { return state_current_; }
@@ -31,6 +31,7 @@
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "realtime_tools/realtime_thread_safe_box.hpp"
+#include "ros2_controllers_utils/stamped_command.hpp"
 #include "std_srvs/srv/set_bool.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
 
@@ -47,6 +48,9 @@ static constexpr size_t NR_CMD_ITFS = 4;
 // name constants for reference interfaces
 static constexpr size_t NR_REF_ITFS = 3;
 
+// name constants for exported state interfaces of the odometry
+static constexpr size_t NR_ODOM_STATE_ITFS = 6;
+
 class MecanumDriveController : public controller_interface::ChainableControllerInterface
 {
 public:
@@ -73,7 +77,21 @@ public:
   controller_interface::return_type update_and_write_commands(
     const rclcpp::Time & time, const rclcpp::Duration & period) override;
 
+  /**
+   * \brief Get the odometry at a past point in time, interpolated from the odometry history.
+   *
+   * The size of the history is set with the ``odom_history_size`` parameter. Lock-free, can be
+   * called from any thread while the controller is configured, e.g., by a localization running in
+   * the same process.
+   *
+   * \return false if \p time is not covered by the history.
+   */
+  bool get_odometry_at(
+    const rclcpp::Time & time, ros2_controllers_utils::OdometrySample & sample) const;
+
   using ControllerReferenceMsg = geometry_msgs::msg::TwistStamped;
+  // linear.x, linear.y and angular.z of a reference message, without its header
+  using Reference = ros2_controllers_utils::StampedCommand<3>;
   using OdomStateMsg = nav_msgs::msg::Odometry;
   using TfStateMsg = tf2_msgs::msg::TFMessage;
   using ControllerStateMsg = control_msgs::msg::MecanumDriveControllerState;
@@ -109,10 +127,10 @@ protected:
    */
   std::vector<std::string> state_joint_names_;
 
-  // the RT Box containing the command message
-  realtime_tools::RealtimeThreadSafeBox<ControllerReferenceMsg> input_ref_;
+  // the RT Box containing the reference of the last command message
+  realtime_tools::RealtimeThreadSafeBox<Reference> input_ref_;
   // save the last reference in case of unable to get value from box
-  ControllerReferenceMsg current_ref_;
+  Reference current_ref_;
   // the reference timeout value from parameters
   rclcpp::Duration ref_timeout_ = rclcpp::Duration::from_seconds(0.0);
 
@@ -134,6 +152,8 @@ protected:
   // override methods from ChainableControllerInterface
   std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
 
+  std::vector<hardware_interface::StateInterface> on_export_state_interfaces() override;
+
   bool on_set_chained_mode(bool chained_mode) override;
 
   Odometry odometry_;
@@ -141,6 +161,8 @@ protected:
 private:
   // callback for topic interface
   void reference_callback(const std::shared_ptr<ControllerReferenceMsg> msg);
+  /// Reduce \p msg to the values used by the controller, called from the subscriber.
+  static Reference to_reference(const ControllerReferenceMsg & msg);
 
   double velocity_in_center_frame_linear_x_;   // [m/s]
   double velocity_in_center_frame_linear_y_;   // [m/s]
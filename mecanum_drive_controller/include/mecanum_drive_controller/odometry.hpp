@@ -16,9 +16,11 @@
 #define MECANUM_DRIVE_CONTROLLER__ODOMETRY_HPP_
 
 #include <array>
+#include <cstddef>
 #include <functional>
 
 #include "rclcpp/time.hpp"
+#include "ros2_controllers_utils/odometry_history.hpp"
 
 #define PLANAR_POINT_DIM 3
 
@@ -81,6 +83,17 @@ public:
   void setWheelsParams(
     const double sum_of_robot_center_projection_on_X_Y_axis, const double wheels_radius);
 
+  /// \brief Sets the number of samples kept in the odometry history, 0 disables it
+  /// \param size Number of samples, allocates memory
+  void setHistorySize(const size_t size) { history_.resize(size); }
+
+  /// \brief Stores the current pose and velocity in the history
+  /// \param time Time of the last update
+  void pushHistory(const rclcpp::Time & time);
+
+  /// \return history of the odometry, can be read concurrently to the updates
+  const ros2_controllers_utils::OdometryHistory & getHistory() const { return history_; }
+
 private:
   /// Current timestamp:
   rclcpp::Time timestamp_;
@@ -103,6 +116,9 @@ private:
   /// sum_of_robot_center_projection_on_X_Y_axis_ = lx+ly
   double sum_of_robot_center_projection_on_X_Y_axis_;
   double wheels_radius_;  // [m]
+
+  /// Timestamped poses and velocities:
+  ros2_controllers_utils::OdometryHistory history_;
 };
 
 }  // namespace mecanum_drive_controller
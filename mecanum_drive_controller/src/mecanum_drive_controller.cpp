@@ -17,6 +17,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "controller_interface/helpers.hpp"
@@ -31,19 +32,6 @@ namespace
 using ControllerReferenceMsg =
   mecanum_drive_controller::MecanumDriveController::ControllerReferenceMsg;
 
-// called from RT control loop
-void reset_controller_reference_msg(
-  ControllerReferenceMsg & msg, const std::shared_ptr<rclcpp_lifecycle::LifecycleNode> & node)
-{
-  msg.header.stamp = node->now();
-  msg.twist.linear.x = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.linear.y = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.linear.z = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.angular.z = std::numeric_limits<double>::quiet_NaN();
-}
-
 }  // namespace
 
 namespace mecanum_drive_controller
@@ -116,6 +104,8 @@ controller_interface::CallbackReturn MecanumDriveController::on_configure(
   odometry_.setWheelsParams(
     params_.kinematics.sum_of_robot_center_projection_on_X_Y_axis,
     params_.kinematics.wheels_radius);
+  odometry_.setHistorySize(static_cast<size_t>(params_.odom_history_size));
+  state_interfaces_values_.resize(NR_ODOM_STATE_ITFS, std::numeric_limits<double>::quiet_NaN());
 
   // topics QoS
   auto subscribers_qos = rclcpp::SystemDefaultsQoS();
@@ -128,7 +118,7 @@ controller_interface::CallbackReturn MecanumDriveController::on_configure(
     "~/reference", subscribers_qos,
     std::bind(&MecanumDriveController::reference_callback, this, std::placeholders::_1));
 
-  reset_controller_reference_msg(current_ref_, get_node());
+  current_ref_.reset(get_node()->now().nanoseconds());
   input_ref_.set(current_ref_);
 
   try
@@ -250,7 +240,7 @@ void MecanumDriveController::reference_callback(const std::shared_ptr<Controller
   // Check the timeout condition
   if (ref_timeout_ == rclcpp::Duration::from_seconds(0) || age_of_last_command <= ref_timeout_)
   {
-    input_ref_.set(*msg);
+    input_ref_.set(to_reference(*msg));
   }
   else
   {
@@ -260,12 +250,20 @@ void MecanumDriveController::reference_callback(const std::shared_ptr<Controller
       rclcpp::Time(msg->header.stamp).seconds(), age_of_last_command.seconds(),
       ref_timeout_.seconds());
 
-    ControllerReferenceMsg emtpy_msg;
-    reset_controller_reference_msg(emtpy_msg, get_node());
-    input_ref_.set(emtpy_msg);
+    Reference empty_reference;
+    empty_reference.reset(get_node()->now().nanoseconds());
+    input_ref_.set(empty_reference);
   }
 }
 
+MecanumDriveController::Reference MecanumDriveController::to_reference(
+  const ControllerReferenceMsg & msg)
+{
+  return {
+    rclcpp::Time(msg.header.stamp).nanoseconds(),
+    {{msg.twist.linear.x, msg.twist.linear.y, msg.twist.angular.z}}};
+}
+
 controller_interface::InterfaceConfiguration
 MecanumDriveController::command_interface_configuration() const
 {
@@ -319,6 +317,38 @@ MecanumDriveController::on_export_reference_interfaces()
   return reference_interfaces;
 }
 
+std::vector<hardware_interface::StateInterface>
+MecanumDriveController::on_export_state_interfaces()
+{
+  std::vector<hardware_interface::StateInterface> state_interfaces;
+
+  state_interfaces.reserve(state_interfaces_values_.size());
+
+  const std::vector<std::pair<std::string, std::string>> state_interface_names = {
+    {"/x", hardware_interface::HW_IF_POSITION},
+    {"/y", hardware_interface::HW_IF_POSITION},
+    {"/yaw", hardware_interface::HW_IF_POSITION},
+    {"/linear/x", hardware_interface::HW_IF_VELOCITY},
+    {"/linear/y", hardware_interface::HW_IF_VELOCITY},
+    {"/angular/z", hardware_interface::HW_IF_VELOCITY}};
+
+  for (size_t i = 0; i < state_interfaces_values_.size(); ++i)
+  {
+    state_interfaces.push_back(
+      hardware_interface::StateInterface(
+        get_node()->get_name() + state_interface_names[i].first, state_interface_names[i].second,
+        &state_interfaces_values_[i]));
+  }
+
+  return state_interfaces;
+}
+
+bool MecanumDriveController::get_odometry_at(
+  const rclcpp::Time & time, ros2_controllers_utils::OdometrySample & sample) const
+{
+  return odometry_.getHistory().lookup(time.nanoseconds(), sample);
+}
+
 bool MecanumDriveController::on_set_chained_mode(bool /*chained_mode*/) { return true; }
 
 controller_interface::CallbackReturn MecanumDriveController::on_activate(
@@ -326,9 +356,9 @@ controller_interface::CallbackReturn MecanumDriveController::on_activate(
 {
   // Try to set default value in command.
   // If this fails, then another command will be received soon anyways.
-  ControllerReferenceMsg emtpy_msg;
-  reset_controller_reference_msg(emtpy_msg, get_node());
-  input_ref_.try_set(emtpy_msg);
+  Reference empty_reference;
+  empty_reference.reset(get_node()->now().nanoseconds());
+  input_ref_.try_set(empty_reference);
 
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -363,24 +393,22 @@ controller_interface::return_type MecanumDriveController::update_reference_from_
     current_ref_ = current_ref_op.value();
   }
 
-  const auto age_of_last_command = time - current_ref_.header.stamp;
+  const int64_t age_of_last_command = time.nanoseconds() - current_ref_.stamp;
 
   // accept message only if there is no timeout
-  if (age_of_last_command <= ref_timeout_ || ref_timeout_ == rclcpp::Duration::from_seconds(0))
+  if (
+    age_of_last_command <= ref_timeout_.nanoseconds() ||
+    ref_timeout_ == rclcpp::Duration::from_seconds(0))
   {
-    if (
-      !std::isnan(current_ref_.twist.linear.x) && !std::isnan(current_ref_.twist.linear.y) &&
-      !std::isnan(current_ref_.twist.angular.z))
+    if (!current_ref_.has_nan())
     {
-      reference_interfaces_[0] = current_ref_.twist.linear.x;
-      reference_interfaces_[1] = current_ref_.twist.linear.y;
-      reference_interfaces_[2] = current_ref_.twist.angular.z;
+      reference_interfaces_[0] = current_ref_.values[0];
+      reference_interfaces_[1] = current_ref_.values[1];
+      reference_interfaces_[2] = current_ref_.values[2];
 
       if (ref_timeout_ == rclcpp::Duration::from_seconds(0))
       {
-        current_ref_.twist.linear.x = std::numeric_limits<double>::quiet_NaN();
-        current_ref_.twist.linear.y = std::numeric_limits<double>::quiet_NaN();
-        current_ref_.twist.angular.z = std::numeric_limits<double>::quiet_NaN();
+        current_ref_.values.fill(std::numeric_limits<double>::quiet_NaN());
 
         input_ref_.try_set(current_ref_);
       }
@@ -388,17 +416,13 @@ controller_interface::return_type MecanumDriveController::update_reference_from_
   }
   else
   {
-    if (
-      !std::isnan(current_ref_.twist.linear.x) && !std::isnan(current_ref_.twist.linear.y) &&
-      !std::isnan(current_ref_.twist.angular.z))
+    if (!current_ref_.has_nan())
     {
       reference_interfaces_[0] = 0.0;
       reference_interfaces_[1] = 0.0;
       reference_interfaces_[2] = 0.0;
 
-      current_ref_.twist.linear.x = std::numeric_limits<double>::quiet_NaN();
-      current_ref_.twist.linear.y = std::numeric_limits<double>::quiet_NaN();
-      current_ref_.twist.angular.z = std::numeric_limits<double>::quiet_NaN();
+      current_ref_.values.fill(std::numeric_limits<double>::quiet_NaN());
 
       input_ref_.try_set(current_ref_);
     }
@@ -424,6 +448,14 @@ controller_interface::return_type MecanumDriveController::update_and_write_comma
     odometry_.update(
       wheel_front_left_state_vel, wheel_rear_left_state_vel, wheel_rear_right_state_vel,
       wheel_front_right_state_vel, period.seconds());
+    odometry_.pushHistory(time);
+
+    state_interfaces_values_[0] = odometry_.getX();
+    state_interfaces_values_[1] = odometry_.getY();
+    state_interfaces_values_[2] = odometry_.getRz();
+    state_interfaces_values_[3] = odometry_.getVx();
+    state_interfaces_values_[4] = odometry_.getVy();
+    state_interfaces_values_[5] = odometry_.getWz();
   }
 
   // INVERSE KINEMATICS (move robot).
@@ -507,7 +539,7 @@ controller_interface::return_type MecanumDriveController::update_and_write_comma
   orientation.setRPY(0.0, 0.0, odometry_.getRz());
 
   // Populate odom message and publish
-  if (rt_odom_state_publisher_->trylock())
+  if (params_.publish_odom && rt_odom_state_publisher_->trylock())
   {
     rt_odom_state_publisher_->msg_.header.stamp = time;
     rt_odom_state_publisher_->msg_.pose.pose.position.x = odometry_.getX();
@@ -35,7 +35,8 @@ Odometry::Odometry()
 void Odometry::init(
   const rclcpp::Time & time, std::array<double, PLANAR_POINT_DIM> base_frame_offset)
 {
-  // Reset timestamp:
+  // Reset history and timestamp:
+  history_.clear();
   timestamp_ = time;
 
   // Base frame offset (wrt to center frame).
@@ -121,4 +122,17 @@ void Odometry::setWheelsParams(
   wheels_radius_ = wheels_radius;
 }
 
+void Odometry::pushHistory(const rclcpp::Time & time)
+{
+  ros2_controllers_utils::OdometrySample sample;
+  sample.stamp = time.nanoseconds();
+  sample.x = position_x_in_base_frame_;
+  sample.y = position_y_in_base_frame_;
+  sample.heading = orientation_z_in_base_frame_;
+  sample.linear_x = velocity_in_base_frame_linear_x;
+  sample.linear_y = velocity_in_base_frame_linear_y;
+  sample.angular_z = velocity_in_base_frame_angular_z;
+  history_.push(sample);
+}
+
 }  // namespace mecanum_drive_controller
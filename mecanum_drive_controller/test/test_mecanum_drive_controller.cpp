@@ -116,6 +116,20 @@ TEST_F(MecanumDriveControllerTest, when_controller_configured_expect_properly_ex
       ref_itf_prefix_name + "/" + hardware_interface::HW_IF_VELOCITY);
     EXPECT_EQ(reference_interfaces[i]->get_interface_name(), hardware_interface::HW_IF_VELOCITY);
   }
+
+  // check exported state itfs of the odometry
+  auto exported_state_interfaces = controller_->export_state_interfaces();
+  ASSERT_EQ(exported_state_interfaces.size(), NR_ODOM_STATE_ITFS);
+
+  for (size_t i = 0; i < odometry_state_interface_names.size(); ++i)
+  {
+    const std::string state_itf_prefix_name =
+      std::string(controller_->get_node()->get_name()) + "/" + odometry_state_interface_names[i];
+    EXPECT_EQ(exported_state_interfaces[i]->get_prefix_name(), state_itf_prefix_name);
+    EXPECT_EQ(
+      exported_state_interfaces[i]->get_interface_name(),
+      i < 3 ? hardware_interface::HW_IF_POSITION : hardware_interface::HW_IF_VELOCITY);
+  }
 }
 
 TEST_F(MecanumDriveControllerTest, configure_succeeds_tf_test_prefix_false_no_namespace)
@@ -286,9 +300,9 @@ TEST_F(MecanumDriveControllerTest, when_controller_is_activated_expect_reference
   ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
 
   // check that the message is reset
-  auto msg = controller_->input_ref_.get();
-  EXPECT_TRUE(std::isnan(msg.twist.linear.x));
-  ASSERT_TRUE(std::isnan(msg.twist.angular.z));
+  auto reference = controller_->input_ref_.get();
+  EXPECT_TRUE(std::isnan(reference.values[0]));
+  ASSERT_TRUE(std::isnan(reference.values[2]));
 }
 
 TEST_F(MecanumDriveControllerTest, when_controller_active_and_update_called_expect_success)
@@ -407,10 +421,10 @@ TEST_F(MecanumDriveControllerTest, when_reference_msg_is_too_old_expect_unset_re
   ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
 
   auto reference = controller_->input_ref_.get();
-  auto old_timestamp = reference.header.stamp;
-  EXPECT_TRUE(std::isnan(reference.twist.linear.x));
-  EXPECT_TRUE(std::isnan(reference.twist.linear.y));
-  EXPECT_TRUE(std::isnan(reference.twist.angular.z));
+  auto old_timestamp = reference.stamp;
+  EXPECT_TRUE(std::isnan(reference.values[0]));
+  EXPECT_TRUE(std::isnan(reference.values[1]));
+  EXPECT_TRUE(std::isnan(reference.values[2]));
 
   // reference_callback() is implicitly called when publish_commands() is called
   // reference_msg is published with provided time stamp when publish_commands( time_stamp)
@@ -419,10 +433,10 @@ TEST_F(MecanumDriveControllerTest, when_reference_msg_is_too_old_expect_unset_re
     controller_->get_node()->now() - controller_->ref_timeout_ -
     rclcpp::Duration::from_seconds(0.1));
   controller_->wait_for_commands(executor);
-  ASSERT_EQ(old_timestamp, reference.header.stamp);
-  EXPECT_TRUE(std::isnan(reference.twist.linear.x));
-  EXPECT_TRUE(std::isnan(reference.twist.linear.y));
-  EXPECT_TRUE(std::isnan(reference.twist.angular.z));
+  ASSERT_EQ(old_timestamp, reference.stamp);
+  EXPECT_TRUE(std::isnan(reference.values[0]));
+  EXPECT_TRUE(std::isnan(reference.values[1]));
+  EXPECT_TRUE(std::isnan(reference.values[2]));
 }
 
 // when time stamp is zero expect that time stamp is set to current time stamp
@@ -438,10 +452,10 @@ TEST_F(
   ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
 
   auto reference = controller_->input_ref_.get();
-  auto old_timestamp = reference.header.stamp;
-  EXPECT_TRUE(std::isnan(reference.twist.linear.x));
-  EXPECT_TRUE(std::isnan(reference.twist.linear.y));
-  EXPECT_TRUE(std::isnan(reference.twist.angular.z));
+  auto old_timestamp = reference.stamp;
+  EXPECT_TRUE(std::isnan(reference.values[0]));
+  EXPECT_TRUE(std::isnan(reference.values[1]));
+  EXPECT_TRUE(std::isnan(reference.values[2]));
 
   // reference_callback() is implicitly called when publish_commands() is called
   // reference_msg is published with provided time stamp when publish_commands( time_stamp)
@@ -451,13 +465,13 @@ TEST_F(
   controller_->wait_for_commands(executor);
   reference = controller_->input_ref_.get();
 
-  ASSERT_EQ(old_timestamp.sec, reference.header.stamp.sec);
-  EXPECT_FALSE(std::isnan(reference.twist.linear.x));
-  EXPECT_FALSE(std::isnan(reference.twist.angular.z));
-  EXPECT_EQ(reference.twist.linear.x, 1.5);
-  EXPECT_EQ(reference.twist.linear.y, 0.0);
-  EXPECT_EQ(reference.twist.angular.z, 0.0);
-  EXPECT_NE(reference.header.stamp.sec, 0.0);
+  ASSERT_EQ(old_timestamp / 1000000000, reference.stamp / 1000000000);
+  EXPECT_FALSE(std::isnan(reference.values[0]));
+  EXPECT_FALSE(std::isnan(reference.values[2]));
+  EXPECT_EQ(reference.values[0], 1.5);
+  EXPECT_EQ(reference.values[1], 0.0);
+  EXPECT_EQ(reference.values[2], 0.0);
+  EXPECT_NE(reference.stamp, 0);
 }
 
 // when the reference_msg has valid timestamp then the timeout check in reference_callback()
@@ -473,8 +487,8 @@ TEST_F(MecanumDriveControllerTest, when_message_has_valid_timestamp_expect_refer
   ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
 
   auto reference = controller_->input_ref_.get();
-  EXPECT_TRUE(std::isnan(reference.twist.linear.x));
-  EXPECT_TRUE(std::isnan(reference.twist.angular.z));
+  EXPECT_TRUE(std::isnan(reference.values[0]));
+  EXPECT_TRUE(std::isnan(reference.values[2]));
 
   // reference_callback() is implicitly called when publish_commands() is called
   // reference_msg is published with provided time stamp when publish_commands( time_stamp)
@@ -483,11 +497,11 @@ TEST_F(MecanumDriveControllerTest, when_message_has_valid_timestamp_expect_refer
 
   controller_->wait_for_commands(executor);
   reference = controller_->input_ref_.get();
-  EXPECT_FALSE(std::isnan(reference.twist.linear.x));
-  EXPECT_FALSE(std::isnan(reference.twist.angular.z));
-  EXPECT_EQ(reference.twist.linear.x, 1.5);
-  EXPECT_EQ(reference.twist.linear.y, 0.0);
-  EXPECT_EQ(reference.twist.angular.z, 0.0);
+  EXPECT_FALSE(std::isnan(reference.values[0]));
+  EXPECT_FALSE(std::isnan(reference.values[2]));
+  EXPECT_EQ(reference.values[0], 1.5);
+  EXPECT_EQ(reference.values[1], 0.0);
+  EXPECT_EQ(reference.values[2], 0.0);
 }
 
 // when not in chainable mode and ref_msg_timedout expect
@@ -526,14 +540,15 @@ TEST_F(
   msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
 
   auto reference = controller_->input_ref_.get();
-  const auto age_of_last_command = controller_->get_node()->now() - reference.header.stamp;
+  const int64_t age_of_last_command =
+    controller_->get_node()->now().nanoseconds() - reference.stamp;
 
   // age_of_last_command > ref_timeout_
-  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_);
-  ASSERT_EQ(reference.twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_.nanoseconds());
+  ASSERT_EQ(reference.values[0], TEST_LINEAR_VELOCITY_X);
   ASSERT_EQ(
     controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -556,14 +571,15 @@ TEST_F(
   msg_2.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg_2.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg_2.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg_2);
+  controller_->input_ref_.set(controller_->to_reference(msg_2));
 
   reference = controller_->input_ref_.get();
-  const auto age_of_last_command_2 = controller_->get_node()->now() - reference.header.stamp;
+  const int64_t age_of_last_command_2 =
+    controller_->get_node()->now().nanoseconds() - reference.stamp;
 
   // age_of_last_command_2 < ref_timeout_
-  ASSERT_TRUE(age_of_last_command_2 <= controller_->ref_timeout_);
-  ASSERT_EQ(reference.twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  ASSERT_TRUE(age_of_last_command_2 <= controller_->ref_timeout_.nanoseconds());
+  ASSERT_EQ(reference.values[0], TEST_LINEAR_VELOCITY_X);
   ASSERT_EQ(
     controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -577,7 +593,7 @@ TEST_F(
   //  joint_command_values_[controller_->get_rear_left_wheel_index()] = 1.0 / 0.5 * (1.5 - 0.0 - 1 *
   //  0.0)
   EXPECT_EQ(joint_command_values_[controller_->get_rear_left_wheel_index()], 3.0);
-  ASSERT_EQ(reference.twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  ASSERT_EQ(reference.values[0], TEST_LINEAR_VELOCITY_X);
   for (const auto & interface : controller_->reference_interfaces_)
   {
     EXPECT_TRUE(std::isnan(interface));
@@ -673,13 +689,14 @@ TEST_F(
   msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
   auto reference = controller_->input_ref_.get();
 
-  const auto age_of_last_command = controller_->get_node()->now() - reference.header.stamp;
+  const int64_t age_of_last_command =
+    controller_->get_node()->now().nanoseconds() - reference.stamp;
 
-  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_);
-  ASSERT_EQ(reference.twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_.nanoseconds());
+  ASSERT_EQ(reference.values[0], TEST_LINEAR_VELOCITY_X);
   ASSERT_EQ(
     controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -694,7 +711,7 @@ TEST_F(
   //  joint_command_values_[REAR_LEFT] = 1.0 / 0.5 * (1.5 - 0.0 - 1 * 0.0)
   EXPECT_EQ(joint_command_values_[controller_->get_rear_left_wheel_index()], 3.0);
   reference = controller_->input_ref_.get();
-  ASSERT_TRUE(std::isnan(reference.twist.linear.x));
+  ASSERT_TRUE(std::isnan(reference.values[0]));
 }
 
 TEST_F(
@@ -708,9 +725,9 @@ TEST_F(
   ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
 
   auto reference = controller_->input_ref_.get();
-  EXPECT_TRUE(std::isnan(reference.twist.linear.x));
-  EXPECT_TRUE(std::isnan(reference.twist.linear.y));
-  EXPECT_TRUE(std::isnan(reference.twist.angular.z));
+  EXPECT_TRUE(std::isnan(reference.values[0]));
+  EXPECT_TRUE(std::isnan(reference.values[1]));
+  EXPECT_TRUE(std::isnan(reference.values[2]));
   controller_->ref_timeout_ = rclcpp::Duration::from_seconds(0.0);
 
   // reference_callback() is called implicitly when publish_commands() is called.
@@ -721,12 +738,12 @@ TEST_F(
   controller_->wait_for_commands(executor);
   reference = controller_->input_ref_.get();
 
-  EXPECT_FALSE(std::isnan(reference.twist.linear.x));
-  EXPECT_FALSE(std::isnan(reference.twist.linear.y));
-  EXPECT_FALSE(std::isnan(reference.twist.angular.z));
-  EXPECT_EQ(reference.twist.linear.x, 1.5);
-  EXPECT_EQ(reference.twist.linear.y, 0.0);
-  EXPECT_EQ(reference.twist.angular.z, 0.0);
+  EXPECT_FALSE(std::isnan(reference.values[0]));
+  EXPECT_FALSE(std::isnan(reference.values[1]));
+  EXPECT_FALSE(std::isnan(reference.values[2]));
+  EXPECT_EQ(reference.values[0], 1.5);
+  EXPECT_EQ(reference.values[1], 0.0);
+  EXPECT_EQ(reference.values[2], 0.0);
 }
 
 TEST_F(MecanumDriveControllerTest, SideToSideAndRotationOdometryTest)
@@ -813,6 +830,14 @@ TEST_F(MecanumDriveControllerTest, SideToSideAndRotationOdometryTest)
   EXPECT_LT(std::abs(controller_->odometry_.getX()), 1.0);
   EXPECT_LT(std::abs(controller_->odometry_.getY()), 1.0);
   EXPECT_LT(std::abs(controller_->odometry_.getRz()), M_PI);
+
+  // Verify odometry of the last update is exported
+  EXPECT_EQ(controller_->state_interfaces_values_[0], controller_->odometry_.getX());
+  EXPECT_EQ(controller_->state_interfaces_values_[1], controller_->odometry_.getY());
+  EXPECT_EQ(controller_->state_interfaces_values_[2], controller_->odometry_.getRz());
+  EXPECT_EQ(controller_->state_interfaces_values_[3], controller_->odometry_.getVx());
+  EXPECT_EQ(controller_->state_interfaces_values_[4], controller_->odometry_.getVy());
+  EXPECT_EQ(controller_->state_interfaces_values_[5], controller_->odometry_.getWz());
 }
 
 int main(int argc, char ** argv)
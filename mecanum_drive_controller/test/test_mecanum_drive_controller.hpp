@@ -285,6 +285,8 @@ protected:
 
 protected:
   std::vector<std::string> reference_interface_names = {"linear/x", "linear/y", "angular/z"};
+  std::vector<std::string> odometry_state_interface_names = {
+    "x", "y", "yaw", "linear/x", "linear/y", "angular/z"};
 
   static constexpr char TEST_FRONT_LEFT_CMD_JOINT_NAME[] = "front_left_wheel_joint";
   static constexpr char TEST_FRONT_RIGHT_CMD_JOINT_NAME[] = "front_right_wheel_joint";
@@ -0,0 +1,91 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__ALLOCATION_COUNTER_HPP_
+#define ROS2_CONTROLLERS_UTILS__ALLOCATION_COUNTER_HPP_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace ros2_controllers_utils
+{
+/// Number of memory allocations of the calling thread, see ROS2_CONTROLLERS_UTILS_COUNT_ALLOCATIONS
+inline size_t & thread_allocations()
+{
+  static thread_local size_t allocations = 0;
+  return allocations;
+}
+
+/**
+ * \brief Counts the memory allocations of the calling thread since construction, for tests of
+ * code that runs in the realtime loop.
+ *
+ * Allocations are only counted in executables that replace the global operator new with
+ * ROS2_CONTROLLERS_UTILS_COUNT_ALLOCATIONS() in one of their source files. Allocations of other
+ * threads, e.g., of the thread of a realtime publisher, are not counted.
+ */
+class AllocationCounter
+{
+public:
+  AllocationCounter() : start_(thread_allocations()) {}
+
+  size_t get_allocations() const { return thread_allocations() - start_; }
+
+private:
+  size_t start_;
+};
+
+/// Number of memory allocations of the calling thread while calling \p function
+template <typename Function>
+size_t count_allocations(Function && function)
+{
+  AllocationCounter counter;
+  function();
+  return counter.get_allocations();
+}
+
+}  // namespace ros2_controllers_utils
+
+// The replacements are not inlined: GCC would match the malloc() and free() in their bodies
+// against the new and delete expressions of the callers otherwise (-Wmismatched-new-delete).
+#if defined(__GNUC__)
+#define ROS2_CONTROLLERS_UTILS_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define ROS2_CONTROLLERS_UTILS_NOINLINE __declspec(noinline)
+#else
+#define ROS2_CONTROLLERS_UTILS_NOINLINE
+#endif
+
+/// Replaces the global operator new and delete with ones counting the allocations per thread.
+#define ROS2_CONTROLLERS_UTILS_COUNT_ALLOCATIONS()                                           \
+  ROS2_CONTROLLERS_UTILS_NOINLINE void * operator new(std::size_t size)                      \
+  {                                                                                          \
+    ++ros2_controllers_utils::thread_allocations();                                          \
+    if (void * pointer = std::malloc(size > 0 ? size : 1))                                   \
+    {                                                                                        \
+      return pointer;                                                                        \
+    }                                                                                        \
+    throw std::bad_alloc();                                                                  \
+  }                                                                                          \
+  ROS2_CONTROLLERS_UTILS_NOINLINE void operator delete(void * pointer) noexcept              \
+  {                                                                                          \
+    std::free(pointer);                                                                      \
+  }                                                                                          \
+  ROS2_CONTROLLERS_UTILS_NOINLINE void operator delete(void * pointer, std::size_t) noexcept \
+  {                                                                                          \
+    std::free(pointer);                                                                      \
+  }
+
+#endif  // ROS2_CONTROLLERS_UTILS__ALLOCATION_COUNTER_HPP_
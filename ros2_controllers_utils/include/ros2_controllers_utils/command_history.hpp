@@ -0,0 +1,74 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__COMMAND_HISTORY_HPP_
+#define ROS2_CONTROLLERS_UTILS__COMMAND_HISTORY_HPP_
+
+#include <array>
+#include <cstddef>
+
+namespace ros2_controllers_utils
+{
+/**
+ * \brief Fixed-capacity history of the last commands of a controller.
+ *
+ * The commands are stored inline in a ring buffer, which always holds \p Capacity commands: adding
+ * a command overwrites the oldest one. Does not allocate memory and can be used in the realtime
+ * loop.
+ *
+ * \tparam T Type of the command, e.g., std::array<double, 2> for linear and angular velocity.
+ * \tparam Capacity Number of commands kept, e.g., 2 for acceleration and jerk limiting.
+ */
+template <typename T, size_t Capacity>
+class CommandHistory
+{
+  static_assert(Capacity > 0, "CommandHistory needs a capacity of at least one command");
+
+public:
+  explicit CommandHistory(const T & value = T()) { fill(value); }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+  /// Overwrite all commands of the history with \p value.
+  void fill(const T & value)
+  {
+    commands_.fill(value);
+    latest_ = 0;
+  }
+
+  /// Add \p command as the latest command, dropping the oldest one.
+  void push(const T & command)
+  {
+    latest_ = latest_ + 1 == Capacity ? 0 : latest_ + 1;
+    commands_[latest_] = command;
+  }
+
+  /**
+   * \brief Get a previous command.
+   *
+   * \param[in] age 0 for the latest command, 1 for the one before, up to Capacity - 1.
+   */
+  const T & previous(const size_t age = 0) const
+  {
+    return commands_[latest_ >= age ? latest_ - age : latest_ + Capacity - age];
+  }
+
+private:
+  std::array<T, Capacity> commands_;
+  size_t latest_ = 0;
+};
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__COMMAND_HISTORY_HPP_
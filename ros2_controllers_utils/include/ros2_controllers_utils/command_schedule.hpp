@@ -0,0 +1,160 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__COMMAND_SCHEDULE_HPP_
+#define ROS2_CONTROLLERS_UTILS__COMMAND_SCHEDULE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ros2_controllers_utils
+{
+/**
+ * \brief Fixed-capacity queue of stamped commands, ordered by the time they take effect.
+ *
+ * Commands stamped in the future, e.g., by a remote planner compensating its network latency, are
+ * kept until their stamp is reached. sample() gets the command in effect at a point in time, i.e.,
+ * the one with the latest stamp not after it, optionally interpolated towards the next command.
+ * The commands are stored inline: the schedule does not allocate memory and can be passed from a
+ * subscriber to the realtime loop by copy, e.g., in a realtime box.
+ *
+ * \tparam N Number of values of a command, e.g., 2 for linear and angular velocity.
+ * \tparam Capacity Maximum number of commands kept.
+ */
+template <size_t N, size_t Capacity>
+class CommandSchedule
+{
+  static_assert(Capacity > 1, "CommandSchedule needs a capacity of at least two commands");
+
+public:
+  using Command = std::array<double, N>;
+
+  static constexpr size_t capacity() { return Capacity; }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  void clear() { size_ = 0; }
+
+  /**
+   * \brief Add \p command, taking effect at \p stamp [ns].
+   *
+   * A command with the same stamp is replaced. If the schedule is full, the command with the
+   * oldest stamp is dropped.
+   */
+  void insert(const int64_t stamp, const Command & command)
+  {
+    size_t index = size_;
+    while (index > 0 && stamps_[index - 1] > stamp)
+    {
+      --index;
+    }
+    if (index > 0 && stamps_[index - 1] == stamp)
+    {
+      commands_[index - 1] = command;
+      return;
+    }
+    if (size_ == Capacity)
+    {
+      if (index == 0)
+      {
+        // older than all scheduled commands
+        return;
+      }
+      erase_front(1);
+      --index;
+    }
+    for (size_t i = size_; i > index; --i)
+    {
+      stamps_[i] = stamps_[i - 1];
+      commands_[i] = commands_[i - 1];
+    }
+    stamps_[index] = stamp;
+    commands_[index] = command;
+    ++size_;
+  }
+
+  /// Drop the commands superseded at \p time [ns], keeping the command in effect and later ones.
+  void drop_superseded(const int64_t time)
+  {
+    const size_t next = find_next(time);
+    if (next > 1)
+    {
+      erase_front(next - 1);
+    }
+  }
+
+  /**
+   * \brief Get the command in effect at \p time [ns].
+   *
+   * \param[in] interpolate Interpolate linearly between the command in effect and the next one,
+   * instead of stepping at the stamp of the next command.
+   * \param[out] command The command in effect.
+   * \param[out] stamp Stamp of the command in effect, e.g., to check its age.
+   * \return false if no command takes effect until \p time.
+   */
+  bool sample(const int64_t time, const bool interpolate, Command & command, int64_t & stamp) const
+  {
+    const size_t next = find_next(time);
+    if (next == 0)
+    {
+      return false;
+    }
+    const size_t current = next - 1;
+    stamp = stamps_[current];
+    command = commands_[current];
+    if (interpolate && next < size_)
+    {
+      const double ratio = static_cast<double>(time - stamps_[current]) /
+                           static_cast<double>(stamps_[next] - stamps_[current]);
+      for (size_t i = 0; i < N; ++i)
+      {
+        command[i] += ratio * (commands_[next][i] - commands_[current][i]);
+      }
+    }
+    return true;
+  }
+
+private:
+  /// Index of the first command stamped after \p time.
+  size_t find_next(const int64_t time) const
+  {
+    size_t next = 0;
+    while (next < size_ && stamps_[next] <= time)
+    {
+      ++next;
+    }
+    return next;
+  }
+
+  void erase_front(const size_t count)
+  {
+    for (size_t i = count; i < size_; ++i)
+    {
+      stamps_[i - count] = stamps_[i];
+      commands_[i - count] = commands_[i];
+    }
+    size_ -= count;
+  }
+
+  std::array<int64_t, Capacity> stamps_{};
+  std::array<Command, Capacity> commands_{};
+  size_t size_ = 0;
+};
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__COMMAND_SCHEDULE_HPP_
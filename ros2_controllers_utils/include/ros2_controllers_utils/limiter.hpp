@@ -0,0 +1,344 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__LIMITER_HPP_
+#define ROS2_CONTROLLERS_UTILS__LIMITER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "ros2_controllers_utils/command_history.hpp"
+
+namespace ros2_controllers_utils
+{
+/**
+ * \brief Limits of one axis on its value and on its first and second time derivative.
+ *
+ * For a velocity command these are the velocity, acceleration and jerk limits, for a position
+ * command the position, velocity and acceleration limits. A pair of limits is only active if both
+ * of them are set, i.e., not NaN.
+ */
+struct AxisLimits
+{
+  double min_value = std::numeric_limits<double>::quiet_NaN();
+  double max_value = std::numeric_limits<double>::quiet_NaN();
+
+  /**
+   * Limits of the first derivative while the previous value is positive, or, with
+   * symmetric_derivatives, limits of its absolute value while the absolute value increases.
+   */
+  double min_first_derivative_pos = std::numeric_limits<double>::quiet_NaN();
+  double max_first_derivative_pos = std::numeric_limits<double>::quiet_NaN();
+  /**
+   * Limits of the first derivative while the previous value is negative, or, with
+   * symmetric_derivatives, limits of its absolute value while the absolute value decreases.
+   * Unlimited if not set.
+   */
+  double min_first_derivative_neg = std::numeric_limits<double>::quiet_NaN();
+  double max_first_derivative_neg = std::numeric_limits<double>::quiet_NaN();
+
+  double min_second_derivative = std::numeric_limits<double>::quiet_NaN();
+  double max_second_derivative = std::numeric_limits<double>::quiet_NaN();
+
+  /// Apply the value limits to the absolute value, i.e., in the same way to both directions.
+  bool symmetric_value = false;
+  /// Apply the derivative limits to the absolute changes, i.e., in the same way to both directions.
+  bool symmetric_derivatives = false;
+};
+
+/**
+ * \brief Get the limits of an axis with the semantics of control_toolbox::RateLimiter.
+ *
+ * If a max_* value is NaN, the respective limit is deactivated. If a min_* value is NaN, it
+ * defaults to -max. If min_first_derivative_pos or max_first_derivative_neg are NaN, the limits of
+ * the first derivative are the same for both directions.
+ *
+ * \throws std::invalid_argument if a minimum is greater than the respective maximum.
+ */
+inline AxisLimits make_rate_limits(
+  double min_value, double max_value, double min_first_derivative_neg,
+  double max_first_derivative_pos, double min_first_derivative_pos,
+  double max_first_derivative_neg, double min_second_derivative, double max_second_derivative)
+{
+  AxisLimits limits;
+  if (!std::isnan(max_value))
+  {
+    limits.max_value = max_value;
+    limits.min_value = std::isnan(min_value) ? -max_value : min_value;
+    if (limits.min_value > limits.max_value)
+    {
+      throw std::invalid_argument("Invalid value limits");
+    }
+  }
+  if (!std::isnan(max_first_derivative_pos))
+  {
+    limits.max_first_derivative_pos = max_first_derivative_pos;
+    limits.min_first_derivative_neg =
+      std::isnan(min_first_derivative_neg) ? -max_first_derivative_pos : min_first_derivative_neg;
+    limits.min_first_derivative_pos =
+      std::isnan(min_first_derivative_pos) ? limits.min_first_derivative_neg
+                                           : min_first_derivative_pos;
+    limits.max_first_derivative_neg =
+      std::isnan(max_first_derivative_neg) ? max_first_derivative_pos : max_first_derivative_neg;
+    if (
+      limits.min_first_derivative_neg > limits.max_first_derivative_pos ||
+      limits.min_first_derivative_pos > limits.max_first_derivative_pos ||
+      limits.min_first_derivative_neg > limits.max_first_derivative_neg)
+    {
+      throw std::invalid_argument("Invalid first derivative limits");
+    }
+  }
+  if (!std::isnan(max_second_derivative))
+  {
+    limits.max_second_derivative = max_second_derivative;
+    limits.min_second_derivative =
+      std::isnan(min_second_derivative) ? -max_second_derivative : min_second_derivative;
+    if (limits.min_second_derivative > limits.max_second_derivative)
+    {
+      throw std::invalid_argument("Invalid second derivative limits");
+    }
+  }
+  return limits;
+}
+
+/**
+ * \brief Limiter of the commands of N axes, e.g., linear and angular velocity of a mobile base.
+ *
+ * Which limits are active is resolved once at construction, such that limiting a command only
+ * evaluates the active limits. Does not allocate memory and can be used in the realtime loop.
+ */
+template <size_t N>
+class Limiter
+{
+public:
+  using Command = std::array<double, N>;
+
+  /// Limiter without any active limits.
+  Limiter() = default;
+
+  explicit Limiter(const std::array<AxisLimits, N> & limits)
+  {
+    for (size_t i = 0; i < N; ++i)
+    {
+      axes_[i] = resolve(limits[i]);
+    }
+  }
+
+  const AxisLimits & limits(const size_t axis) const { return axes_[axis].limits; }
+
+  /**
+   * \brief Limit the command of all axes.
+   *
+   * \param[in, out] command Command to limit.
+   * \param[in] history Previous commands, the latest one is the command of the last cycle.
+   * \param[in] dt Time step [s].
+   */
+  template <size_t Capacity>
+  void limit(Command & command, const CommandHistory<Command, Capacity> & history, double dt) const
+  {
+    static_assert(Capacity >= 2, "Limiting the second derivative needs two previous commands");
+    limit(command, history.previous(0), history.previous(1), dt, std::make_index_sequence<N>{});
+  }
+
+  /**
+   * \brief Limit the value, first and second derivative of one axis.
+   *
+   * \param[in] axis Index of the axis.
+   * \param[in, out] v Value to limit.
+   * \param[in] v0 Previous value to v.
+   * \param[in] v1 Previous value to v0.
+   * \param[in] dt Time step [s].
+   * \return Limiting factor (1.0 if none).
+   */
+  double limit(const size_t axis, double & v, double v0, double v1, double dt) const
+  {
+    const double tmp = v;
+    v = limit_axis(axes_[axis], v, v0, v1, dt);
+    return tmp != 0.0 ? v / tmp : 1.0;
+  }
+
+  /// Limit the value of one axis, \see limit().
+  double limit_value(const size_t axis, double & v) const
+  {
+    const double tmp = v;
+    if (axes_[axis].has_value_limits)
+    {
+      v = limit_value(axes_[axis], v);
+    }
+    return tmp != 0.0 ? v / tmp : 1.0;
+  }
+
+  /// Limit the first derivative of one axis, \see limit().
+  double limit_first_derivative(const size_t axis, double & v, double v0, double dt) const
+  {
+    const double tmp = v;
+    if (axes_[axis].has_first_derivative_limits)
+    {
+      v = limit_first_derivative(axes_[axis], v, v0, dt);
+    }
+    return tmp != 0.0 ? v / tmp : 1.0;
+  }
+
+  /// Limit the second derivative of one axis, \see limit().
+  double limit_second_derivative(
+    const size_t axis, double & v, double v0, double v1, double dt) const
+  {
+    const double tmp = v;
+    if (axes_[axis].has_second_derivative_limits)
+    {
+      v = limit_second_derivative(axes_[axis], v, v0, v1, dt);
+    }
+    return tmp != 0.0 ? v / tmp : 1.0;
+  }
+
+private:
+  template <size_t... Axes>
+  void limit(
+    Command & command, const Command & previous, const Command & second_to_last, double dt,
+    std::index_sequence<Axes...>) const
+  {
+    ((command[Axes] =
+        limit_axis(axes_[Axes], command[Axes], previous[Axes], second_to_last[Axes], dt)),
+     ...);
+  }
+
+  struct Axis
+  {
+    AxisLimits limits;
+    bool has_value_limits = false;
+    bool has_first_derivative_limits = false;
+    bool has_second_derivative_limits = false;
+  };
+
+  static Axis resolve(const AxisLimits & limits)
+  {
+    Axis axis;
+    axis.limits = limits;
+    axis.has_value_limits = !std::isnan(limits.min_value) && !std::isnan(limits.max_value);
+    axis.has_first_derivative_limits =
+      !std::isnan(limits.min_first_derivative_pos) && !std::isnan(limits.max_first_derivative_pos);
+    axis.has_second_derivative_limits =
+      !std::isnan(limits.min_second_derivative) && !std::isnan(limits.max_second_derivative);
+    if (std::isnan(limits.min_first_derivative_neg) || std::isnan(limits.max_first_derivative_neg))
+    {
+      axis.limits.min_first_derivative_neg =
+        limits.symmetric_derivatives ? 0.0 : -std::numeric_limits<double>::infinity();
+      axis.limits.max_first_derivative_neg = std::numeric_limits<double>::infinity();
+    }
+    return axis;
+  }
+
+  static double limit_axis(const Axis & axis, double v, double v0, double v1, double dt)
+  {
+    if (axis.has_second_derivative_limits)
+    {
+      v = limit_second_derivative(axis, v, v0, v1, dt);
+    }
+    if (axis.has_first_derivative_limits)
+    {
+      v = limit_first_derivative(axis, v, v0, dt);
+    }
+    if (axis.has_value_limits)
+    {
+      v = limit_value(axis, v);
+    }
+    return v;
+  }
+
+  static double limit_value(const Axis & axis, double v)
+  {
+    const auto & l = axis.limits;
+    if (l.symmetric_value)
+    {
+      const double sign = v >= 0 ? 1.0 : -1.0;
+      return sign * std::clamp(std::fabs(v), l.min_value, l.max_value);
+    }
+    else
+    {
+      return std::clamp(v, l.min_value, l.max_value);
+    }
+  }
+
+  static double limit_first_derivative(const Axis & axis, double v, double v0, double dt)
+  {
+    const auto & l = axis.limits;
+    if (l.symmetric_derivatives)
+    {
+      const bool accelerating = std::fabs(v) >= std::fabs(v0);
+      const double dv_min =
+        (accelerating ? l.min_first_derivative_pos : l.min_first_derivative_neg) * dt;
+      const double dv_max =
+        (accelerating ? l.max_first_derivative_pos : l.max_first_derivative_neg) * dt;
+      const double dv = std::clamp(std::fabs(v - v0), dv_min, dv_max);
+      return v0 + (v - v0 >= 0 ? dv : -dv);
+    }
+    else
+    {
+      double dv_min;
+      double dv_max;
+      if (v0 > 0.0)
+      {
+        dv_min = l.min_first_derivative_pos * dt;
+        dv_max = l.max_first_derivative_pos * dt;
+      }
+      else if (v0 < 0.0)
+      {
+        dv_min = l.min_first_derivative_neg * dt;
+        dv_max = l.max_first_derivative_neg * dt;
+      }
+      else
+      {
+        dv_min = l.min_first_derivative_neg * dt;
+        dv_max = l.max_first_derivative_pos * dt;
+      }
+      return v0 + std::clamp(v - v0, dv_min, dv_max);
+    }
+  }
+
+  static double limit_second_derivative(
+    const Axis & axis, double v, double v0, double v1, double dt)
+  {
+    const auto & l = axis.limits;
+    const double dv = v - v0;
+    const double dv0 = v0 - v1;
+    if (l.symmetric_derivatives)
+    {
+      const double dt2 = 2. * dt * dt;
+      const double da = std::clamp(
+        std::fabs(dv - dv0), l.min_second_derivative * dt2, l.max_second_derivative * dt2);
+      return v0 + dv0 + (dv - dv0 >= 0 ? da : -da);
+    }
+    // as control_toolbox::RateLimiter, only limit the jerk when accelerating in either direction
+    // to avoid oscillations in closed loop
+    else if ((dv - dv0) * dv > 0)
+    {
+      const double dt2 = dt * dt;
+      const double da =
+        std::clamp(dv - dv0, l.min_second_derivative * dt2, l.max_second_derivative * dt2);
+      return v0 + dv0 + da;
+    }
+    return v;
+  }
+
+  std::array<Axis, N> axes_;
+};
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__LIMITER_HPP_
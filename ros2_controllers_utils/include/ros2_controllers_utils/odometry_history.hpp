@@ -0,0 +1,272 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__ODOMETRY_HISTORY_HPP_
+#define ROS2_CONTROLLERS_UTILS__ODOMETRY_HISTORY_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ros2_controllers_utils
+{
+/// Planar pose and twist of a mobile base at a point in time.
+struct OdometrySample
+{
+  int64_t stamp = 0;       // [ns]
+  double x = 0.0;          // [m]
+  double y = 0.0;          // [m]
+  double heading = 0.0;    // [rad]
+  double linear_x = 0.0;   // [m/s]
+  double linear_y = 0.0;   // [m/s]
+  double angular_z = 0.0;  // [rad/s]
+};
+
+/**
+ * \brief Fixed-size history of the odometry, which can be queried at past points in time.
+ *
+ * The samples are stored in a ring buffer allocated by resize(). A single thread, i.e., the
+ * realtime loop of the controller, adds samples with push() and clear(), which neither allocate
+ * nor block. Any number of other threads can query the history concurrently with lookup(), which
+ * never blocks the writer: every slot is protected by a sequence counter. If a slot is overwritten
+ * while it is read, the reader retries with the updated history, and fails after
+ * kMaxReadAttempts attempts.
+ *
+ * The heading is interpolated linearly, i.e., it has to be continuous as in the odometry classes,
+ * not wrapped to [-pi, pi].
+ */
+class OdometryHistory
+{
+public:
+  /// Number of attempts of latest() and lookup() before they give up on concurrent overwrites.
+  static constexpr size_t kMaxReadAttempts = 4;
+
+  explicit OdometryHistory(size_t capacity = 0) { resize(capacity); }
+
+  /// Set the number of samples kept. Allocates memory and must not be called concurrently.
+  void resize(size_t capacity)
+  {
+    slots_.reset(capacity > 0 ? new Slot[capacity] : nullptr);
+    capacity_ = capacity;
+    head_.store(0, std::memory_order_relaxed);
+    first_.store(0, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  /// Number of samples that can currently be queried.
+  size_t size() const
+  {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    return static_cast<size_t>(head - oldest(head));
+  }
+
+  /// Drop all samples, e.g., when the odometry is reset. Realtime-safe, writer thread only.
+  void clear() { first_.store(head_.load(std::memory_order_relaxed), std::memory_order_release); }
+
+  /**
+   * \brief Add the latest sample, overwriting the oldest one if the history is full.
+   *
+   * Realtime-safe, writer thread only. The stamps have to be increasing, older samples are ignored.
+   */
+  void push(const OdometrySample & sample)
+  {
+    if (capacity_ == 0)
+    {
+      return;
+    }
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head > oldest(head) && sample.stamp <= slot(head - 1).stamp.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+
+    Slot & s = slot(head);
+    // odd sequence: the slot is being written
+    s.sequence.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.stamp.store(sample.stamp, std::memory_order_relaxed);
+    s.x.store(sample.x, std::memory_order_relaxed);
+    s.y.store(sample.y, std::memory_order_relaxed);
+    s.heading.store(sample.heading, std::memory_order_relaxed);
+    s.linear_x.store(sample.linear_x, std::memory_order_relaxed);
+    s.linear_y.store(sample.linear_y, std::memory_order_relaxed);
+    s.angular_z.store(sample.angular_z, std::memory_order_relaxed);
+    s.sequence.store(2 * head + 2, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /// Get the latest sample, returns false if the history is empty.
+  bool latest(OdometrySample & sample) const
+  {
+    for (size_t attempt = 0; attempt < kMaxReadAttempts; ++attempt)
+    {
+      const uint64_t head = head_.load(std::memory_order_acquire);
+      if (head == oldest(head))
+      {
+        return false;
+      }
+      if (read(head - 1, sample))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * \brief Get the odometry at \p stamp, interpolated linearly between the adjacent samples.
+   *
+   * Lock-free, can be called from any thread. Does not extrapolate.
+   *
+   * \param[in] stamp Time of the query [ns].
+   * \param[out] sample Interpolated sample, with its stamp set to \p stamp.
+   * \return false if \p stamp is not within the history, or if the samples were overwritten in
+   * each of the kMaxReadAttempts attempts.
+   */
+  bool lookup(const int64_t stamp, OdometrySample & sample) const
+  {
+    for (size_t attempt = 0; attempt < kMaxReadAttempts; ++attempt)
+    {
+      bool overwritten = false;
+      if (try_lookup(stamp, sample, overwritten))
+      {
+        return true;
+      }
+      if (!overwritten)
+      {
+        return false;
+      }
+    }
+    return false;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<int64_t> stamp{0};
+    std::atomic<double> x{0.0};
+    std::atomic<double> y{0.0};
+    std::atomic<double> heading{0.0};
+    std::atomic<double> linear_x{0.0};
+    std::atomic<double> linear_y{0.0};
+    std::atomic<double> angular_z{0.0};
+  };
+
+  /// Single attempt of lookup(), sets \p overwritten if a slot was written while it was read.
+  bool try_lookup(const int64_t stamp, OdometrySample & sample, bool & overwritten) const
+  {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t lo = oldest(head);
+    if (head == lo)
+    {
+      return false;
+    }
+
+    OdometrySample before;
+    OdometrySample after;
+    if (!read(lo, before) || !read(head - 1, after))
+    {
+      overwritten = true;
+      return false;
+    }
+    if (stamp < before.stamp || stamp > after.stamp)
+    {
+      return false;
+    }
+
+    // binary search for the samples before and after stamp, keeping before at lo and after at hi
+    uint64_t hi = head - 1;
+    while (hi - lo > 1)
+    {
+      const uint64_t mid = lo + (hi - lo) / 2;
+      OdometrySample middle;
+      if (!read(mid, middle))
+      {
+        overwritten = true;
+        return false;
+      }
+      if (middle.stamp <= stamp)
+      {
+        lo = mid;
+        before = middle;
+      }
+      else
+      {
+        hi = mid;
+        after = middle;
+      }
+    }
+
+    if (after.stamp == before.stamp)
+    {
+      sample = after;
+      return true;
+    }
+    const double t =
+      static_cast<double>(stamp - before.stamp) / static_cast<double>(after.stamp - before.stamp);
+    const auto interpolate = [t](double a, double b) { return a + t * (b - a); };
+    sample.stamp = stamp;
+    sample.x = interpolate(before.x, after.x);
+    sample.y = interpolate(before.y, after.y);
+    sample.heading = interpolate(before.heading, after.heading);
+    sample.linear_x = interpolate(before.linear_x, after.linear_x);
+    sample.linear_y = interpolate(before.linear_y, after.linear_y);
+    sample.angular_z = interpolate(before.angular_z, after.angular_z);
+    return true;
+  }
+
+  Slot & slot(uint64_t index) const { return slots_[index % capacity_]; }
+
+  /// Index of the oldest sample which can be queried, given the index after the latest one.
+  uint64_t oldest(uint64_t head) const
+  {
+    const uint64_t first = first_.load(std::memory_order_acquire);
+    return std::max(first, head > capacity_ ? head - capacity_ : uint64_t{0});
+  }
+
+  /// Read the sample with \p index, returns false if it was overwritten in the meantime.
+  bool read(uint64_t index, OdometrySample & sample) const
+  {
+    const Slot & s = slot(index);
+    const uint64_t sequence = s.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * index + 2)
+    {
+      return false;
+    }
+    sample.stamp = s.stamp.load(std::memory_order_relaxed);
+    sample.x = s.x.load(std::memory_order_relaxed);
+    sample.y = s.y.load(std::memory_order_relaxed);
+    sample.heading = s.heading.load(std::memory_order_relaxed);
+    sample.linear_x = s.linear_x.load(std::memory_order_relaxed);
+    sample.linear_y = s.linear_y.load(std::memory_order_relaxed);
+    sample.angular_z = s.angular_z.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return s.sequence.load(std::memory_order_relaxed) == sequence;
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t capacity_ = 0;
+  /// index of the next sample to be written, i.e., number of samples pushed since resize()
+  std::atomic<uint64_t> head_{0};
+  /// index of the first sample after the last clear()
+  std::atomic<uint64_t> first_{0};
+};
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__ODOMETRY_HISTORY_HPP_
@@ -0,0 +1,71 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__PUBLISH_RATE_HPP_
+#define ROS2_CONTROLLERS_UTILS__PUBLISH_RATE_HPP_
+
+#include <stdexcept>
+
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
+
+namespace ros2_controllers_utils
+{
+/**
+ * \brief Previous publish timestamp for which a message is due in the first cycle after \p time.
+ *
+ * Controllers initialize their publish timestamp with it on activation, using the time of their
+ * clock, so that is_publish_due() does not throw in the first update cycle.
+ */
+inline rclcpp::Time get_initial_publish_timestamp(
+  const rclcpp::Time & time, const rclcpp::Duration & publish_period)
+{
+  return rclcpp::Time(time.nanoseconds() - publish_period.nanoseconds(), time.get_clock_type());
+}
+
+/**
+ * \brief Decide if a message with the given publish period is due at \p time.
+ *
+ * The message is due in every cycle if the period is zero. Otherwise \p previous_publish_timestamp
+ * is advanced by the period if the message is due. If the time source changed, the message is
+ * due and \p previous_publish_timestamp restarts at \p time.
+ */
+inline bool is_publish_due(
+  const rclcpp::Duration & publish_period, rclcpp::Time & previous_publish_timestamp,
+  const rclcpp::Time & time)
+{
+  if (publish_period.nanoseconds() == 0)
+  {
+    return true;
+  }
+  try
+  {
+    if (previous_publish_timestamp + publish_period < time)
+    {
+      previous_publish_timestamp += publish_period;
+      return true;
+    }
+  }
+  catch (const std::runtime_error &)
+  {
+    // Handle exceptions when the time source changes and initialize publish timestamp
+    previous_publish_timestamp = time;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__PUBLISH_RATE_HPP_
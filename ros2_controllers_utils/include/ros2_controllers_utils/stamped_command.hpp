@@ -0,0 +1,72 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__STAMPED_COMMAND_HPP_
+#define ROS2_CONTROLLERS_UTILS__STAMPED_COMMAND_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ros2_controllers_utils
+{
+/**
+ * \brief Command of a controller reduced to its stamp and the values the controller uses.
+ *
+ * Subscriber callbacks convert the received messages to this plain type before handing them over
+ * to the realtime loop, which then copies neither strings, e.g., the frame_id of the header, nor
+ * shared pointers.
+ *
+ * \tparam N Number of values of the command, e.g., 2 for linear and angular velocity.
+ */
+template <size_t N>
+struct StampedCommand
+{
+  using Values = std::array<double, N>;
+
+  /// Stamp of the command in nanoseconds.
+  int64_t stamp = 0;
+  Values values{};
+
+  /// Set the stamp to \p time and all values to NaN, i.e., no command was received yet.
+  void reset(const int64_t time)
+  {
+    stamp = time;
+    values.fill(std::numeric_limits<double>::quiet_NaN());
+  }
+
+  /// Whether all values are finite.
+  bool is_finite() const
+  {
+    return std::all_of(values.begin(), values.end(), [](double v) { return std::isfinite(v); });
+  }
+
+  /// Whether any value is NaN, e.g., because no command was received yet.
+  bool has_nan() const
+  {
+    return std::any_of(values.begin(), values.end(), [](double v) { return std::isnan(v); });
+  }
+};
+
+static_assert(
+  std::is_trivially_copyable<StampedCommand<2>>::value,
+  "StampedCommand must be copyable without allocating memory");
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__STAMPED_COMMAND_HPP_
@@ -0,0 +1,50 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__URDF_MODEL_CACHE_HPP_
+#define ROS2_CONTROLLERS_UTILS__URDF_MODEL_CACHE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "rclcpp/version.h"
+#if RCLCPP_VERSION_GTE(29, 0, 0)
+#include "urdf/model.hpp"
+#else
+#include "urdf/model.h"
+#endif
+
+namespace ros2_controllers_utils
+{
+/**
+ * \brief Get the parsed model of a robot description.
+ *
+ * Models are cached process-wide and shared by all controllers configured with the same robot
+ * description, such that it is parsed only once. A model is kept as long as any returned pointer
+ * to it exists.
+ *
+ * Thread-safe, but not realtime-safe: call it from the lifecycle transitions only.
+ *
+ * \param[in] robot_description URDF of the robot.
+ * \returns the parsed model, or nullptr if the description cannot be parsed.
+ */
+std::shared_ptr<const urdf::Model> get_urdf_model(const std::string & robot_description);
+
+/// Number of models currently held in the cache.
+size_t get_urdf_model_cache_size();
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__URDF_MODEL_CACHE_HPP_
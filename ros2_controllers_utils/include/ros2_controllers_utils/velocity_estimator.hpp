@@ -0,0 +1,181 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS2_CONTROLLERS_UTILS__VELOCITY_ESTIMATOR_HPP_
+#define ROS2_CONTROLLERS_UTILS__VELOCITY_ESTIMATOR_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ros2_controllers_utils
+{
+/**
+ * \brief Low-pass filter of a velocity signal, e.g., the velocity estimated by an odometry.
+ *
+ * The type of the filter and its window size are selected with configure(), which is the only
+ * method allocating memory. accumulate() takes O(1) time independent of the window size, and
+ * reset() keeps the storage.
+ *
+ * All types are parametrized with the window size of the rolling mean:
+ * - ROLLING_MEAN: mean of the last window_size samples.
+ * - EXPONENTIAL: exponential moving average with smoothing factor 2 / (window_size + 1), which has
+ *   the same mean age of the samples as the rolling mean.
+ * - BUTTERWORTH: second-order Butterworth low-pass with the -3 dB cutoff frequency of the rolling
+ *   mean, i.e., 0.443 / window_size times the sample rate, but with much better attenuation above.
+ *
+ * Until window_size samples were accumulated, the rolling mean is the mean of the samples so far.
+ * The other filters start at the first sample.
+ */
+class VelocityEstimator
+{
+public:
+  enum class Type
+  {
+    ROLLING_MEAN,
+    EXPONENTIAL,
+    BUTTERWORTH
+  };
+
+  explicit VelocityEstimator(Type type = Type::ROLLING_MEAN, size_t window_size = 10)
+  {
+    configure(type, window_size);
+  }
+
+  /**
+   * \brief Get the type from its name, as used for parameters.
+   *
+   * \param[in] name "rolling_mean", "exponential" or "butterworth".
+   * \param[out] type Type with the given name.
+   * \return false if there is no type with the given name.
+   */
+  static bool type_from_string(const std::string & name, Type & type)
+  {
+    if (name == "rolling_mean")
+    {
+      type = Type::ROLLING_MEAN;
+    }
+    else if (name == "exponential")
+    {
+      type = Type::EXPONENTIAL;
+    }
+    else if (name == "butterworth")
+    {
+      type = Type::BUTTERWORTH;
+    }
+    else
+    {
+      return false;
+    }
+    return true;
+  }
+
+  /// Select the filter and its window size, a window size of 0 is treated as 1. Allocates memory.
+  void configure(Type type, size_t window_size)
+  {
+    type_ = type;
+    window_size = std::max<size_t>(window_size, 1);
+    buffer_.assign(type_ == Type::ROLLING_MEAN ? window_size : 0, 0.0);
+
+    alpha_ = 2.0 / (static_cast<double>(window_size) + 1.0);
+
+    // bilinear transform of the analog prototype, cutoff frequency relative to the sample rate
+    constexpr double pi = 3.14159265358979323846;
+    const double k = std::tan(pi * 0.443 / static_cast<double>(window_size));
+    const double norm = 1.0 / (1.0 + std::sqrt(2.0) * k + k * k);
+    b0_ = k * k * norm;
+    a1_ = 2.0 * (k * k - 1.0) * norm;
+    a2_ = (1.0 - std::sqrt(2.0) * k + k * k) * norm;
+
+    reset();
+  }
+
+  Type type() const { return type_; }
+
+  /// Drop all accumulated samples, does not allocate memory.
+  void reset()
+  {
+    std::fill(buffer_.begin(), buffer_.end(), 0.0);
+    next_insert_ = 0;
+    count_ = 0;
+    sum_ = 0.0;
+    estimate_ = 0.0;
+    x1_ = x2_ = y1_ = y2_ = 0.0;
+  }
+
+  /// Add a new sample of the velocity and update the estimate.
+  void accumulate(const double value)
+  {
+    switch (type_)
+    {
+      case Type::ROLLING_MEAN:
+        sum_ -= buffer_[next_insert_];
+        sum_ += value;
+        buffer_[next_insert_] = value;
+        next_insert_ = next_insert_ + 1 == buffer_.size() ? 0 : next_insert_ + 1;
+        count_ = std::min(count_ + 1, buffer_.size());
+        estimate_ = sum_ / static_cast<double>(count_);
+        break;
+      case Type::EXPONENTIAL:
+        estimate_ = count_ == 0 ? value : estimate_ + alpha_ * (value - estimate_);
+        count_ = 1;
+        break;
+      case Type::BUTTERWORTH:
+        if (count_ == 0)
+        {
+          // start in the steady state of the first sample
+          x1_ = x2_ = y1_ = y2_ = value;
+          count_ = 1;
+        }
+        estimate_ = b0_ * (value + 2.0 * x1_ + x2_) - a1_ * y1_ - a2_ * y2_;
+        x2_ = x1_;
+        x1_ = value;
+        y2_ = y1_;
+        y1_ = estimate_;
+        break;
+    }
+  }
+
+  /// Get the current estimate, 0 if no sample was accumulated since the last reset.
+  double get_estimate() const { return estimate_; }
+
+private:
+  Type type_ = Type::ROLLING_MEAN;
+
+  // rolling mean
+  std::vector<double> buffer_;
+  size_t next_insert_ = 0;
+  size_t count_ = 0;
+  double sum_ = 0.0;
+
+  // exponential moving average
+  double alpha_ = 1.0;
+
+  // Butterworth filter, b1 = 2 * b0 and b2 = b0
+  double b0_ = 1.0;
+  double a1_ = 0.0;
+  double a2_ = 0.0;
+  double x1_ = 0.0;
+  double x2_ = 0.0;
+  double y1_ = 0.0;
+  double y2_ = 0.0;
+
+  double estimate_ = 0.0;
+};
+
+}  // namespace ros2_controllers_utils
+
+#endif  // ROS2_CONTROLLERS_UTILS__VELOCITY_ESTIMATOR_HPP_
@@ -0,0 +1,111 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros2_controllers_utils/urdf_model_cache.hpp"
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace ros2_controllers_utils
+{
+namespace
+{
+struct CacheEntry
+{
+  std::string robot_description;
+  std::weak_ptr<const urdf::Model> model;
+};
+
+struct Cache
+{
+  // recursive, as releasing a model inside get_urdf_model() runs its deleter
+  std::recursive_mutex mutex;
+  // keyed by the hash of the robot description, colliding descriptions are not cached
+  std::unordered_map<size_t, CacheEntry> entries;
+};
+
+Cache & get_cache()
+{
+  // never destroyed, the deleters of models still held at static destruction access it
+  static auto * cache = new Cache();
+  return *cache;
+}
+}  // namespace
+
+std::shared_ptr<const urdf::Model> get_urdf_model(const std::string & robot_description)
+{
+  if (robot_description.empty())
+  {
+    return nullptr;
+  }
+
+  const auto hash = std::hash<std::string>{}(robot_description);
+  auto & cache = get_cache();
+  std::lock_guard<std::recursive_mutex> lock(cache.mutex);
+
+  auto it = cache.entries.find(hash);
+  if (it != cache.entries.end())
+  {
+    if (auto model = it->second.model.lock())
+    {
+      if (it->second.robot_description == robot_description)
+      {
+        return model;
+      }
+      // hash collision with a model in use, parse without caching
+      auto uncached_model = std::make_shared<urdf::Model>();
+      if (!uncached_model->initString(robot_description))
+      {
+        return nullptr;
+      }
+      return uncached_model;
+    }
+  }
+
+  auto parsed_model = std::make_unique<urdf::Model>();
+  if (!parsed_model->initString(robot_description))
+  {
+    return nullptr;
+  }
+
+  // remove the entry once the last controller releases the model
+  std::shared_ptr<const urdf::Model> model(
+    parsed_model.release(),
+    [hash](const urdf::Model * released_model)
+    {
+      auto & deleter_cache = get_cache();
+      {
+        std::lock_guard<std::recursive_mutex> deleter_lock(deleter_cache.mutex);
+        auto entry = deleter_cache.entries.find(hash);
+        // the entry might have been replaced by a newly parsed model in the meantime
+        if (entry != deleter_cache.entries.end() && entry->second.model.expired())
+        {
+          deleter_cache.entries.erase(entry);
+        }
+      }
+      delete released_model;
+    });
+  cache.entries[hash] = CacheEntry{robot_description, model};
+  return model;
+}
+
+size_t get_urdf_model_cache_size()
+{
+  auto & cache = get_cache();
+  std::lock_guard<std::recursive_mutex> lock(cache.mutex);
+  return cache.entries.size();
+}
+
+}  // namespace ros2_controllers_utils
@@ -0,0 +1,70 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ros2_controllers_utils/allocation_counter.hpp"
+
+ROS2_CONTROLLERS_UTILS_COUNT_ALLOCATIONS()
+
+using ros2_controllers_utils::AllocationCounter;
+
+TEST(TestAllocationCounter, counts_allocations_of_the_calling_thread)
+{
+  std::vector<double> values;
+  values.reserve(4);
+
+  AllocationCounter counter;
+  std::array<double, 4> fixed_values{};
+  for (size_t i = 0; i < values.capacity(); ++i)
+  {
+    values.push_back(fixed_values[i]);
+  }
+  EXPECT_EQ(0u, counter.get_allocations());
+
+  values.push_back(0.0);
+  auto pointer = std::make_unique<double>(1.0);
+  EXPECT_EQ(2u, counter.get_allocations());
+}
+
+TEST(TestAllocationCounter, counts_allocations_of_a_function)
+{
+  std::vector<double> values;
+  values.reserve(4);
+
+  EXPECT_EQ(0u, ros2_controllers_utils::count_allocations([&values]() { values.assign(4, 1.0); }));
+  EXPECT_EQ(1u, ros2_controllers_utils::count_allocations([&values]() { values.assign(5, 1.0); }));
+}
+
+TEST(TestAllocationCounter, does_not_count_allocations_of_other_threads)
+{
+  size_t other_thread_allocations = 0;
+  std::thread thread(
+    [&other_thread_allocations]()
+    {
+      AllocationCounter counter;
+      std::vector<double> values(10);
+      other_thread_allocations = counter.get_allocations();
+    });
+
+  AllocationCounter counter;
+  thread.join();
+  EXPECT_EQ(0u, counter.get_allocations());
+  EXPECT_EQ(1u, other_thread_allocations);
+}
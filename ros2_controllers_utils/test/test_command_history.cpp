@@ -0,0 +1,58 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+
+#include "ros2_controllers_utils/command_history.hpp"
+
+using ros2_controllers_utils::CommandHistory;
+
+TEST(TestCommandHistory, keeps_last_commands)
+{
+  CommandHistory<double, 3> history(-1.0);
+  EXPECT_EQ(3u, history.capacity());
+  EXPECT_EQ(-1.0, history.previous(0));
+  EXPECT_EQ(-1.0, history.previous(2));
+
+  for (int i = 1; i <= 5; ++i)
+  {
+    history.push(static_cast<double>(i));
+  }
+  EXPECT_EQ(5.0, history.previous());
+  EXPECT_EQ(4.0, history.previous(1));
+  EXPECT_EQ(3.0, history.previous(2));
+
+  history.fill(0.0);
+  EXPECT_EQ(0.0, history.previous(0));
+  EXPECT_EQ(0.0, history.previous(2));
+  history.push(7.0);
+  EXPECT_EQ(7.0, history.previous(0));
+  EXPECT_EQ(0.0, history.previous(1));
+}
+
+TEST(TestCommandHistory, two_commands)
+{
+  CommandHistory<std::array<double, 2>, 2> history;
+  EXPECT_EQ(0.0, history.previous(1)[0]);
+
+  history.push({{1.0, 2.0}});
+  history.push({{3.0, 4.0}});
+  history.push({{5.0, 6.0}});
+  EXPECT_EQ(5.0, history.previous(0)[0]);
+  EXPECT_EQ(6.0, history.previous(0)[1]);
+  EXPECT_EQ(3.0, history.previous(1)[0]);
+  EXPECT_EQ(4.0, history.previous(1)[1]);
+}
@@ -0,0 +1,115 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include "ros2_controllers_utils/command_schedule.hpp"
+
+using ros2_controllers_utils::CommandSchedule;
+using Schedule = CommandSchedule<2, 4>;
+
+TEST(TestCommandSchedule, commands_take_effect_at_their_stamps)
+{
+  Schedule schedule;
+  Schedule::Command command;
+  int64_t stamp = 0;
+  EXPECT_FALSE(schedule.sample(0, false, command, stamp));
+
+  // inserted out of order
+  schedule.insert(200, {{2.0, -2.0}});
+  schedule.insert(100, {{1.0, -1.0}});
+  EXPECT_EQ(2u, schedule.size());
+
+  EXPECT_FALSE(schedule.sample(99, false, command, stamp));
+  ASSERT_TRUE(schedule.sample(100, false, command, stamp));
+  EXPECT_EQ(100, stamp);
+  EXPECT_EQ(1.0, command[0]);
+  EXPECT_EQ(-1.0, command[1]);
+  ASSERT_TRUE(schedule.sample(199, false, command, stamp));
+  EXPECT_EQ(100, stamp);
+  EXPECT_EQ(1.0, command[0]);
+  ASSERT_TRUE(schedule.sample(1000, false, command, stamp));
+  EXPECT_EQ(200, stamp);
+  EXPECT_EQ(2.0, command[0]);
+  EXPECT_EQ(-2.0, command[1]);
+
+  // a command with the same stamp is replaced
+  schedule.insert(200, {{3.0, -3.0}});
+  EXPECT_EQ(2u, schedule.size());
+  ASSERT_TRUE(schedule.sample(200, false, command, stamp));
+  EXPECT_EQ(3.0, command[0]);
+}
+
+TEST(TestCommandSchedule, interpolates_towards_next_command)
+{
+  Schedule schedule;
+  schedule.insert(100, {{1.0, 0.0}});
+  schedule.insert(200, {{2.0, -1.0}});
+
+  Schedule::Command command;
+  int64_t stamp = 0;
+  ASSERT_TRUE(schedule.sample(125, true, command, stamp));
+  EXPECT_EQ(100, stamp);
+  EXPECT_DOUBLE_EQ(1.25, command[0]);
+  EXPECT_DOUBLE_EQ(-0.25, command[1]);
+
+  // no extrapolation after the last command
+  ASSERT_TRUE(schedule.sample(300, true, command, stamp));
+  EXPECT_EQ(200, stamp);
+  EXPECT_EQ(2.0, command[0]);
+  EXPECT_EQ(-1.0, command[1]);
+}
+
+TEST(TestCommandSchedule, drops_oldest_command_when_full)
+{
+  Schedule schedule;
+  for (int64_t i = 1; i <= 5; ++i)
+  {
+    schedule.insert(i * 100, {{static_cast<double>(i), 0.0}});
+  }
+  EXPECT_EQ(Schedule::capacity(), schedule.size());
+
+  Schedule::Command command;
+  int64_t stamp = 0;
+  EXPECT_FALSE(schedule.sample(150, false, command, stamp));
+  ASSERT_TRUE(schedule.sample(250, false, command, stamp));
+  EXPECT_EQ(2.0, command[0]);
+
+  // older than all scheduled commands
+  schedule.insert(50, {{0.5, 0.0}});
+  EXPECT_FALSE(schedule.sample(150, false, command, stamp));
+}
+
+TEST(TestCommandSchedule, drop_superseded_keeps_command_in_effect)
+{
+  Schedule schedule;
+  schedule.insert(100, {{1.0, 0.0}});
+  schedule.insert(200, {{2.0, 0.0}});
+  schedule.insert(300, {{3.0, 0.0}});
+
+  schedule.drop_superseded(50);
+  EXPECT_EQ(3u, schedule.size());
+
+  schedule.drop_superseded(250);
+  EXPECT_EQ(2u, schedule.size());
+  Schedule::Command command;
+  int64_t stamp = 0;
+  ASSERT_TRUE(schedule.sample(250, false, command, stamp));
+  EXPECT_EQ(200, stamp);
+  EXPECT_EQ(2.0, command[0]);
+
+  schedule.clear();
+  EXPECT_TRUE(schedule.empty());
+  EXPECT_FALSE(schedule.sample(250, false, command, stamp));
+}
@@ -0,0 +1,141 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "control_toolbox/rate_limiter.hpp"
+#include "ros2_controllers_utils/command_history.hpp"
+#include "ros2_controllers_utils/limiter.hpp"
+
+using ros2_controllers_utils::AxisLimits;
+using ros2_controllers_utils::CommandHistory;
+using ros2_controllers_utils::Limiter;
+using ros2_controllers_utils::make_rate_limits;
+
+namespace
+{
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+// Floating-point value comparison threshold
+const double EPS = 1e-12;
+}  // namespace
+
+TEST(TestLimiter, make_rate_limits_defaults)
+{
+  const auto limits = make_rate_limits(NaN, 2.0, NaN, 1.0, NaN, NaN, NaN, NaN);
+  EXPECT_EQ(-2.0, limits.min_value);
+  EXPECT_EQ(2.0, limits.max_value);
+  EXPECT_EQ(1.0, limits.max_first_derivative_pos);
+  EXPECT_EQ(-1.0, limits.min_first_derivative_neg);
+  EXPECT_EQ(-1.0, limits.min_first_derivative_pos);
+  EXPECT_EQ(1.0, limits.max_first_derivative_neg);
+  EXPECT_TRUE(std::isnan(limits.min_second_derivative));
+  EXPECT_TRUE(std::isnan(limits.max_second_derivative));
+}
+
+TEST(TestLimiter, make_rate_limits_throws_on_invalid_limits)
+{
+  EXPECT_THROW(make_rate_limits(3.0, 2.0, NaN, NaN, NaN, NaN, NaN, NaN), std::invalid_argument);
+  EXPECT_THROW(make_rate_limits(NaN, NaN, 2.0, 1.0, NaN, NaN, NaN, NaN), std::invalid_argument);
+  EXPECT_THROW(make_rate_limits(NaN, NaN, NaN, NaN, NaN, NaN, 2.0, 1.0), std::invalid_argument);
+  EXPECT_NO_THROW(make_rate_limits(NaN, NaN, NaN, NaN, NaN, NaN, NaN, NaN));
+}
+
+TEST(TestLimiter, limits_all_axes_with_history)
+{
+  Limiter<2> limiter(
+    {make_rate_limits(NaN, 1.0, NaN, 2.0, NaN, NaN, NaN, NaN),
+     make_rate_limits(NaN, NaN, NaN, NaN, NaN, NaN, NaN, NaN)});
+  CommandHistory<std::array<double, 2>, 2> history;
+  const double dt = 0.1;
+
+  std::array<double, 2> command{{5.0, 5.0}};
+  limiter.limit(command, history, dt);
+  EXPECT_NEAR(0.2, command[0], EPS);
+  EXPECT_NEAR(5.0, command[1], EPS);
+  history.push(command);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    command = {{5.0, -3.0}};
+    limiter.limit(command, history, dt);
+    history.push(command);
+  }
+  EXPECT_NEAR(1.0, command[0], EPS);
+  EXPECT_NEAR(-3.0, command[1], EPS);
+}
+
+TEST(TestLimiter, second_derivative)
+{
+  Limiter<1> limiter({make_rate_limits(NaN, NaN, NaN, NaN, NaN, NaN, NaN, 10.0)});
+  double v = 1.0;
+  limiter.limit(0, v, 0.0, 0.0, 0.1);
+  EXPECT_NEAR(0.1, v, EPS);
+}
+
+TEST(TestLimiter, symmetric_limits)
+{
+  AxisLimits limits;
+  limits.min_value = 0.0;
+  limits.max_value = 1.0;
+  limits.min_first_derivative_pos = 0.0;
+  limits.max_first_derivative_pos = 2.0;
+  limits.symmetric_value = true;
+  limits.symmetric_derivatives = true;
+  Limiter<1> limiter({limits});
+
+  // accelerating backwards is limited like accelerating forwards
+  double v = -5.0;
+  EXPECT_NEAR(0.04, limiter.limit(0, v, 0.0, 0.0, 0.1), EPS);
+  EXPECT_NEAR(-0.2, v, EPS);
+
+  v = -5.0;
+  limiter.limit(0, v, -0.9, -0.9, 0.1);
+  EXPECT_NEAR(-1.0, v, EPS);
+
+  // deceleration is not limited if no limits are set for it
+  v = 0.0;
+  EXPECT_NEAR(1.0, limiter.limit(0, v, -1.0, -1.0, 0.1), EPS);
+  EXPECT_NEAR(0.0, v, EPS);
+}
+
+TEST(TestLimiter, same_as_rate_limiter)
+{
+  control_toolbox::RateLimiter<double> rate_limiter(
+    -1.5, 2.0, -3.0, 2.0, -4.0, 5.0, -20.0, 30.0);
+  Limiter<1> limiter({make_rate_limits(-1.5, 2.0, -3.0, 2.0, -4.0, 5.0, -20.0, 30.0)});
+  CommandHistory<std::array<double, 1>, 2> history;
+  const double dt = 0.01;
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-3.0, 3.0);
+  for (int i = 0; i < 10000; ++i)
+  {
+    const double reference = distribution(generator);
+    const double v0 = history.previous(0)[0];
+    const double v1 = history.previous(1)[0];
+
+    double expected = reference;
+    rate_limiter.limit(expected, v0, v1, dt);
+    std::array<double, 1> command{{reference}};
+    limiter.limit(command, history, dt);
+    ASSERT_NEAR(expected, command[0], EPS) << "at cycle " << i;
+    history.push(command);
+  }
+}
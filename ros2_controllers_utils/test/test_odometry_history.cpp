@@ -0,0 +1,169 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "ros2_controllers_utils/odometry_history.hpp"
+
+using ros2_controllers_utils::OdometryHistory;
+using ros2_controllers_utils::OdometrySample;
+
+namespace
+{
+// Floating-point value comparison threshold
+const double EPS = 1e-9;
+
+OdometrySample make_sample(int64_t stamp)
+{
+  OdometrySample sample;
+  sample.stamp = stamp;
+  sample.x = 1e-9 * static_cast<double>(stamp);
+  sample.y = 2.0 * sample.x;
+  sample.heading = -sample.x;
+  sample.linear_x = 1.0;
+  sample.linear_y = 0.5;
+  sample.angular_z = sample.x;
+  return sample;
+}
+}  // namespace
+
+TEST(TestOdometryHistory, empty)
+{
+  OdometryHistory history;
+  OdometrySample sample;
+  history.push(make_sample(1));
+  EXPECT_EQ(0u, history.size());
+  EXPECT_FALSE(history.latest(sample));
+  EXPECT_FALSE(history.lookup(1, sample));
+
+  history.resize(4);
+  EXPECT_EQ(4u, history.capacity());
+  EXPECT_FALSE(history.lookup(1, sample));
+}
+
+TEST(TestOdometryHistory, lookup_interpolates)
+{
+  OdometryHistory history(10);
+  for (int64_t stamp = 1000000000; stamp <= 1050000000; stamp += 10000000)
+  {
+    history.push(make_sample(stamp));
+  }
+  EXPECT_EQ(6u, history.size());
+
+  OdometrySample sample;
+  ASSERT_TRUE(history.lookup(1025000000, sample));
+  EXPECT_EQ(1025000000, sample.stamp);
+  EXPECT_NEAR(1.025, sample.x, EPS);
+  EXPECT_NEAR(2.05, sample.y, EPS);
+  EXPECT_NEAR(-1.025, sample.heading, EPS);
+  EXPECT_NEAR(1.0, sample.linear_x, EPS);
+  EXPECT_NEAR(0.5, sample.linear_y, EPS);
+  EXPECT_NEAR(1.025, sample.angular_z, EPS);
+
+  // exactly at the first and the last sample
+  ASSERT_TRUE(history.lookup(1000000000, sample));
+  EXPECT_NEAR(1.0, sample.x, EPS);
+  ASSERT_TRUE(history.lookup(1050000000, sample));
+  EXPECT_NEAR(1.05, sample.x, EPS);
+  ASSERT_TRUE(history.latest(sample));
+  EXPECT_EQ(1050000000, sample.stamp);
+
+  // no extrapolation
+  EXPECT_FALSE(history.lookup(999999999, sample));
+  EXPECT_FALSE(history.lookup(1050000001, sample));
+}
+
+TEST(TestOdometryHistory, overwrites_oldest_samples)
+{
+  OdometryHistory history(3);
+  for (int64_t stamp = 1; stamp <= 5; ++stamp)
+  {
+    history.push(make_sample(stamp * 100));
+  }
+  EXPECT_EQ(3u, history.size());
+
+  OdometrySample sample;
+  EXPECT_FALSE(history.lookup(250, sample));
+  ASSERT_TRUE(history.lookup(350, sample));
+  EXPECT_NEAR(350e-9, sample.x, EPS);
+
+  // samples which are not newer than the latest one are ignored
+  history.push(make_sample(400));
+  ASSERT_TRUE(history.latest(sample));
+  EXPECT_EQ(500, sample.stamp);
+  EXPECT_TRUE(history.lookup(300, sample));
+}
+
+TEST(TestOdometryHistory, clear)
+{
+  OdometryHistory history(3);
+  history.push(make_sample(100));
+  history.push(make_sample(200));
+  history.clear();
+  EXPECT_EQ(0u, history.size());
+
+  OdometrySample sample;
+  EXPECT_FALSE(history.lookup(150, sample));
+  EXPECT_FALSE(history.latest(sample));
+
+  // the stamps may restart after clearing, e.g., after resetting the odometry
+  history.push(make_sample(50));
+  history.push(make_sample(60));
+  ASSERT_TRUE(history.lookup(55, sample));
+  EXPECT_NEAR(55e-9, sample.x, EPS);
+}
+
+TEST(TestOdometryHistory, concurrent_lookup)
+{
+  OdometryHistory history(16);
+  std::atomic<bool> done{false};
+  std::atomic<size_t> inconsistent{0};
+  std::atomic<size_t> found{0};
+
+  std::thread reader(
+    [&]()
+    {
+      OdometrySample sample;
+      while (!done.load())
+      {
+        OdometrySample latest;
+        if (history.latest(latest) && history.lookup(latest.stamp - 5, sample))
+        {
+          ++found;
+          // every interpolated sample has to be consistent, i.e., not mixed from partial writes
+          const auto expected = make_sample(sample.stamp);
+          if (
+            std::abs(sample.x - expected.x) > EPS || std::abs(sample.y - expected.y) > EPS ||
+            std::abs(sample.heading - expected.heading) > EPS)
+          {
+            ++inconsistent;
+          }
+        }
+      }
+    });
+
+  for (int64_t stamp = 10; stamp < 2000000; stamp += 10)
+  {
+    history.push(make_sample(stamp));
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(0u, inconsistent.load());
+  EXPECT_GT(found.load(), 0u);
+}
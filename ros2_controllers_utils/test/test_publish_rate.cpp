@@ -0,0 +1,64 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include "ros2_controllers_utils/publish_rate.hpp"
+
+using ros2_controllers_utils::get_initial_publish_timestamp;
+using ros2_controllers_utils::is_publish_due;
+
+TEST(TestPublishRate, zero_period_is_due_every_cycle)
+{
+  const auto period = rclcpp::Duration::from_nanoseconds(0);
+  const rclcpp::Time start(10, 0, RCL_ROS_TIME);
+  rclcpp::Time previous = get_initial_publish_timestamp(start, period);
+  EXPECT_TRUE(is_publish_due(period, previous, start));
+  EXPECT_TRUE(is_publish_due(period, previous, start));
+  EXPECT_EQ(previous, start);
+}
+
+TEST(TestPublishRate, due_in_first_cycle_and_then_at_period)
+{
+  const auto period = rclcpp::Duration::from_seconds(0.1);
+  const rclcpp::Time activation(10, 0, RCL_ROS_TIME);
+  rclcpp::Time previous = get_initial_publish_timestamp(activation, period);
+  EXPECT_EQ(previous.get_clock_type(), RCL_ROS_TIME);
+
+  const auto cycle = rclcpp::Duration::from_seconds(0.04);
+  EXPECT_TRUE(is_publish_due(period, previous, activation + cycle));
+  EXPECT_FALSE(is_publish_due(period, previous, activation + cycle + cycle));
+  EXPECT_TRUE(is_publish_due(period, previous, activation + cycle + cycle + cycle));
+  EXPECT_EQ(previous, activation + period);
+}
+
+TEST(TestPublishRate, initial_timestamp_before_zero_time)
+{
+  // e.g., simulation time starting at zero
+  const auto period = rclcpp::Duration::from_seconds(0.1);
+  const rclcpp::Time activation(0, 0, RCL_ROS_TIME);
+  rclcpp::Time previous = get_initial_publish_timestamp(activation, period);
+  EXPECT_TRUE(is_publish_due(period, previous, rclcpp::Time(0, 1, RCL_ROS_TIME)));
+  EXPECT_FALSE(is_publish_due(period, previous, rclcpp::Time(0, 50000000, RCL_ROS_TIME)));
+}
+
+TEST(TestPublishRate, changed_time_source_restarts_period)
+{
+  const auto period = rclcpp::Duration::from_seconds(0.1);
+  rclcpp::Time previous(0, 0, RCL_CLOCK_UNINITIALIZED);
+  const rclcpp::Time time(10, 0, RCL_ROS_TIME);
+  EXPECT_TRUE(is_publish_due(period, previous, time));
+  EXPECT_EQ(previous, time);
+  EXPECT_FALSE(is_publish_due(period, previous, time + rclcpp::Duration::from_seconds(0.05)));
+}
@@ -0,0 +1,42 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <limits>
+
+#include "ros2_controllers_utils/stamped_command.hpp"
+
+using ros2_controllers_utils::StampedCommand;
+
+TEST(TestStampedCommand, reset_marks_missing_command)
+{
+  StampedCommand<3> command{5, {{1.0, 2.0, 3.0}}};
+  EXPECT_TRUE(command.is_finite());
+  EXPECT_FALSE(command.has_nan());
+
+  command.reset(10);
+  EXPECT_EQ(10, command.stamp);
+  for (const auto value : command.values)
+  {
+    EXPECT_TRUE(std::isnan(value));
+  }
+  EXPECT_FALSE(command.is_finite());
+  EXPECT_TRUE(command.has_nan());
+
+  command.values = {{1.0, std::numeric_limits<double>::infinity(), 0.0}};
+  EXPECT_FALSE(command.is_finite());
+  EXPECT_FALSE(command.has_nan());
+}
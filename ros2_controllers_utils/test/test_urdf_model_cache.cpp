@@ -0,0 +1,50 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "ros2_control_test_assets/descriptions.hpp"
+#include "ros2_controllers_utils/urdf_model_cache.hpp"
+
+using ros2_controllers_utils::get_urdf_model;
+using ros2_controllers_utils::get_urdf_model_cache_size;
+
+TEST(TestUrdfModelCache, same_description_shares_model)
+{
+  {
+    const auto model = get_urdf_model(ros2_control_test_assets::minimal_robot_urdf);
+    ASSERT_NE(model, nullptr);
+    EXPECT_NE(model->getJoint("joint1"), nullptr);
+    EXPECT_EQ(model, get_urdf_model(ros2_control_test_assets::minimal_robot_urdf));
+    EXPECT_EQ(1u, get_urdf_model_cache_size());
+
+    const auto other_model = get_urdf_model(
+      std::string(ros2_control_test_assets::urdf_head) +
+      std::string(ros2_control_test_assets::urdf_tail));
+    ASSERT_NE(other_model, nullptr);
+    EXPECT_NE(model, other_model);
+    EXPECT_EQ(2u, get_urdf_model_cache_size());
+  }
+  // models are released with the last reference
+  EXPECT_EQ(0u, get_urdf_model_cache_size());
+}
+
+TEST(TestUrdfModelCache, invalid_description)
+{
+  EXPECT_EQ(get_urdf_model(""), nullptr);
+  EXPECT_EQ(get_urdf_model("<robot"), nullptr);
+  EXPECT_EQ(0u, get_urdf_model_cache_size());
+}
@@ -0,0 +1,146 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ros2_controllers_utils/velocity_estimator.hpp"
+
+using ros2_controllers_utils::VelocityEstimator;
+
+namespace
+{
+// Floating-point value comparison threshold
+const double EPS = 1e-9;
+}  // namespace
+
+TEST(TestVelocityEstimator, type_from_string)
+{
+  VelocityEstimator::Type type = VelocityEstimator::Type::ROLLING_MEAN;
+  EXPECT_TRUE(VelocityEstimator::type_from_string("butterworth", type));
+  EXPECT_EQ(VelocityEstimator::Type::BUTTERWORTH, type);
+  EXPECT_TRUE(VelocityEstimator::type_from_string("exponential", type));
+  EXPECT_EQ(VelocityEstimator::Type::EXPONENTIAL, type);
+  EXPECT_TRUE(VelocityEstimator::type_from_string("rolling_mean", type));
+  EXPECT_EQ(VelocityEstimator::Type::ROLLING_MEAN, type);
+  EXPECT_FALSE(VelocityEstimator::type_from_string("kalman", type));
+  EXPECT_EQ(VelocityEstimator::Type::ROLLING_MEAN, type);
+}
+
+TEST(TestVelocityEstimator, rolling_mean)
+{
+  VelocityEstimator estimator(VelocityEstimator::Type::ROLLING_MEAN, 3);
+  EXPECT_EQ(0.0, estimator.get_estimate());
+
+  // mean of the samples so far until the window is filled
+  estimator.accumulate(1.0);
+  EXPECT_NEAR(1.0, estimator.get_estimate(), EPS);
+  estimator.accumulate(2.0);
+  EXPECT_NEAR(1.5, estimator.get_estimate(), EPS);
+
+  const std::vector<double> samples = {3.0, -4.0, 10.0, 0.5};
+  std::vector<double> all = {1.0, 2.0};
+  for (const auto sample : samples)
+  {
+    estimator.accumulate(sample);
+    all.push_back(sample);
+    const size_t n = all.size();
+    EXPECT_NEAR((all[n - 1] + all[n - 2] + all[n - 3]) / 3.0, estimator.get_estimate(), EPS);
+  }
+
+  // reset drops all samples
+  estimator.reset();
+  EXPECT_EQ(0.0, estimator.get_estimate());
+  estimator.accumulate(7.0);
+  EXPECT_NEAR(7.0, estimator.get_estimate(), EPS);
+}
+
+TEST(TestVelocityEstimator, exponential)
+{
+  VelocityEstimator estimator(VelocityEstimator::Type::EXPONENTIAL, 3);
+  estimator.accumulate(2.0);
+  EXPECT_NEAR(2.0, estimator.get_estimate(), EPS);
+  // smoothing factor 2 / (3 + 1)
+  estimator.accumulate(4.0);
+  EXPECT_NEAR(3.0, estimator.get_estimate(), EPS);
+  estimator.accumulate(4.0);
+  EXPECT_NEAR(3.5, estimator.get_estimate(), EPS);
+
+  estimator.reset();
+  EXPECT_EQ(0.0, estimator.get_estimate());
+  estimator.accumulate(-1.0);
+  EXPECT_NEAR(-1.0, estimator.get_estimate(), EPS);
+}
+
+TEST(TestVelocityEstimator, butterworth)
+{
+  VelocityEstimator estimator(VelocityEstimator::Type::BUTTERWORTH, 10);
+
+  // starts in the steady state of the first sample
+  for (int i = 0; i < 5; ++i)
+  {
+    estimator.accumulate(1.0);
+    EXPECT_NEAR(1.0, estimator.get_estimate(), EPS);
+  }
+
+  // converges to a step of the input
+  for (int i = 0; i < 200; ++i)
+  {
+    estimator.accumulate(2.0);
+  }
+  EXPECT_NEAR(2.0, estimator.get_estimate(), 1e-6);
+
+  // removes noise at half the sample rate, as the rolling mean of an even window size
+  estimator.reset();
+  VelocityEstimator rolling_mean(VelocityEstimator::Type::ROLLING_MEAN, 10);
+  double max_error = 0.0;
+  double max_error_rolling_mean = 0.0;
+  for (int i = 0; i < 200; ++i)
+  {
+    const double sample = 1.0 + (i % 2 == 0 ? 0.5 : -0.5);
+    estimator.accumulate(sample);
+    rolling_mean.accumulate(sample);
+    if (i >= 100)
+    {
+      max_error = std::max(max_error, std::abs(estimator.get_estimate() - 1.0));
+      max_error_rolling_mean =
+        std::max(max_error_rolling_mean, std::abs(rolling_mean.get_estimate() - 1.0));
+    }
+  }
+  EXPECT_LT(max_error, 1e-3);
+  EXPECT_LT(max_error_rolling_mean, 1e-9);
+}
+
+TEST(TestVelocityEstimator, configure_changes_type)
+{
+  VelocityEstimator estimator;
+  EXPECT_EQ(VelocityEstimator::Type::ROLLING_MEAN, estimator.type());
+  estimator.accumulate(5.0);
+
+  estimator.configure(VelocityEstimator::Type::EXPONENTIAL, 1);
+  EXPECT_EQ(VelocityEstimator::Type::EXPONENTIAL, estimator.type());
+  EXPECT_EQ(0.0, estimator.get_estimate());
+  // window size of one follows the input
+  estimator.accumulate(1.0);
+  estimator.accumulate(3.0);
+  EXPECT_NEAR(3.0, estimator.get_estimate(), EPS);
+
+  // window size of zero is treated as one
+  estimator.configure(VelocityEstimator::Type::ROLLING_MEAN, 0);
+  estimator.accumulate(1.0);
+  estimator.accumulate(3.0);
+  EXPECT_NEAR(3.0, estimator.get_estimate(), EPS);
+}
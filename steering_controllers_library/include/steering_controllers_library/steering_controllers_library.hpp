@@ -15,7 +15,10 @@
 #ifndef STEERING_CONTROLLERS_LIBRARY__STEERING_CONTROLLERS_LIBRARY_HPP_
 #define STEERING_CONTROLLERS_LIBRARY__STEERING_CONTROLLERS_LIBRARY_HPP_
 
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +28,10 @@
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "realtime_tools/realtime_thread_safe_box.hpp"
+#include "ros2_controllers_utils/command_history.hpp"
+#include "ros2_controllers_utils/command_schedule.hpp"
+#include "ros2_controllers_utils/limiter.hpp"
+#include "ros2_controllers_utils/stamped_command.hpp"
 
 // TODO(anyone): Replace with controller specific messages
 #include "control_msgs/msg/steering_controller_status.hpp"
@@ -69,7 +76,21 @@ public:
   controller_interface::return_type update_and_write_commands(
     const rclcpp::Time & time, const rclcpp::Duration & period) override;
 
+  /**
+   * \brief Get the odometry at a past point in time, interpolated from the odometry history.
+   *
+   * The size of the history is set with the ``odom_history_size`` parameter. Lock-free, can be
+   * called from any thread while the controller is configured, e.g., by a localization running in
+   * the same process.
+   *
+   * \return false if \p time is not covered by the history.
+   */
+  bool get_odometry_at(
+    const rclcpp::Time & time, ros2_controllers_utils::OdometrySample & sample) const;
+
   using ControllerTwistReferenceMsg = geometry_msgs::msg::TwistStamped;
+  // linear.x and angular.z of a reference message, without its header
+  using Reference = ros2_controllers_utils::StampedCommand<2>;
   using ControllerStateMsgOdom = nav_msgs::msg::Odometry;
   using ControllerStateMsgTf = tf2_msgs::msg::TFMessage;
   using SteeringControllerStateMsg = control_msgs::msg::SteeringControllerStatus;
@@ -81,10 +102,19 @@ protected:
   std::shared_ptr<steering_controllers_library::ParamListener> param_listener_;
   steering_controllers_library::Params params_;
 
-  // the RT Box containing the command message
-  realtime_tools::RealtimeThreadSafeBox<ControllerTwistReferenceMsg> input_ref_;
+  // the RT Box containing the reference of the last command message
+  realtime_tools::RealtimeThreadSafeBox<Reference> input_ref_;
   // save the last reference in case of unable to get value from box
-  ControllerTwistReferenceMsg current_ref_;
+  Reference current_ref_;
+
+  // references ordered by their stamps, used instead of input_ref_ with schedule_reference
+  using ReferenceSchedule = ros2_controllers_utils::CommandSchedule<2, 16>;
+  // written by the subscriber only
+  ReferenceSchedule pending_references_;
+  realtime_tools::RealtimeThreadSafeBox<ReferenceSchedule> received_reference_schedule_;
+  // copy of the schedule in the realtime loop, and stamp of the reference last taken from it
+  ReferenceSchedule reference_schedule_;
+  int64_t applied_reference_stamp_ = std::numeric_limits<int64_t>::min();
   rclcpp::Duration ref_timeout_ = rclcpp::Duration::from_seconds(0.0);  // 0ms
 
   // Command subscribers and Controller State publisher
@@ -101,6 +131,8 @@ protected:
   // override methods from ChainableControllerInterface
   std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
 
+  std::vector<hardware_interface::StateInterface> on_export_state_interfaces() override;
+
   bool on_set_chained_mode(bool chained_mode) override;
 
   /// Odometry:
@@ -111,6 +143,14 @@ protected:
   using ControllerStatePublisher = realtime_tools::RealtimePublisher<SteeringControllerStateMsg>;
   rclcpp::Publisher<SteeringControllerStateMsg>::SharedPtr controller_s_publisher_;
   std::unique_ptr<ControllerStatePublisher> controller_state_publisher_;
+  // period of the controller state message, published in every update cycle if zero
+  rclcpp::Duration controller_state_publish_period_ = rclcpp::Duration::from_nanoseconds(0);
+  rclcpp::Time controller_state_previous_publish_timestamp_{0, 0, RCL_CLOCK_UNINITIALIZED};
+  // offset of the steering joints in the state and command interfaces, after the traction joints
+  size_t steering_itfs_offset_ = 0;
+  // field of the state message with the traction feedback, position or velocity
+  std::vector<double> SteeringControllerStateMsg::* state_msg_traction_feedback_ =
+    &SteeringControllerStateMsg::traction_wheels_velocity;
 
   // name constants for state interfaces
   size_t nr_state_itfs_;
@@ -123,12 +163,22 @@ protected:
   double last_linear_velocity_ = 0.0;
   double last_angular_velocity_ = 0.0;
 
+  // speed limiter of the linear (index 0) and angular (index 1) velocity reference
+  ros2_controllers_utils::Limiter<2> limiter_;
+  ros2_controllers_utils::CommandHistory<std::array<double, 2>, 2> previous_commands_;
+
+  // wheel commands of the inverse kinematics, traction and steering
+  steering_odometry::SteeringKinematics::WheelValues traction_commands_;
+  steering_odometry::SteeringKinematics::WheelValues steering_commands_;
+
   std::vector<std::string> traction_joints_state_names_;
   std::vector<std::string> steering_joints_state_names_;
 
 private:
   // callback for topic interface
   void reference_callback(const std::shared_ptr<ControllerTwistReferenceMsg> msg);
+  /// Reduce \p msg to the values used by the controller, called from the subscriber.
+  static Reference to_reference(const ControllerTwistReferenceMsg & msg);
 };
 
 }  // namespace steering_controllers_library
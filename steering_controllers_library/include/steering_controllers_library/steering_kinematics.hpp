@@ -0,0 +1,105 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef STEERING_CONTROLLERS_LIBRARY__STEERING_KINEMATICS_HPP_
+#define STEERING_CONTROLLERS_LIBRARY__STEERING_KINEMATICS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace steering_odometry
+{
+/// Wheel of the layout table, see SteeringKinematics.
+struct Wheel
+{
+  /// Position of the contact point in the base frame, x pointing forward and y to the left [m]
+  double x = 0.0;
+  double y = 0.0;
+  /// The wheel has a steering joint
+  bool steering = false;
+  /// The wheel has a traction joint
+  bool traction = false;
+};
+
+/**
+ * \brief Kinematics of a mobile base with steered and driven wheels, given as a wheel-layout table.
+ *
+ * The table is compiled once, when the parameters are set. The realtime methods do not branch on
+ * the type of the base and do not allocate memory: the inverse kinematics is a closed form per
+ * wheel. The odometry stays the closed form of the type in SteeringOdometry.
+ *
+ * Traction and steering values are ordered like the traction and steering wheels in the table.
+ */
+class SteeringKinematics
+{
+public:
+  static constexpr size_t MAX_WHEELS = 8;
+
+  /// Fixed-capacity storage of a value per wheel, e.g., the commands of the traction wheels
+  using WheelValues = std::array<double, MAX_WHEELS>;
+
+  /**
+   * \brief Compiles the wheel-layout table.
+   * \param wheels Wheel layout, at most MAX_WHEELS wheels with at least one traction wheel
+   * \param wheel_radius Radius of the traction wheels [m]
+   * \throw std::invalid_argument if the layout is not supported
+   */
+  void configure(const std::vector<Wheel> & wheels, const double wheel_radius);
+
+  size_t get_traction_size() const { return traction_size_; }
+
+  size_t get_steering_size() const { return steering_size_; }
+
+  /**
+   * \brief Calculates the wheel commands of a body twist.
+   *
+   * Each steering wheel is turned to the direction of its contact point velocity, flipped to the
+   * direction of travel of the base. Steering wheels with traction keep within +-pi/2 and drive
+   * backwards instead. Traction wheels without steering joint roll with the contact
+   * point velocity of \p traction_omega_bz instead of \p omega_bz, which lets the caller account
+   * for the measured steering angle; steered traction wheels always follow the commanded twist.
+   *
+   * \param v_bx Linear velocity of the base in x_b-axis direction [m/s]
+   * \param omega_bz Angular velocity of the base around z_b-axis [rad/s]
+   * \param traction_omega_bz Angular velocity for the traction wheels without steering [rad/s]
+   * \param traction_commands Velocities of the traction wheels [rad/s]
+   * \param steering_commands Angles of the steering wheels [rad]
+   */
+  void inverse(
+    const double v_bx, const double omega_bz, const double traction_omega_bz,
+    double * traction_commands, double * steering_commands) const;
+
+private:
+  /// Compiled wheel of the layout table.
+  struct CompiledWheel
+  {
+    double x = 0.0;
+    double y = 0.0;
+    /// Index of the steering value, or MAX_WHEELS if the wheel is not steered
+    size_t steering_index = MAX_WHEELS;
+    /// Index of the traction value, or MAX_WHEELS if the wheel is not driven
+    size_t traction_index = MAX_WHEELS;
+  };
+
+  std::array<CompiledWheel, MAX_WHEELS> wheels_;
+  size_t size_ = 0;
+  size_t traction_size_ = 0;
+  size_t steering_size_ = 0;
+  double inverse_wheel_radius_ = 0.0;
+};
+
+}  // namespace steering_odometry
+
+#endif  // STEERING_CONTROLLERS_LIBRARY__STEERING_KINEMATICS_HPP_
@@ -18,18 +18,16 @@
 #ifndef STEERING_CONTROLLERS_LIBRARY__STEERING_ODOMETRY_HPP_
 #define STEERING_CONTROLLERS_LIBRARY__STEERING_ODOMETRY_HPP_
 
+#include <array>
 #include <cmath>
 #include <tuple>
 #include <vector>
 
 #include <rclcpp/time.hpp>
 
-// \note The versions conditioning is added here to support the source-compatibility with Humble
-#if RCPPUTILS_VERSION_MAJOR >= 2 && RCPPUTILS_VERSION_MINOR >= 6
-#include "rcpputils/rolling_mean_accumulator.hpp"
-#else
-#include "rcppmath/rolling_mean_accumulator.hpp"
-#endif
+#include "ros2_controllers_utils/odometry_history.hpp"
+#include "ros2_controllers_utils/velocity_estimator.hpp"
+#include "steering_controllers_library/steering_kinematics.hpp"
 
 namespace steering_odometry
 {
@@ -140,7 +138,10 @@ public:
   void update_open_loop(const double v_bx, const double omega_bz, const double dt);
 
   /**
-   * \brief Set odometry type
+   * \brief Set odometry type, and compiles the wheel layout of the type
+   *
+   * set_wheel_layout() sets other layouts.
+   *
    * \param type odometry type
    */
   void set_odometry_type(const unsigned int type);
@@ -194,12 +195,53 @@ public:
     const double wheel_radius, const double wheel_base, const double wheel_track_steering,
     const double wheel_track_traction);
 
+  /**
+   * \brief Sets a custom wheel layout, replacing the one of the odometry type
+   *
+   * Call after set_wheel_params() and set_odometry_type(), which compile the layout of the odometry
+   * type again.
+   *
+   * \param wheels Wheel layout, see SteeringKinematics
+   * \throw std::invalid_argument if the layout is not supported
+   */
+  void set_wheel_layout(const std::vector<Wheel> & wheels);
+
+  /**
+   * \brief Kinematics compiled from the wheel layout
+   * \return SteeringKinematics, e.g., for the number of traction and steering wheels
+   */
+  const SteeringKinematics & get_kinematics() const { return kinematics_; }
+
   /**
    * \brief Velocity rolling window size setter
    * \param velocity_rolling_window_size Velocity rolling window size
    */
   void set_velocity_rolling_window_size(const size_t velocity_rolling_window_size);
 
+  /**
+   * \brief Velocity estimator type setter
+   * \param type Filter of the linear and angular velocity, see VelocityEstimator
+   */
+  void set_velocity_estimator_type(const ros2_controllers_utils::VelocityEstimator::Type type);
+
+  /**
+   * \brief Odometry history size setter, allocates memory
+   * \param history_size Number of timestamped samples kept, 0 disables the history
+   */
+  void set_history_size(const size_t history_size);
+
+  /**
+   * \brief Stores the current pose and velocity in the history
+   * \param time Time of the last odometry update
+   */
+  void push_history(const rclcpp::Time & time);
+
+  /**
+   * \brief History of the odometry, can be queried from any thread
+   * \return OdometryHistory, see OdometryHistory::lookup()
+   */
+  const ros2_controllers_utils::OdometryHistory & get_history() const { return history_; }
+
   /**
    * \brief Calculates inverse kinematics for the desired linear and angular velocities
    * \param v_bx     Desired linear velocity of the robot in x_b-axis direction
@@ -213,6 +255,27 @@ public:
     const double v_bx, const double omega_bz, const bool open_loop = true,
     const bool reduce_wheel_speed_until_steering_reached = false);
 
+  /**
+   * \brief Calculates inverse kinematics for the desired linear and angular velocities
+   *
+   * Does not allocate memory and can be used in the realtime loop.
+   *
+   * \param v_bx     Desired linear velocity of the robot in x_b-axis direction
+   * \param omega_bz Desired angular velocity of the robot around x_z-axis
+   * \param open_loop If false, the IK will be calculated using measured steering angle
+   * \param reduce_wheel_speed_until_steering_reached Reduce wheel speed until the steering angle
+   * has been reached
+   * \param traction_commands Velocity commands, the first get_kinematics().get_traction_size()
+   * values are set
+   * \param steering_commands Steering commands, the first get_kinematics().get_steering_size()
+   * values are set
+   */
+  void get_commands(
+    const double v_bx, const double omega_bz, const bool open_loop,
+    const bool reduce_wheel_speed_until_steering_reached,
+    SteeringKinematics::WheelValues & traction_commands,
+    SteeringKinematics::WheelValues & steering_commands);
+
   /**
    *  \brief Reset poses, heading, and accumulators
    */
@@ -265,12 +328,10 @@ private:
    */
   void reset_accumulators();
 
-// \note The versions conditioning is added here to support the source-compatibility with Humble
-#if RCPPUTILS_VERSION_MAJOR >= 2 && RCPPUTILS_VERSION_MINOR >= 6
-  using RollingMeanAccumulator = rcpputils::RollingMeanAccumulator<double>;
-#else
-  using RollingMeanAccumulator = rcppmath::RollingMeanAccumulator<double>;
-#endif
+  /**
+   *  \brief Compiles the wheel layout of the odometry type from the wheel parameters
+   */
+  void configure_kinematics();
 
   /// Current timestamp:
   rclcpp::Time timestamp_;
@@ -290,18 +351,29 @@ private:
   double wheel_track_steering_;  // [m]
   double wheel_base_;            // [m]
   double wheel_radius_;          // [m]
+  double inverse_wheel_base_;    // [1/m]
 
   /// Configuration type used for the forward kinematics
   int config_type_ = -1;
 
+  /// Kinematics compiled from the wheel layout, used for the inverse kinematics of all types
+  SteeringKinematics kinematics_;
+
+  /// While the steering is straight, all steering wheels get the angle of the virtual center wheel
+  bool parallel_steering_when_straight_ = false;
+
   /// Previous wheel position/state [rad]:
   double traction_wheel_old_pos_;
   double traction_right_wheel_old_pos_;
   double traction_left_wheel_old_pos_;
-  /// Rolling mean accumulators for the linear and angular velocities:
+  /// Filters of the linear and angular velocities:
   size_t velocity_rolling_window_size_;
-  RollingMeanAccumulator linear_acc_;
-  RollingMeanAccumulator angular_acc_;
+  ros2_controllers_utils::VelocityEstimator::Type velocity_estimator_type_;
+  ros2_controllers_utils::VelocityEstimator linear_acc_;
+  ros2_controllers_utils::VelocityEstimator angular_acc_;
+
+  /// Timestamped poses and velocities for lookups at past points in time:
+  ros2_controllers_utils::OdometryHistory history_;
 };
 }  // namespace steering_odometry
 
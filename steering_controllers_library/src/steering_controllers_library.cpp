@@ -16,11 +16,13 @@
 
 #include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "ros2_controllers_utils/publish_rate.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
 namespace
@@ -29,19 +31,6 @@ namespace
 using ControllerTwistReferenceMsg =
   steering_controllers_library::SteeringControllersLibrary::ControllerTwistReferenceMsg;
 
-// called from RT control loop
-void reset_controller_reference_msg(
-  ControllerTwistReferenceMsg & msg, const std::shared_ptr<rclcpp_lifecycle::LifecycleNode> & node)
-{
-  msg.header.stamp = node->now();
-  msg.twist.linear.x = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.linear.y = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.linear.z = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
-  msg.twist.angular.z = std::numeric_limits<double>::quiet_NaN();
-}
-
 }  // namespace
 
 namespace steering_controllers_library
@@ -84,115 +73,83 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_configure(
   // call method from implementations, sets odometry type
   configure_odometry();
 
-  // Check if the number of traction joints is correct
-  if (odometry_.get_odometry_type() == steering_odometry::BICYCLE_CONFIG)
-  {
-    if (params_.traction_joints_names.size() != 1)
-    {
-      RCLCPP_ERROR(
-        get_node()->get_logger(),
-        "Bicycle configuration requires exactly one traction joint, but %zu were provided",
-        params_.traction_joints_names.size());
-      return controller_interface::CallbackReturn::ERROR;
-    }
-  }
-  else if (odometry_.get_odometry_type() == steering_odometry::TRICYCLE_CONFIG)
-  {
-    if (params_.traction_joints_names.size() != 2)
-    {
-      RCLCPP_ERROR(
-        get_node()->get_logger(),
-        "Tricycle configuration requires exactly two traction joints, but %zu were provided",
-        params_.traction_joints_names.size());
-      return controller_interface::CallbackReturn::ERROR;
-    }
-  }
-  else if (odometry_.get_odometry_type() == steering_odometry::ACKERMANN_CONFIG)
+  try
   {
-    if (params_.traction_joints_names.size() != 2)
-    {
-      RCLCPP_ERROR(
-        get_node()->get_logger(),
-        "Ackermann configuration requires exactly two traction joints, but %zu were provided",
-        params_.traction_joints_names.size());
-      return controller_interface::CallbackReturn::ERROR;
-    }
+    limiter_ = ros2_controllers_utils::Limiter<2>(
+      {ros2_controllers_utils::make_rate_limits(
+         params_.linear.x.min_velocity, params_.linear.x.max_velocity,
+         params_.linear.x.max_acceleration_reverse, params_.linear.x.max_acceleration,
+         params_.linear.x.max_deceleration, params_.linear.x.max_deceleration_reverse,
+         params_.linear.x.min_jerk, params_.linear.x.max_jerk),
+       ros2_controllers_utils::make_rate_limits(
+         params_.angular.z.min_velocity, params_.angular.z.max_velocity,
+         params_.angular.z.max_acceleration_reverse, params_.angular.z.max_acceleration,
+         params_.angular.z.max_deceleration, params_.angular.z.max_deceleration_reverse,
+         params_.angular.z.min_jerk, params_.angular.z.max_jerk)});
+  }
+  catch (const std::invalid_argument & e)
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Error configuring speed limiter: %s", e.what());
+    return controller_interface::CallbackReturn::ERROR;
   }
-  // Check if the number of steering joints is correct
-  if (odometry_.get_odometry_type() == steering_odometry::BICYCLE_CONFIG)
+
+  // Check if the number of joints matches the wheel layout of the odometry type
+  const size_t nr_traction_wheels = odometry_.get_kinematics().get_traction_size();
+  const size_t nr_steering_wheels = odometry_.get_kinematics().get_steering_size();
+  if (nr_traction_wheels == 0)
   {
-    if (params_.steering_joints_names.size() != 1)
-    {
-      RCLCPP_ERROR(
-        get_node()->get_logger(),
-        "Bicycle configuration requires exactly one steering joint, but %zu were provided",
-        params_.steering_joints_names.size());
-      return controller_interface::CallbackReturn::ERROR;
-    }
+    RCLCPP_ERROR(
+      get_node()->get_logger(),
+      "The wheel layout of odometry type %u is not configured, check the wheel parameters",
+      odometry_.get_odometry_type());
+    return controller_interface::CallbackReturn::ERROR;
   }
-  else if (odometry_.get_odometry_type() == steering_odometry::TRICYCLE_CONFIG)
+  if (params_.traction_joints_names.size() != nr_traction_wheels)
   {
-    if (params_.steering_joints_names.size() != 1)
-    {
-      RCLCPP_ERROR(
-        get_node()->get_logger(),
-        "Tricycle configuration requires exactly one steering joint, but %zu were provided",
-        params_.steering_joints_names.size());
-      return controller_interface::CallbackReturn::ERROR;
-    }
+    RCLCPP_ERROR(
+      get_node()->get_logger(),
+      "The wheel layout requires %zu traction joints, but %zu were provided", nr_traction_wheels,
+      params_.traction_joints_names.size());
+    return controller_interface::CallbackReturn::ERROR;
   }
-  else if (odometry_.get_odometry_type() == steering_odometry::ACKERMANN_CONFIG)
+  if (params_.steering_joints_names.size() != nr_steering_wheels)
   {
-    if (params_.steering_joints_names.size() != 2)
-    {
-      RCLCPP_ERROR(
-        get_node()->get_logger(),
-        "Ackermann configuration requires exactly two steering joints, but %zu were provided",
-        params_.steering_joints_names.size());
-      return controller_interface::CallbackReturn::ERROR;
-    }
+    RCLCPP_ERROR(
+      get_node()->get_logger(),
+      "The wheel layout requires %zu steering joints, but %zu were provided", nr_steering_wheels,
+      params_.steering_joints_names.size());
+    return controller_interface::CallbackReturn::ERROR;
   }
 
   odometry_.set_velocity_rolling_window_size(
     static_cast<size_t>(params_.velocity_rolling_window_size));
 
+  ros2_controllers_utils::VelocityEstimator::Type velocity_estimator_type;
+  if (!ros2_controllers_utils::VelocityEstimator::type_from_string(
+        params_.velocity_estimator, velocity_estimator_type))
+  {
+    RCLCPP_ERROR(
+      get_node()->get_logger(), "Unknown velocity estimator '%s'",
+      params_.velocity_estimator.c_str());
+    return controller_interface::CallbackReturn::ERROR;
+  }
+  odometry_.set_velocity_estimator_type(velocity_estimator_type);
+  odometry_.set_history_size(static_cast<size_t>(params_.odom_history_size));
+
+  // Allocate state interfaces for the odometry: x, y, yaw, linear and angular velocity
+  const size_t nr_odom_state_itfs = 5;
+  state_interfaces_values_.resize(nr_odom_state_itfs, std::numeric_limits<double>::quiet_NaN());
+
   if (!params_.traction_joints_state_names.empty())
   {
-    if (odometry_.get_odometry_type() == steering_odometry::BICYCLE_CONFIG)
+    if (params_.traction_joints_state_names.size() != nr_traction_wheels)
     {
-      if (params_.traction_joints_state_names.size() != 1)
-      {
-        RCLCPP_ERROR(
-          get_node()->get_logger(),
-          "Bicycle configuration requires exactly one traction joint, but %zu state interface "
-          "names were provided",
-          params_.traction_joints_state_names.size());
-        return controller_interface::CallbackReturn::ERROR;
-      }
-    }
-    else if (odometry_.get_odometry_type() == steering_odometry::TRICYCLE_CONFIG)
-    {
-      if (params_.traction_joints_state_names.size() != 2)
-      {
-        RCLCPP_ERROR(
-          get_node()->get_logger(),
-          "Tricycle configuration requires exactly two traction joints, but %zu state interface "
-          "names were provided",
-          params_.traction_joints_state_names.size());
-        return controller_interface::CallbackReturn::ERROR;
-      }
-    }
-    else if (odometry_.get_odometry_type() == steering_odometry::ACKERMANN_CONFIG)
-    {
-      if (params_.traction_joints_state_names.size() != 2)
-      {
-        RCLCPP_ERROR(
-          get_node()->get_logger(),
-          "Ackermann configuration requires exactly two traction joints, but %zu state interface "
-          "names were provided",
-          params_.traction_joints_state_names.size());
-        return controller_interface::CallbackReturn::ERROR;
-      }
+      RCLCPP_ERROR(
+        get_node()->get_logger(),
+        "The wheel layout requires %zu traction joints, but %zu state interface names were "
+        "provided",
+        nr_traction_wheels, params_.traction_joints_state_names.size());
+      return controller_interface::CallbackReturn::ERROR;
     }
     traction_joints_state_names_ = params_.traction_joints_state_names;
   }
@@ -203,41 +160,14 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_configure(
 
   if (!params_.steering_joints_state_names.empty())
   {
-    if (odometry_.get_odometry_type() == steering_odometry::BICYCLE_CONFIG)
+    if (params_.steering_joints_state_names.size() != nr_steering_wheels)
     {
-      if (params_.steering_joints_state_names.size() != 1)
-      {
-        RCLCPP_ERROR(
-          get_node()->get_logger(),
-          "Bicycle configuration requires exactly one steering joint, but %zu state interface "
-          "names were provided",
-          params_.steering_joints_state_names.size());
-        return controller_interface::CallbackReturn::ERROR;
-      }
-    }
-    else if (odometry_.get_odometry_type() == steering_odometry::TRICYCLE_CONFIG)
-    {
-      if (params_.steering_joints_state_names.size() != 1)
-      {
-        RCLCPP_ERROR(
-          get_node()->get_logger(),
-          "Tricycle configuration requires exactly one steering joint, but %zu state interface "
-          "names were provided",
-          params_.steering_joints_state_names.size());
-        return controller_interface::CallbackReturn::ERROR;
-      }
-    }
-    else if (odometry_.get_odometry_type() == steering_odometry::ACKERMANN_CONFIG)
-    {
-      if (params_.steering_joints_state_names.size() != 2)
-      {
-        RCLCPP_ERROR(
-          get_node()->get_logger(),
-          "Ackermann configuration requires exactly two steering joints, but %zu state interface "
-          "names were provided",
-          params_.steering_joints_state_names.size());
-        return controller_interface::CallbackReturn::ERROR;
-      }
+      RCLCPP_ERROR(
+        get_node()->get_logger(),
+        "The wheel layout requires %zu steering joints, but %zu state interface names were "
+        "provided",
+        nr_steering_wheels, params_.steering_joints_state_names.size());
+      return controller_interface::CallbackReturn::ERROR;
     }
     steering_joints_state_names_ = params_.steering_joints_state_names;
   }
@@ -257,7 +187,7 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_configure(
     "~/reference", subscribers_qos,
     std::bind(&SteeringControllersLibrary::reference_callback, this, std::placeholders::_1));
 
-  reset_controller_reference_msg(current_ref_, get_node());
+  current_ref_.reset(get_node()->now().nanoseconds());
   input_ref_.set(current_ref_);
 
   try
@@ -332,10 +262,31 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_configure(
     return controller_interface::CallbackReturn::ERROR;
   }
 
+  // lay out the state message once, the update loop only sets its values
+  const size_t nr_traction_joints = params_.traction_joints_names.size();
+  const size_t nr_steering_joints = params_.steering_joints_names.size();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
   controller_state_publisher_->lock();
-  controller_state_publisher_->msg_.header.stamp = get_node()->now();
-  controller_state_publisher_->msg_.header.frame_id = params_.odom_frame_id;
+  auto & state_msg = controller_state_publisher_->msg_;
+  state_msg.header.stamp = get_node()->now();
+  state_msg.header.frame_id = params_.odom_frame_id;
+  const size_t nr_traction_feedback = params_.position_feedback ? nr_traction_joints : 0;
+  state_msg.traction_wheels_position.assign(nr_traction_feedback, nan);
+  state_msg.traction_wheels_velocity.assign(nr_traction_joints - nr_traction_feedback, nan);
+  state_msg.traction_command.assign(nr_traction_joints, nan);
+  state_msg.steer_positions.assign(nr_steering_joints, nan);
+  state_msg.steering_angle_command.assign(nr_steering_joints, nan);
   controller_state_publisher_->unlock();
+  steering_itfs_offset_ = nr_traction_joints;
+  state_msg_traction_feedback_ = params_.position_feedback
+                                   ? &SteeringControllerStateMsg::traction_wheels_position
+                                   : &SteeringControllerStateMsg::traction_wheels_velocity;
+
+  controller_state_publish_period_ =
+    params_.controller_state_publish_rate > 0.0
+      ? rclcpp::Duration::from_seconds(1.0 / params_.controller_state_publish_rate)
+      : rclcpp::Duration::from_nanoseconds(0);
+
   RCLCPP_INFO(get_node()->get_logger(), "configure successful");
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -355,7 +306,17 @@ void SteeringControllersLibrary::reference_callback(
 
   if (ref_timeout_ == rclcpp::Duration::from_seconds(0) || age_of_last_command <= ref_timeout_)
   {
-    input_ref_.set(*msg);
+    const Reference reference = to_reference(*msg);
+    if (params_.schedule_reference)
+    {
+      pending_references_.drop_superseded(get_node()->now().nanoseconds());
+      pending_references_.insert(reference.stamp, reference.values);
+      received_reference_schedule_.set(pending_references_);
+    }
+    else
+    {
+      input_ref_.set(reference);
+    }
   }
   else
   {
@@ -368,6 +329,13 @@ void SteeringControllersLibrary::reference_callback(
   }
 }
 
+SteeringControllersLibrary::Reference SteeringControllersLibrary::to_reference(
+  const ControllerTwistReferenceMsg & msg)
+{
+  return {
+    rclcpp::Time(msg.header.stamp).nanoseconds(), {{msg.twist.linear.x, msg.twist.angular.z}}};
+}
+
 controller_interface::InterfaceConfiguration
 SteeringControllersLibrary::command_interface_configuration() const
 {
@@ -435,6 +403,38 @@ SteeringControllersLibrary::on_export_reference_interfaces()
   return reference_interfaces;
 }
 
+std::vector<hardware_interface::StateInterface>
+SteeringControllersLibrary::on_export_state_interfaces()
+{
+  std::vector<hardware_interface::StateInterface> state_interfaces;
+  state_interfaces.reserve(state_interfaces_values_.size());
+
+  const std::string prefix = get_node()->get_name();
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/x", hardware_interface::HW_IF_POSITION, &state_interfaces_values_[0]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/y", hardware_interface::HW_IF_POSITION, &state_interfaces_values_[1]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/yaw", hardware_interface::HW_IF_POSITION, &state_interfaces_values_[2]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/linear", hardware_interface::HW_IF_VELOCITY, &state_interfaces_values_[3]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/angular", hardware_interface::HW_IF_VELOCITY, &state_interfaces_values_[4]));
+
+  return state_interfaces;
+}
+
+bool SteeringControllersLibrary::get_odometry_at(
+  const rclcpp::Time & time, ros2_controllers_utils::OdometrySample & sample) const
+{
+  return odometry_.get_history().lookup(time.nanoseconds(), sample);
+}
+
 bool SteeringControllersLibrary::on_set_chained_mode(bool /*chained_mode*/) { return true; }
 
 controller_interface::CallbackReturn SteeringControllersLibrary::on_activate(
@@ -442,8 +442,18 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_activate(
 {
   // Try to set default value in command.
   // If this fails, then another command will be received soon anyways.
-  reset_controller_reference_msg(current_ref_, get_node());
+  current_ref_.reset(get_node()->now().nanoseconds());
   input_ref_.try_set(current_ref_);
+  previous_commands_.fill({{0.0, 0.0}});
+
+  pending_references_.clear();
+  reference_schedule_.clear();
+  received_reference_schedule_.set(reference_schedule_);
+  applied_reference_stamp_ = std::numeric_limits<int64_t>::min();
+  // publish the controller state in the first update cycle
+  controller_state_previous_publish_timestamp_ =
+    ros2_controllers_utils::get_initial_publish_timestamp(
+      get_node()->now(), controller_state_publish_period_);
 
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -461,26 +471,48 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_deactivate(
 controller_interface::return_type SteeringControllersLibrary::update_reference_from_subscribers(
   const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
 {
-  auto current_ref_op = input_ref_.try_get();
-  if (current_ref_op.has_value())
+  if (params_.schedule_reference)
+  {
+    auto schedule_op = received_reference_schedule_.try_get();
+    if (schedule_op.has_value())
+    {
+      reference_schedule_ = schedule_op.value();
+    }
+    // a reference is taken once when it takes effect, or in every cycle when interpolating
+    Reference reference;
+    if (
+      reference_schedule_.sample(
+        time.nanoseconds(), params_.interpolate_reference, reference.values, reference.stamp) &&
+      (params_.interpolate_reference || reference.stamp != applied_reference_stamp_))
+    {
+      applied_reference_stamp_ = reference.stamp;
+      current_ref_ = reference;
+    }
+  }
+  else
   {
-    current_ref_ = current_ref_op.value();
+    auto current_ref_op = input_ref_.try_get();
+    if (current_ref_op.has_value())
+    {
+      current_ref_ = current_ref_op.value();
+    }
   }
 
-  const auto age_of_last_command = time - current_ref_.header.stamp;
+  const int64_t age_of_last_command = time.nanoseconds() - current_ref_.stamp;
 
   // accept message only if there is no timeout
-  if (age_of_last_command <= ref_timeout_ || ref_timeout_ == rclcpp::Duration::from_seconds(0))
+  if (
+    age_of_last_command <= ref_timeout_.nanoseconds() ||
+    ref_timeout_ == rclcpp::Duration::from_seconds(0))
   {
-    if (!std::isnan(current_ref_.twist.linear.x) && !std::isnan(current_ref_.twist.linear.y))
+    if (!current_ref_.has_nan())
     {
-      reference_interfaces_[0] = current_ref_.twist.linear.x;
-      reference_interfaces_[1] = current_ref_.twist.angular.z;
+      reference_interfaces_[0] = current_ref_.values[0];
+      reference_interfaces_[1] = current_ref_.values[1];
 
       if (ref_timeout_ == rclcpp::Duration::from_seconds(0))
       {
-        current_ref_.twist.linear.x = std::numeric_limits<double>::quiet_NaN();
-        current_ref_.twist.angular.z = std::numeric_limits<double>::quiet_NaN();
+        current_ref_.values.fill(std::numeric_limits<double>::quiet_NaN());
 
         input_ref_.try_set(current_ref_);
       }
@@ -488,13 +520,12 @@ controller_interface::return_type SteeringControllersLibrary::update_reference_f
   }
   else
   {
-    if (!std::isnan(current_ref_.twist.linear.x) && !std::isnan(current_ref_.twist.angular.z))
+    if (!current_ref_.has_nan())
     {
       reference_interfaces_[0] = std::numeric_limits<double>::quiet_NaN();
       reference_interfaces_[1] = std::numeric_limits<double>::quiet_NaN();
 
-      current_ref_.twist.linear.x = std::numeric_limits<double>::quiet_NaN();
-      current_ref_.twist.angular.z = std::numeric_limits<double>::quiet_NaN();
+      current_ref_.values.fill(std::numeric_limits<double>::quiet_NaN());
 
       input_ref_.try_set(current_ref_);
     }
@@ -507,25 +538,35 @@ controller_interface::return_type SteeringControllersLibrary::update_and_write_c
   const rclcpp::Time & time, const rclcpp::Duration & period)
 {
   update_odometry(period);
+  odometry_.push_history(time);
 
-  // MOVE ROBOT
+  state_interfaces_values_[0] = odometry_.get_x();
+  state_interfaces_values_[1] = odometry_.get_y();
+  state_interfaces_values_[2] = odometry_.get_heading();
+  state_interfaces_values_[3] = odometry_.get_linear();
+  state_interfaces_values_[4] = odometry_.get_angular();
 
-  // Limit velocities and accelerations:
-  // TODO(destogl): add limiter for the velocities
+  // MOVE ROBOT
 
   if (!std::isnan(reference_interfaces_[0]) && !std::isnan(reference_interfaces_[1]))
   {
-    auto [traction_commands, steering_commands] = odometry_.get_commands(
-      reference_interfaces_[0], reference_interfaces_[1], params_.open_loop,
-      params_.reduce_wheel_speed_until_steering_reached);
+    // Limit velocities and accelerations
+    std::array<double, 2> command{{reference_interfaces_[0], reference_interfaces_[1]}};
+    limiter_.limit(command, previous_commands_, period.seconds());
+    previous_commands_.push(command);
+
+    odometry_.get_commands(
+      command[0], command[1], params_.open_loop, params_.reduce_wheel_speed_until_steering_reached,
+      traction_commands_, steering_commands_);
 
     for (size_t i = 0; i < params_.traction_joints_names.size(); i++)
     {
-      command_interfaces_[i].set_value(traction_commands[i]);
+      command_interfaces_[i].set_value(traction_commands_[i]);
     }
     for (size_t i = 0; i < params_.steering_joints_names.size(); i++)
     {
-      command_interfaces_[i + params_.traction_joints_names.size()].set_value(steering_commands[i]);
+      command_interfaces_[i + params_.traction_joints_names.size()].set_value(
+        steering_commands_[i]);
     }
   }
   else
@@ -534,6 +575,7 @@ controller_interface::return_type SteeringControllersLibrary::update_and_write_c
     {
       command_interfaces_[i].set_value(0.0);
     }
+    previous_commands_.push({{0.0, 0.0}});
   }
 
   // Publish odometry message
@@ -542,7 +584,7 @@ controller_interface::return_type SteeringControllersLibrary::update_and_write_c
   orientation.setRPY(0.0, 0.0, odometry_.get_heading());
 
   // Populate odom message and publish
-  if (rt_odom_state_publisher_->trylock())
+  if (params_.publish_odom && rt_odom_state_publisher_->trylock())
   {
     rt_odom_state_publisher_->msg_.header.stamp = time;
     rt_odom_state_publisher_->msg_.pose.pose.position.x = odometry_.get_x();
@@ -566,40 +608,25 @@ controller_interface::return_type SteeringControllersLibrary::update_and_write_c
     rt_tf_odom_state_publisher_->unlockAndPublish();
   }
 
-  if (controller_state_publisher_->trylock())
+  if (
+    ros2_controllers_utils::is_publish_due(
+      controller_state_publish_period_, controller_state_previous_publish_timestamp_, time) &&
+    controller_state_publisher_->trylock())
   {
-    controller_state_publisher_->msg_.header.stamp = time;
-    controller_state_publisher_->msg_.traction_wheels_position.clear();
-    controller_state_publisher_->msg_.traction_wheels_velocity.clear();
-    controller_state_publisher_->msg_.traction_command.clear();
-    controller_state_publisher_->msg_.steer_positions.clear();
-    controller_state_publisher_->msg_.steering_angle_command.clear();
-
-    auto number_of_traction_wheels = params_.traction_joints_names.size();
-    auto number_of_steering_wheels = params_.steering_joints_names.size();
+    auto & state_msg = controller_state_publisher_->msg_;
+    state_msg.header.stamp = time;
 
-    for (size_t i = 0; i < number_of_traction_wheels; ++i)
+    auto & traction_feedback = state_msg.*state_msg_traction_feedback_;
+    for (size_t i = 0; i < steering_itfs_offset_; ++i)
     {
-      if (params_.position_feedback)
-      {
-        controller_state_publisher_->msg_.traction_wheels_position.push_back(
-          state_interfaces_[i].get_value());
-      }
-      else
-      {
-        controller_state_publisher_->msg_.traction_wheels_velocity.push_back(
-          state_interfaces_[i].get_value());
-      }
-      controller_state_publisher_->msg_.traction_command.push_back(
-        command_interfaces_[i].get_value());
+      traction_feedback[i] = state_interfaces_[i].get_value();
+      state_msg.traction_command[i] = command_interfaces_[i].get_value();
     }
-
-    for (size_t i = 0; i < number_of_steering_wheels; ++i)
+    for (size_t i = 0; i < state_msg.steer_positions.size(); ++i)
     {
-      controller_state_publisher_->msg_.steer_positions.push_back(
-        state_interfaces_[number_of_traction_wheels + i].get_value());
-      controller_state_publisher_->msg_.steering_angle_command.push_back(
-        command_interfaces_[number_of_traction_wheels + i].get_value());
+      state_msg.steer_positions[i] = state_interfaces_[steering_itfs_offset_ + i].get_value();
+      state_msg.steering_angle_command[i] =
+        command_interfaces_[steering_itfs_offset_ + i].get_value();
     }
 
     controller_state_publisher_->unlockAndPublish();
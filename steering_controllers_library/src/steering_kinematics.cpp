@@ -0,0 +1,105 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define _USE_MATH_DEFINES
+
+#include "steering_controllers_library/steering_kinematics.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace steering_odometry
+{
+void SteeringKinematics::configure(const std::vector<Wheel> & wheels, const double wheel_radius)
+{
+  if (wheels.size() > MAX_WHEELS)
+  {
+    throw std::invalid_argument(
+      "The wheel layout has " + std::to_string(wheels.size()) + " wheels, at most " +
+      std::to_string(MAX_WHEELS) + " are supported");
+  }
+  if (!(wheel_radius > 0.0))
+  {
+    throw std::invalid_argument("The wheel radius has to be positive");
+  }
+
+  size_t traction_size = 0;
+  size_t steering_size = 0;
+  for (size_t i = 0; i < wheels.size(); ++i)
+  {
+    wheels_[i].x = wheels[i].x;
+    wheels_[i].y = wheels[i].y;
+    wheels_[i].steering_index = wheels[i].steering ? steering_size++ : MAX_WHEELS;
+    wheels_[i].traction_index = wheels[i].traction ? traction_size++ : MAX_WHEELS;
+  }
+  if (traction_size == 0)
+  {
+    throw std::invalid_argument("The wheel layout has no traction wheel");
+  }
+
+  size_ = wheels.size();
+  traction_size_ = traction_size;
+  steering_size_ = steering_size;
+  inverse_wheel_radius_ = 1.0 / wheel_radius;
+}
+
+void SteeringKinematics::inverse(
+  const double v_bx, const double omega_bz, const double traction_omega_bz,
+  double * traction_commands, double * steering_commands) const
+{
+  // the wheels steer for the direction of travel of the base, and drive backwards when reversing
+  const double direction = v_bx < 0.0 ? -1.0 : 1.0;
+
+  for (size_t i = 0; i < size_; ++i)
+  {
+    const CompiledWheel & wheel = wheels_[i];
+    double cos_steering = 1.0;
+    double sin_steering = 0.0;
+    double omega = traction_omega_bz;
+
+    if (wheel.steering_index < MAX_WHEELS)
+    {
+      // velocity of the contact point, the angle stays at zero if the wheel does not move
+      const double v_x = direction * (v_bx - omega_bz * wheel.y);
+      const double v_y = direction * omega_bz * wheel.x;
+      const double v_norm = std::hypot(v_x, v_y);
+      double steering = std::atan2(v_y, v_x);
+      if (v_norm > 0.0)
+      {
+        cos_steering = v_x / v_norm;
+        sin_steering = v_y / v_norm;
+      }
+      if (wheel.traction_index < MAX_WHEELS && std::fabs(steering) > M_PI_2)
+      {
+        // a driven wheel takes the shorter way and drives backwards instead
+        steering -= std::copysign(M_PI, steering);
+        cos_steering = -cos_steering;
+        sin_steering = -sin_steering;
+      }
+      steering_commands[wheel.steering_index] = steering;
+      omega = omega_bz;
+    }
+
+    if (wheel.traction_index < MAX_WHEELS)
+    {
+      // contact point velocity in rolling direction of the wheel
+      traction_commands[wheel.traction_index] =
+        (cos_steering * (v_bx - omega * wheel.y) + sin_steering * omega * wheel.x) *
+        inverse_wheel_radius_;
+    }
+  }
+}
+
+}  // namespace steering_odometry
@@ -23,9 +23,17 @@
 
 #include <cmath>
 #include <limits>
+#include <stdexcept>
 
 namespace steering_odometry
 {
+namespace
+{
+// the wheel speed is reduced if the steering angle is further off than MIN_PHI_DELTA
+const double MIN_PHI_DELTA = M_PI / 6.;
+const double COS_MIN_PHI_DELTA = std::cos(MIN_PHI_DELTA);
+}  // namespace
+
 SteeringOdometry::SteeringOdometry(size_t velocity_rolling_window_size)
 : timestamp_(0.0),
   x_(0.0),
@@ -37,19 +45,22 @@ SteeringOdometry::SteeringOdometry(size_t velocity_rolling_window_size)
   wheel_track_steering_(0.0),
   wheel_base_(0.0),
   wheel_radius_(0.0),
+  inverse_wheel_base_(0.0),
   traction_wheel_old_pos_(0.0),
   traction_right_wheel_old_pos_(0.0),
   traction_left_wheel_old_pos_(0.0),
   velocity_rolling_window_size_(velocity_rolling_window_size),
-  linear_acc_(velocity_rolling_window_size),
-  angular_acc_(velocity_rolling_window_size)
+  velocity_estimator_type_(ros2_controllers_utils::VelocityEstimator::Type::ROLLING_MEAN),
+  linear_acc_(velocity_estimator_type_, velocity_rolling_window_size),
+  angular_acc_(velocity_estimator_type_, velocity_rolling_window_size)
 {
 }
 
 void SteeringOdometry::init(const rclcpp::Time & time)
 {
-  // Reset accumulators and timestamp:
+  // Reset accumulators, history and timestamp:
   reset_accumulators();
+  history_.clear();
   timestamp_ = time;
 }
 
@@ -65,12 +76,12 @@ bool SteeringOdometry::update_odometry(
     return false;  // Interval too small to integrate with
   }
 
-  /// Estimate speeds using a rolling mean to filter them out:
+  /// Estimate speeds using the velocity estimators to filter them out:
   linear_acc_.accumulate(linear_velocity);
   angular_acc_.accumulate(angular_velocity);
 
-  linear_ = linear_acc_.getRollingMean();
-  angular_ = angular_acc_.getRollingMean();
+  linear_ = linear_acc_.get_estimate();
+  angular_ = angular_acc_.get_estimate();
 
   return true;
 }
@@ -197,10 +208,7 @@ void SteeringOdometry::update_open_loop(const double v_bx, const double omega_bz
 
 void SteeringOdometry::set_wheel_params(double wheel_radius, double wheel_base, double wheel_track)
 {
-  wheel_radius_ = wheel_radius;
-  wheel_base_ = wheel_base;
-  wheel_track_traction_ = wheel_track;
-  wheel_track_steering_ = wheel_track;
+  set_wheel_params(wheel_radius, wheel_base, wheel_track, wheel_track);
 }
 
 void SteeringOdometry::set_wheel_params(
@@ -210,18 +218,92 @@ void SteeringOdometry::set_wheel_params(
   wheel_base_ = wheel_base;
   wheel_track_traction_ = wheel_track_traction;
   wheel_track_steering_ = wheel_track_steering;
+  inverse_wheel_base_ = wheel_base > 0.0 ? 1.0 / wheel_base : 0.0;
+
+  configure_kinematics();
+}
+
+void SteeringOdometry::set_wheel_layout(const std::vector<Wheel> & wheels)
+{
+  kinematics_.configure(wheels, wheel_radius_);
+  parallel_steering_when_straight_ = false;
 }
 
 void SteeringOdometry::set_velocity_rolling_window_size(size_t velocity_rolling_window_size)
 {
   velocity_rolling_window_size_ = velocity_rolling_window_size;
 
-  reset_accumulators();
+  linear_acc_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+  angular_acc_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+}
+
+void SteeringOdometry::set_velocity_estimator_type(
+  const ros2_controllers_utils::VelocityEstimator::Type type)
+{
+  velocity_estimator_type_ = type;
+
+  linear_acc_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+  angular_acc_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+}
+
+void SteeringOdometry::set_history_size(const size_t history_size)
+{
+  history_.resize(history_size);
+}
+
+void SteeringOdometry::push_history(const rclcpp::Time & time)
+{
+  ros2_controllers_utils::OdometrySample sample;
+  sample.stamp = time.nanoseconds();
+  sample.x = x_;
+  sample.y = y_;
+  sample.heading = heading_;
+  sample.linear_x = linear_;
+  sample.angular_z = angular_;
+  history_.push(sample);
 }
 
 void SteeringOdometry::set_odometry_type(const unsigned int type)
 {
   config_type_ = static_cast<int>(type);
+
+  configure_kinematics();
+}
+
+void SteeringOdometry::configure_kinematics()
+{
+  // origin in the middle of the rear axle, the right wheel first
+  const double half_track_traction = wheel_track_traction_ * 0.5;
+  const double half_track_steering = wheel_track_steering_ * 0.5;
+  std::vector<Wheel> wheels;
+  if (config_type_ == static_cast<int>(BICYCLE_CONFIG))
+  {
+    wheels = {{0.0, 0.0, false, true}, {wheel_base_, 0.0, true, false}};
+  }
+  else if (config_type_ == static_cast<int>(TRICYCLE_CONFIG))
+  {
+    wheels = {
+      {0.0, -half_track_traction, false, true},
+      {0.0, half_track_traction, false, true},
+      {wheel_base_, 0.0, true, false}};
+  }
+  else if (config_type_ == static_cast<int>(ACKERMANN_CONFIG))
+  {
+    wheels = {
+      {0.0, -half_track_traction, false, true},
+      {0.0, half_track_traction, false, true},
+      {wheel_base_, -half_track_steering, true, false},
+      {wheel_base_, half_track_steering, true, false}};
+  }
+
+  if (wheels.empty() || !(wheel_radius_ > 0.0))
+  {
+    // not configured yet
+    kinematics_ = SteeringKinematics();
+    return;
+  }
+  kinematics_.configure(wheels, wheel_radius_);
+  parallel_steering_when_straight_ = true;
 }
 
 double SteeringOdometry::convert_twist_to_steering_angle(double v_bx, double omega_bz)
@@ -235,114 +317,70 @@ std::tuple<std::vector<double>, std::vector<double>> SteeringOdometry::get_comma
   const double v_bx, const double omega_bz, const bool open_loop,
   const bool reduce_wheel_speed_until_steering_reached)
 {
-  // desired wheel speed and steering angle of the middle of traction and steering axis
-  double Ws, phi, phi_IK = steer_pos_;
+  SteeringKinematics::WheelValues traction_commands;
+  SteeringKinematics::WheelValues steering_commands;
+  get_commands(
+    v_bx, omega_bz, open_loop, reduce_wheel_speed_until_steering_reached, traction_commands,
+    steering_commands);
+
+  return std::make_tuple(
+    std::vector<double>(
+      traction_commands.begin(), traction_commands.begin() + kinematics_.get_traction_size()),
+    std::vector<double>(
+      steering_commands.begin(), steering_commands.begin() + kinematics_.get_steering_size()));
+}
 
-#if 0
-  if (v_bx == 0 && omega_bz != 0)
-  {
-    // TODO(anyone) this would be only possible if traction is on the steering axis
-    phi = omega_bz > 0 ? M_PI_2 : -M_PI_2;
-    Ws = abs(omega_bz) * wheelbase_ / wheel_radius_;
-  }
-  else
+void SteeringOdometry::get_commands(
+  const double v_bx, const double omega_bz, const bool open_loop,
+  const bool reduce_wheel_speed_until_steering_reached,
+  SteeringKinematics::WheelValues & traction_commands,
+  SteeringKinematics::WheelValues & steering_commands)
+{
+  if (kinematics_.get_traction_size() == 0)
   {
-    // TODO(anyone) this would be valid only if traction is on the steering axis
-    Ws = v_bx / (wheel_radius_ * std::cos(phi_IK));  // using the measured steering angle
+    throw std::runtime_error("Config not implemented");
   }
-#endif
-  // steering angle
-  phi = SteeringOdometry::convert_twist_to_steering_angle(v_bx, omega_bz);
-  if (open_loop)
+
+  // steering angle of the virtual wheel in the middle of the steering axis
+  const double phi = SteeringOdometry::convert_twist_to_steering_angle(v_bx, omega_bz);
+  const double phi_IK = open_loop ? phi : steer_pos_;
+
+  // the traction wheels without steering roll with the yaw rate of the measured steering angle
+  const double traction_omega_bz =
+    is_close_to_zero(phi_IK) ? 0.0 : v_bx * std::tan(phi_IK) * inverse_wheel_base_;
+
+  kinematics_.inverse(
+    v_bx, omega_bz, traction_omega_bz, traction_commands.data(), steering_commands.data());
+
+  if (parallel_steering_when_straight_ && is_close_to_zero(phi_IK))
   {
-    phi_IK = phi;
+    // shortcut, no steering
+    steering_commands.fill(phi);
   }
-  // wheel speed
-  Ws = v_bx / wheel_radius_;
 
   if (!open_loop && reduce_wheel_speed_until_steering_reached)
   {
     // Reduce wheel speed until the target angle has been reached
-    double phi_delta = abs(steer_pos_ - phi);
+    const double phi_delta = std::fabs(steer_pos_ - phi);
     double scale;
-    const double min_phi_delta = M_PI / 6.;
-    if (phi_delta < min_phi_delta)
+    if (phi_delta < MIN_PHI_DELTA)
     {
       scale = 1;
     }
     else if (phi_delta >= 1.5608)
     {
       // cos(1.5608) = 0.01
-      scale = 0.01 / cos(min_phi_delta);
+      scale = 0.01 / COS_MIN_PHI_DELTA;
     }
     else
     {
       // TODO(anyone): find the best function, e.g convex power functions
-      scale = cos(phi_delta) / cos(min_phi_delta);
+      scale = std::cos(phi_delta) / COS_MIN_PHI_DELTA;
     }
-    Ws *= scale;
-  }
-
-  if (config_type_ == BICYCLE_CONFIG)
-  {
-    std::vector<double> traction_commands = {Ws};
-    std::vector<double> steering_commands = {phi};
-    return std::make_tuple(traction_commands, steering_commands);
-  }
-  else if (config_type_ == TRICYCLE_CONFIG)
-  {
-    std::vector<double> traction_commands;
-    std::vector<double> steering_commands;
-    // double-traction axle
-    if (is_close_to_zero(phi_IK))
-    {
-      // avoid division by zero
-      traction_commands = {Ws, Ws};
-    }
-    else
-    {
-      const double turning_radius = wheel_base_ / std::tan(phi_IK);
-      const double Wr = Ws * (turning_radius + wheel_track_traction_ * 0.5) / turning_radius;
-      const double Wl = Ws * (turning_radius - wheel_track_traction_ * 0.5) / turning_radius;
-      traction_commands = {Wr, Wl};
-    }
-    // simple steering
-    steering_commands = {phi};
-    return std::make_tuple(traction_commands, steering_commands);
-  }
-  else if (config_type_ == ACKERMANN_CONFIG)
-  {
-    std::vector<double> traction_commands;
-    std::vector<double> steering_commands;
-    if (is_close_to_zero(phi_IK))
+    for (size_t i = 0; i < kinematics_.get_traction_size(); ++i)
     {
-      // avoid division by zero
-      traction_commands = {Ws, Ws};
-      // shortcut, no steering
-      steering_commands = {phi, phi};
+      traction_commands[i] *= scale;
     }
-    else
-    {
-      const double turning_radius = wheel_base_ / std::tan(phi_IK);
-      const double Wr = Ws * (turning_radius + wheel_track_traction_ * 0.5) / turning_radius;
-      const double Wl = Ws * (turning_radius - wheel_track_traction_ * 0.5) / turning_radius;
-      traction_commands = {Wr, Wl};
-
-      const double numerator = 2 * wheel_base_ * std::sin(phi);
-      const double denominator_first_member = 2 * wheel_base_ * std::cos(phi);
-      const double denominator_second_member = wheel_track_steering_ * std::sin(phi);
-
-      const double alpha_r =
-        std::atan2(numerator, denominator_first_member + denominator_second_member);
-      const double alpha_l =
-        std::atan2(numerator, denominator_first_member - denominator_second_member);
-      steering_commands = {alpha_r, alpha_l};
-    }
-    return std::make_tuple(traction_commands, steering_commands);
-  }
-  else
-  {
-    throw std::runtime_error("Config not implemented");
   }
 }
 
@@ -352,6 +390,7 @@ void SteeringOdometry::reset_odometry()
   y_ = 0.0;
   heading_ = 0.0;
   reset_accumulators();
+  history_.clear();
 }
 
 void SteeringOdometry::integrate_runge_kutta_2(
@@ -389,8 +428,8 @@ void SteeringOdometry::integrate_fk(const double v_bx, const double omega_bz, co
 
 void SteeringOdometry::reset_accumulators()
 {
-  linear_acc_ = RollingMeanAccumulator(velocity_rolling_window_size_);
-  angular_acc_ = RollingMeanAccumulator(velocity_rolling_window_size_);
+  linear_acc_.reset();
+  angular_acc_.reset();
 }
 
 }  // namespace steering_odometry
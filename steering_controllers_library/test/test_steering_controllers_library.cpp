@@ -15,9 +15,12 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "ros2_controllers_utils/allocation_counter.hpp"
 #include "test_steering_controllers_library.hpp"
 
 class SteeringControllersLibraryTest
@@ -77,6 +80,23 @@ TEST_F(SteeringControllersLibraryTest, check_exported_interfaces)
       ref_itf_prefix_name + "/" + hardware_interface::HW_IF_VELOCITY);
     EXPECT_EQ(reference_interfaces[i]->get_interface_name(), hardware_interface::HW_IF_VELOCITY);
   }
+
+  // check exported state itfs of the odometry
+  auto exported_state_interfaces = controller_->export_state_interfaces();
+  const std::vector<std::pair<std::string, std::string>> odometry_interfaces = {
+    {"x", hardware_interface::HW_IF_POSITION},
+    {"y", hardware_interface::HW_IF_POSITION},
+    {"yaw", hardware_interface::HW_IF_POSITION},
+    {"linear", hardware_interface::HW_IF_VELOCITY},
+    {"angular", hardware_interface::HW_IF_VELOCITY}};
+  ASSERT_EQ(exported_state_interfaces.size(), odometry_interfaces.size());
+  for (size_t i = 0; i < odometry_interfaces.size(); ++i)
+  {
+    const std::string state_itf_prefix_name =
+      std::string(controller_->get_node()->get_name()) + "/" + odometry_interfaces[i].first;
+    EXPECT_EQ(exported_state_interfaces[i]->get_prefix_name(), state_itf_prefix_name);
+    EXPECT_EQ(exported_state_interfaces[i]->get_interface_name(), odometry_interfaces[i].second);
+  }
 }
 
 // Tests controller update_reference_from_subscribers and
@@ -114,13 +134,13 @@ TEST_F(SteeringControllersLibraryTest, test_position_feedback_ref_timeout)
   msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
 
   // age_of_last_command < ref_timeout_
-  auto age_of_last_command =
-    controller_->get_node()->now() - controller_->input_ref_.get().header.stamp;
-  ASSERT_TRUE(age_of_last_command <= controller_->ref_timeout_);
-  ASSERT_EQ(controller_->input_ref_.get().twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  int64_t age_of_last_command =
+    controller_->get_node()->now().nanoseconds() - controller_->input_ref_.get().stamp;
+  ASSERT_TRUE(age_of_last_command <= controller_->ref_timeout_.nanoseconds());
+  ASSERT_EQ(controller_->input_ref_.get().values[0], TEST_LINEAR_VELOCITY_X);
   ASSERT_EQ(
     controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -129,8 +149,8 @@ TEST_F(SteeringControllersLibraryTest, test_position_feedback_ref_timeout)
   {
     EXPECT_TRUE(std::isnan(interface));
   }
-  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().twist.linear.x));
-  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().twist.angular.z));
+  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().values[0]));
+  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().values[1]));
 
   // are the command_itfs updated?
   EXPECT_NEAR(controller_->command_interfaces_[0].get_value(), 3.333333, 1e-6);
@@ -138,6 +158,13 @@ TEST_F(SteeringControllersLibraryTest, test_position_feedback_ref_timeout)
   EXPECT_NEAR(controller_->command_interfaces_[2].get_value(), 0.575875, 1e-6);
   EXPECT_NEAR(controller_->command_interfaces_[3].get_value(), 0.575875, 1e-6);
 
+  // is the odometry exported in the same cycle?
+  EXPECT_EQ(controller_->state_interfaces_values_[0], controller_->odometry_.get_x());
+  EXPECT_EQ(controller_->state_interfaces_values_[1], controller_->odometry_.get_y());
+  EXPECT_EQ(controller_->state_interfaces_values_[2], controller_->odometry_.get_heading());
+  EXPECT_EQ(controller_->state_interfaces_values_[3], controller_->odometry_.get_linear());
+  EXPECT_EQ(controller_->state_interfaces_values_[4], controller_->odometry_.get_angular());
+
   // adjusting to achieve age_of_last_command > ref_timeout
   msg.header.stamp = controller_->get_node()->now() - controller_->ref_timeout_ -
                      rclcpp::Duration::from_seconds(0.1);
@@ -147,9 +174,10 @@ TEST_F(SteeringControllersLibraryTest, test_position_feedback_ref_timeout)
   msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
 
-  age_of_last_command = controller_->get_node()->now() - controller_->input_ref_.get().header.stamp;
+  age_of_last_command =
+    controller_->get_node()->now().nanoseconds() - controller_->input_ref_.get().stamp;
 
   // adjusting to achieve age_of_last_command > ref_timeout
   msg.header.stamp = controller_->get_node()->now() - controller_->ref_timeout_ -
@@ -160,11 +188,11 @@ TEST_F(SteeringControllersLibraryTest, test_position_feedback_ref_timeout)
   msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
 
   // age_of_last_command > ref_timeout_
-  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_);
-  ASSERT_EQ(controller_->input_ref_.get().twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_.nanoseconds());
+  ASSERT_EQ(controller_->input_ref_.get().values[0], TEST_LINEAR_VELOCITY_X);
   ASSERT_EQ(
     controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -173,8 +201,8 @@ TEST_F(SteeringControllersLibraryTest, test_position_feedback_ref_timeout)
   {
     EXPECT_TRUE(std::isnan(interface));
   }
-  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().twist.linear.x));
-  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().twist.angular.z));
+  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().values[0]));
+  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().values[1]));
 
   // Wheel velocities should reset to 0
   EXPECT_EQ(controller_->command_interfaces_[0].get_value(), 0);
@@ -220,14 +248,14 @@ TEST_F(SteeringControllersLibraryTest, test_velocity_feedback_ref_timeout)
   msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
 
-  auto age_of_last_command =
-    controller_->get_node()->now() - controller_->input_ref_.get().header.stamp;
+  int64_t age_of_last_command =
+    controller_->get_node()->now().nanoseconds() - controller_->input_ref_.get().stamp;
 
   // age_of_last_command < ref_timeout_
-  ASSERT_TRUE(age_of_last_command <= controller_->ref_timeout_);
-  ASSERT_EQ(controller_->input_ref_.get().twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  ASSERT_TRUE(age_of_last_command <= controller_->ref_timeout_.nanoseconds());
+  ASSERT_EQ(controller_->input_ref_.get().values[0], TEST_LINEAR_VELOCITY_X);
   ASSERT_EQ(
     controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -236,8 +264,8 @@ TEST_F(SteeringControllersLibraryTest, test_velocity_feedback_ref_timeout)
   {
     EXPECT_TRUE(std::isnan(interface));
   }
-  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().twist.linear.x));
-  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().twist.angular.z));
+  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().values[0]));
+  ASSERT_FALSE(std::isnan(controller_->input_ref_.get().values[1]));
 
   // are the command_itfs updated?
   EXPECT_NEAR(controller_->command_interfaces_[0].get_value(), 3.333333, 1e-6);
@@ -254,13 +282,14 @@ TEST_F(SteeringControllersLibraryTest, test_velocity_feedback_ref_timeout)
   msg.twist.angular.x = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.y = std::numeric_limits<double>::quiet_NaN();
   msg.twist.angular.z = TEST_ANGULAR_VELOCITY_Z;
-  controller_->input_ref_.set(msg);
+  controller_->input_ref_.set(controller_->to_reference(msg));
 
-  age_of_last_command = controller_->get_node()->now() - controller_->input_ref_.get().header.stamp;
+  age_of_last_command =
+    controller_->get_node()->now().nanoseconds() - controller_->input_ref_.get().stamp;
 
   // age_of_last_command > ref_timeout_
-  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_);
-  ASSERT_EQ(controller_->input_ref_.get().twist.linear.x, TEST_LINEAR_VELOCITY_X);
+  ASSERT_FALSE(age_of_last_command <= controller_->ref_timeout_.nanoseconds());
+  ASSERT_EQ(controller_->input_ref_.get().values[0], TEST_LINEAR_VELOCITY_X);
   ASSERT_EQ(
     controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -269,8 +298,8 @@ TEST_F(SteeringControllersLibraryTest, test_velocity_feedback_ref_timeout)
   {
     EXPECT_TRUE(std::isnan(interface));
   }
-  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().twist.linear.x));
-  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().twist.angular.z));
+  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().values[0]));
+  ASSERT_TRUE(std::isnan(controller_->input_ref_.get().values[1]));
 
   // Wheel velocities should reset to 0
   EXPECT_EQ(controller_->command_interfaces_[0].get_value(), 0);
@@ -281,6 +310,161 @@ TEST_F(SteeringControllersLibraryTest, test_velocity_feedback_ref_timeout)
   EXPECT_NEAR(controller_->command_interfaces_[3].get_value(), 0.575875, 1e-6);
 }
 
+// Tests that references stamped in the future take effect at their stamps
+TEST_F(SteeringControllersLibraryTest, scheduled_references_take_effect_at_their_stamps)
+{
+  SetUpController();
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  controller_->params_.schedule_reference = true;
+  controller_->set_chained_mode(false);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  const auto make_reference = [](const rclcpp::Time & stamp, double linear_x)
+  {
+    auto msg = std::make_shared<ControllerReferenceMsg>();
+    msg->header.stamp = stamp;
+    msg->twist.linear.x = linear_x;
+    msg->twist.angular.z = 0.0;
+    return msg;
+  };
+
+  // the second reference is stamped in the future and received first
+  const rclcpp::Time start = controller_->get_node()->now();
+  controller_->reference_callback(
+    make_reference(start + rclcpp::Duration::from_seconds(0.05), 2.0));
+  controller_->reference_callback(make_reference(start, 1.0));
+
+  ASSERT_EQ(
+    controller_->update(
+      start + rclcpp::Duration::from_seconds(0.02), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->current_ref_.values[0], 1.0);
+  EXPECT_GT(controller_->command_interfaces_[CMD_TRACTION_RIGHT_WHEEL].get_value(), 0.0);
+
+  ASSERT_EQ(
+    controller_->update(
+      start + rclcpp::Duration::from_seconds(0.06), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->current_ref_.values[0], 2.0);
+
+  // the timeout applies from the stamp of the reference in effect
+  ASSERT_EQ(
+    controller_->update(
+      start + rclcpp::Duration::from_seconds(0.3), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_TRUE(std::isnan(controller_->current_ref_.values[0]));
+  EXPECT_EQ(controller_->command_interfaces_[CMD_TRACTION_RIGHT_WHEEL].get_value(), 0.0);
+}
+
+// Tests that the state message is laid out at configure and published at its rate
+TEST_F(SteeringControllersLibraryTest, controller_state_is_published_at_its_rate)
+{
+  SetUpController();
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  EXPECT_EQ(controller_->controller_state_publish_period_.nanoseconds(), 0);
+  // as configured from controller_state_publish_rate of 10 Hz
+  controller_->controller_state_publish_period_ = rclcpp::Duration::from_seconds(0.1);
+  controller_->set_chained_mode(false);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  auto & state_publisher = controller_->controller_state_publisher_;
+  state_publisher->lock();
+  EXPECT_TRUE(state_publisher->msg_.traction_wheels_position.empty());
+  EXPECT_EQ(state_publisher->msg_.traction_wheels_velocity.size(), 2u);
+  EXPECT_EQ(state_publisher->msg_.traction_command.size(), 2u);
+  EXPECT_EQ(state_publisher->msg_.steer_positions.size(), 2u);
+  EXPECT_EQ(state_publisher->msg_.steering_angle_command.size(), 2u);
+  state_publisher->unlock();
+
+  // waits until the previous message is published, so the next update can fill the message
+  const auto wait_for_publisher = [&state_publisher]()
+  {
+    for (size_t i = 0; i < 100; ++i)
+    {
+      if (state_publisher->trylock())
+      {
+        state_publisher->unlock();
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  };
+  const auto published_stamp = [&state_publisher]()
+  {
+    state_publisher->lock();
+    const rclcpp::Time stamp(state_publisher->msg_.header.stamp, RCL_ROS_TIME);
+    state_publisher->unlock();
+    return stamp;
+  };
+
+  // published in the first cycle after activation
+  const rclcpp::Time start = controller_->get_node()->now();
+  const auto period = rclcpp::Duration::from_seconds(0.05);
+  ASSERT_TRUE(wait_for_publisher());
+  ASSERT_EQ(controller_->update(start, period), controller_interface::return_type::OK);
+  EXPECT_EQ(published_stamp(), start);
+  state_publisher->lock();
+  EXPECT_EQ(
+    state_publisher->msg_.steer_positions[0],
+    controller_->state_interfaces_[STATE_STEER_RIGHT_WHEEL].get_value());
+  EXPECT_EQ(
+    state_publisher->msg_.traction_command[CMD_TRACTION_RIGHT_WHEEL],
+    controller_->command_interfaces_[CMD_TRACTION_RIGHT_WHEEL].get_value());
+  state_publisher->unlock();
+
+  // not due before the publish period of 0.1 s has passed
+  ASSERT_TRUE(wait_for_publisher());
+  ASSERT_EQ(controller_->update(start + period, period), controller_interface::return_type::OK);
+  EXPECT_EQ(published_stamp(), start);
+
+  ASSERT_TRUE(wait_for_publisher());
+  const rclcpp::Time due = start + rclcpp::Duration::from_seconds(0.11);
+  ASSERT_EQ(controller_->update(due, period), controller_interface::return_type::OK);
+  EXPECT_EQ(published_stamp(), due);
+}
+
+// Tests that the update loop of the steering controllers does not allocate memory
+TEST_F(SteeringControllersLibraryTest, update_does_not_allocate)
+{
+  SetUpController();
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  controller_->set_chained_mode(false);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  ControllerReferenceMsg msg;
+  msg.header.stamp = controller_->get_node()->now();
+  msg.twist.linear.x = 0.1;
+  msg.twist.angular.z = 0.2;
+  const auto reference = controller_->to_reference(msg);
+
+  bool updates_ok = true;
+  // the state message is laid out at configure, so even the first updates must not allocate
+  const size_t allocations = ros2_controllers_utils::count_allocations(
+    [&]()
+    {
+      for (size_t i = 0; i < 10; ++i)
+      {
+        controller_->input_ref_.set(reference);
+        if (
+          controller_->update(
+            rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)) !=
+          controller_interface::return_type::OK)
+        {
+          updates_ok = false;
+        }
+      }
+    });
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_TRUE(updates_ok);
+  EXPECT_GT(controller_->command_interfaces_[CMD_TRACTION_RIGHT_WHEEL].get_value(), 0.0);
+}
+
+ROS2_CONTROLLERS_UTILS_COUNT_ALLOCATIONS()
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -72,6 +72,9 @@ class TestableSteeringControllersLibrary
   FRIEND_TEST(SteeringControllersLibraryTest, check_exported_interfaces);
   FRIEND_TEST(SteeringControllersLibraryTest, test_position_feedback_ref_timeout);
   FRIEND_TEST(SteeringControllersLibraryTest, test_velocity_feedback_ref_timeout);
+  FRIEND_TEST(SteeringControllersLibraryTest, scheduled_references_take_effect_at_their_stamps);
+  FRIEND_TEST(SteeringControllersLibraryTest, controller_state_is_published_at_its_rate);
+  FRIEND_TEST(SteeringControllersLibraryTest, update_does_not_allocate);
 
 public:
   controller_interface::CallbackReturn on_configure(
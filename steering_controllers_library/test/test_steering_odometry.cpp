@@ -171,6 +171,24 @@ TEST(TestSteeringOdometry, ackermann_IK_right_steering_limited)
   }
 }
 
+TEST(TestSteeringOdometry, ackermann_IK_into_buffers)
+{
+  steering_odometry::SteeringOdometry odom(1);
+  odom.set_wheel_params(1., 2., 1.);
+  odom.set_odometry_type(steering_odometry::ACKERMANN_CONFIG);
+  odom.update_from_position(0., 0.2, 1.);  // assume already turn
+  auto cmd = odom.get_commands(1., 0.1, false);
+
+  steering_odometry::SteeringKinematics::WheelValues traction_commands;
+  steering_odometry::SteeringKinematics::WheelValues steering_commands;
+  odom.get_commands(1., 0.1, false, false, traction_commands, steering_commands);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    EXPECT_DOUBLE_EQ(traction_commands[i], std::get<0>(cmd)[i]);
+    EXPECT_DOUBLE_EQ(steering_commands[i], std::get<1>(cmd)[i]);
+  }
+}
+
 // ----------------- bicycle -----------------
 
 TEST(TestSteeringOdometry, bicycle_IK_linear)
@@ -378,3 +396,28 @@ TEST(TestSteeringOdometry, tricycle_odometry)
   EXPECT_NEAR(odom.get_x(), .1, 1e-3);
   EXPECT_NEAR(odom.get_heading(), .01, 1e-3);
 }
+
+TEST(TestSteeringOdometry, custom_wheel_layout)
+{
+  steering_odometry::SteeringOdometry odom(1);
+  odom.set_wheel_params(1., 2., 1.);
+  odom.set_odometry_type(steering_odometry::ACKERMANN_CONFIG);
+  // three steered and driven wheels around the origin
+  odom.set_wheel_layout(
+    {{1., 0., true, true}, {-.5, .866025403784, true, true}, {-.5, -.866025403784, true, true}});
+  ASSERT_EQ(odom.get_kinematics().get_traction_size(), 3u);
+  auto cmd = odom.get_commands(0., 1., true);
+  auto cmd0 = std::get<0>(cmd);  // vel
+  auto cmd1 = std::get<1>(cmd);  // steer
+  EXPECT_NEAR(cmd1[0], M_PI_2, 1e-9);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(std::fabs(cmd0[i]), 1., 1e-9);
+  }
+
+  EXPECT_THROW(
+    odom.set_wheel_layout(std::vector<steering_odometry::Wheel>(
+      steering_odometry::SteeringKinematics::MAX_WHEELS + 1, {0., 0., true, true})),
+    std::invalid_argument);
+  EXPECT_THROW(odom.set_wheel_layout({{1., 0., true, false}}), std::invalid_argument);
+}
@@ -22,12 +22,7 @@
 #include <cmath>
 
 #include <rclcpp/duration.hpp>
-// \note The versions conditioning is added here to support the source-compatibility with Humble
-#if RCPPUTILS_VERSION_MAJOR >= 2 && RCPPUTILS_VERSION_MINOR >= 6
-#include "rcpputils/rolling_mean_accumulator.hpp"
-#else
-#include "rcppmath/rolling_mean_accumulator.hpp"
-#endif
+#include "ros2_controllers_utils/velocity_estimator.hpp"
 
 namespace tricycle_controller
 {
@@ -48,15 +43,9 @@ public:
 
   void setWheelParams(double wheel_separation, double wheel_radius);
   void setVelocityRollingWindowSize(size_t velocity_rolling_window_size);
+  void setVelocityEstimatorType(ros2_controllers_utils::VelocityEstimator::Type type);
 
 private:
-// \note The versions conditioning is added here to support the source-compatibility with Humble
-#if RCPPUTILS_VERSION_MAJOR >= 2 && RCPPUTILS_VERSION_MINOR >= 6
-  using RollingMeanAccumulator = rcpputils::RollingMeanAccumulator<double>;
-#else
-  using RollingMeanAccumulator = rcppmath::RollingMeanAccumulator<double>;
-#endif
-
   void integrateRungeKutta2(double linear, double angular);
   void integrateExact(double linear, double angular);
   void resetAccumulators();
@@ -74,10 +63,11 @@ private:
   double wheelbase_;
   double wheel_radius_;
 
-  // Rolling mean accumulators for the linear and angular velocities:
+  // Filters of the linear and angular velocities:
   size_t velocity_rolling_window_size_;
-  RollingMeanAccumulator linear_accumulator_;
-  RollingMeanAccumulator angular_accumulator_;
+  ros2_controllers_utils::VelocityEstimator::Type velocity_estimator_type_;
+  ros2_controllers_utils::VelocityEstimator linear_accumulator_;
+  ros2_controllers_utils::VelocityEstimator angular_accumulator_;
 };
 
 }  // namespace tricycle_controller
@@ -21,6 +21,8 @@
 
 #include <cmath>
 
+#include "ros2_controllers_utils/limiter.hpp"
+
 namespace tricycle_controller
 {
 class SteeringLimiter
@@ -75,18 +77,11 @@ public:
    */
   double limit_acceleration(double & p, double p0, double p1, double dt);
 
-private:
-  // Position limits:
-  double min_position_;
-  double max_position_;
-
-  // Velocity limits:
-  double min_velocity_;
-  double max_velocity_;
+  /// Resolved limits, to be used with ros2_controllers_utils::Limiter.
+  const ros2_controllers_utils::AxisLimits & axis_limits() const { return limiter_.limits(0); }
 
-  // Acceleration limits:
-  double min_acceleration_;
-  double max_acceleration_;
+private:
+  ros2_controllers_utils::Limiter<1> limiter_;
 };
 
 }  // namespace tricycle_controller
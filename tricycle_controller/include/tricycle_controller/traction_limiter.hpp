@@ -21,6 +21,8 @@
 
 #include <cmath>
 
+#include "ros2_controllers_utils/limiter.hpp"
+
 namespace tricycle_controller
 {
 class TractionLimiter
@@ -90,22 +92,11 @@ public:
    */
   double limit_jerk(double & v, double v0, double v1, double dt);
 
-private:
-  // Velocity limits:
-  double min_velocity_;
-  double max_velocity_;
-
-  // Acceleration limits:
-  double min_acceleration_;
-  double max_acceleration_;
+  /// Resolved limits, to be used with ros2_controllers_utils::Limiter.
+  const ros2_controllers_utils::AxisLimits & axis_limits() const { return limiter_.limits(0); }
 
-  // Deceleration limits:
-  double min_deceleration_;
-  double max_deceleration_;
-
-  // Jerk limits:
-  double min_jerk_;
-  double max_jerk_;
+private:
+  ros2_controllers_utils::Limiter<1> limiter_;
 };
 
 }  // namespace tricycle_controller
@@ -19,22 +19,25 @@
 #ifndef TRICYCLE_CONTROLLER__TRICYCLE_CONTROLLER_HPP_
 #define TRICYCLE_CONTROLLER__TRICYCLE_CONTROLLER_HPP_
 
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <memory>
-#include <queue>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "ackermann_msgs/msg/ackermann_drive.hpp"
-#include "controller_interface/controller_interface.hpp"
+#include "controller_interface/chainable_controller_interface.hpp"
 #include "geometry_msgs/msg/twist.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
 #include "nav_msgs/msg/odometry.hpp"
 #include "rclcpp_lifecycle/state.hpp"
-#include "realtime_tools/realtime_box.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
+#include "realtime_tools/realtime_thread_safe_box.hpp"
+#include "ros2_controllers_utils/command_history.hpp"
+#include "ros2_controllers_utils/limiter.hpp"
+#include "ros2_controllers_utils/stamped_command.hpp"
 #include "std_srvs/srv/empty.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
 
@@ -48,7 +51,7 @@ namespace tricycle_controller
 {
 using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
 
-class TricycleController : public controller_interface::ControllerInterface
+class TricycleController : public controller_interface::ChainableControllerInterface
 {
   using Twist = geometry_msgs::msg::Twist;
   using TwistStamped = geometry_msgs::msg::TwistStamped;
@@ -61,7 +64,10 @@ public:
 
   controller_interface::InterfaceConfiguration state_interface_configuration() const override;
 
-  controller_interface::return_type update(
+  controller_interface::return_type update_reference_from_subscribers(
+    const rclcpp::Time & time, const rclcpp::Duration & period) override;
+
+  controller_interface::return_type update_and_write_commands(
     const rclcpp::Time & time, const rclcpp::Duration & period) override;
 
   CallbackReturn on_init() override;
@@ -77,6 +83,8 @@ public:
   CallbackReturn on_error(const rclcpp_lifecycle::State & previous_state) override;
 
 protected:
+  std::vector<hardware_interface::StateInterface> on_export_state_interfaces() override;
+
   struct TractionHandle
   {
     std::reference_wrapper<const hardware_interface::LoanedStateInterface> velocity_state;
@@ -124,16 +132,21 @@ protected:
   bool subscriber_is_active_ = false;
   rclcpp::Subscription<TwistStamped>::SharedPtr velocity_command_subscriber_ = nullptr;
 
-  realtime_tools::RealtimeBox<std::shared_ptr<TwistStamped>> received_velocity_msg_ptr_{nullptr};
-  std::shared_ptr<TwistStamped> last_command_msg_;
+  // linear.x and angular.z of the received command, without the header of the message
+  using VelocityCommand = ros2_controllers_utils::StampedCommand<2>;
+  realtime_tools::RealtimeThreadSafeBox<VelocityCommand> received_velocity_command_;
+  // the last command, kept if the subscriber is writing
+  VelocityCommand velocity_command_;
 
   rclcpp::Service<std_srvs::srv::Empty>::SharedPtr reset_odom_service_;
 
-  std::queue<AckermannDrive> previous_commands_;  // last two commands
+  // last two commands of wheel speed and steering angle
+  ros2_controllers_utils::CommandHistory<std::array<double, 2>, 2> previous_commands_;
 
-  // speed limiters
+  // limits of the wheel speed and steering angle, applied together by limiter_
   TractionLimiter limiter_traction_;
   SteeringLimiter limiter_steering_;
+  ros2_controllers_utils::Limiter<2> limiter_;
 
   void reset_odometry(
     const std::shared_ptr<rmw_request_id_t> request_header,
@@ -29,8 +29,9 @@ Odometry::Odometry(size_t velocity_rolling_window_size)
   wheelbase_(0.0),
   wheel_radius_(0.0),
   velocity_rolling_window_size_(velocity_rolling_window_size),
-  linear_accumulator_(velocity_rolling_window_size),
-  angular_accumulator_(velocity_rolling_window_size)
+  velocity_estimator_type_(ros2_controllers_utils::VelocityEstimator::Type::ROLLING_MEAN),
+  linear_accumulator_(velocity_estimator_type_, velocity_rolling_window_size),
+  angular_accumulator_(velocity_estimator_type_, velocity_rolling_window_size)
 {
 }
 
@@ -44,12 +45,12 @@ bool Odometry::update(double Ws, double alpha, const rclcpp::Duration & dt)
   // Integrate odometry:
   integrateExact(Vx * dt.seconds(), theta_dot * dt.seconds());
 
-  // Estimate speeds using a rolling mean to filter them out:
+  // Estimate speeds using the velocity estimators to filter them out:
   linear_accumulator_.accumulate(Vx);
   angular_accumulator_.accumulate(theta_dot);
 
-  linear_ = linear_accumulator_.getRollingMean();
-  angular_ = angular_accumulator_.getRollingMean();
+  linear_ = linear_accumulator_.get_estimate();
+  angular_ = angular_accumulator_.get_estimate();
 
   return true;
 }
@@ -82,7 +83,16 @@ void Odometry::setVelocityRollingWindowSize(size_t velocity_rolling_window_size)
 {
   velocity_rolling_window_size_ = velocity_rolling_window_size;
 
-  resetAccumulators();
+  linear_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+  angular_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+}
+
+void Odometry::setVelocityEstimatorType(ros2_controllers_utils::VelocityEstimator::Type type)
+{
+  velocity_estimator_type_ = type;
+
+  linear_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
+  angular_accumulator_.configure(velocity_estimator_type_, velocity_rolling_window_size_);
 }
 
 void Odometry::integrateRungeKutta2(double linear, double angular)
@@ -114,8 +124,8 @@ void Odometry::integrateExact(double linear, double angular)
 
 void Odometry::resetAccumulators()
 {
-  linear_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
-  angular_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
+  linear_accumulator_.reset();
+  angular_accumulator_.reset();
 }
 
 }  // namespace tricycle_controller
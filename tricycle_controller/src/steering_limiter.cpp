@@ -16,7 +16,7 @@
  * Author: Tony Najjar
  */
 
-#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <string>
 
@@ -27,90 +27,61 @@ namespace tricycle_controller
 SteeringLimiter::SteeringLimiter(
   double min_position, double max_position, double min_velocity, double max_velocity,
   double min_acceleration, double max_acceleration)
-: min_position_(min_position),
-  max_position_(max_position),
-  min_velocity_(min_velocity),
-  max_velocity_(max_velocity),
-  min_acceleration_(min_acceleration),
-  max_acceleration_(max_acceleration)
 {
-  if (!std::isnan(min_position_) && std::isnan(max_position_)) max_position_ = -min_position_;
-  if (!std::isnan(max_position_) && std::isnan(min_position_)) min_position_ = -max_position_;
+  if (!std::isnan(min_position) && std::isnan(max_position)) max_position = -min_position;
+  if (!std::isnan(max_position) && std::isnan(min_position)) min_position = -max_position;
 
-  if (!std::isnan(min_velocity_) && std::isnan(max_velocity_))
-    max_velocity_ = 1000.0;  // Arbitrarily big number
-  if (!std::isnan(max_velocity_) && std::isnan(min_velocity_)) min_velocity_ = 0.0;
+  if (!std::isnan(min_velocity) && std::isnan(max_velocity))
+    max_velocity = 1000.0;  // Arbitrarily big number
+  if (!std::isnan(max_velocity) && std::isnan(min_velocity)) min_velocity = 0.0;
 
-  if (!std::isnan(min_acceleration_) && std::isnan(max_acceleration_)) max_acceleration_ = 1000.0;
-  if (!std::isnan(max_acceleration_) && std::isnan(min_acceleration_)) min_acceleration_ = 0.0;
+  if (!std::isnan(min_acceleration) && std::isnan(max_acceleration)) max_acceleration = 1000.0;
+  if (!std::isnan(max_acceleration) && std::isnan(min_acceleration)) min_acceleration = 0.0;
 
   const std::string error =
     "The positive limit will be applied to both directions. Setting different limits for positive "
     "and negative directions is not supported. Actuators are "
     "assumed to have the same constraints in both directions";
 
-  if (min_velocity_ < 0 || max_velocity_ < 0)
+  if (min_velocity < 0 || max_velocity < 0)
   {
     throw std::invalid_argument("Velocity cannot be negative." + error);
   }
 
-  if (min_acceleration_ < 0 || max_acceleration_ < 0)
+  if (min_acceleration < 0 || max_acceleration < 0)
   {
     throw std::invalid_argument("Acceleration cannot be negative." + error);
   }
+
+  // the position is limited as signed value, its derivatives symmetrically in both directions
+  ros2_controllers_utils::AxisLimits limits;
+  limits.min_value = min_position;
+  limits.max_value = max_position;
+  limits.min_first_derivative_pos = min_velocity;
+  limits.max_first_derivative_pos = max_velocity;
+  limits.min_first_derivative_neg = min_velocity;
+  limits.max_first_derivative_neg = max_velocity;
+  limits.min_second_derivative = min_acceleration;
+  limits.max_second_derivative = max_acceleration;
+  limits.symmetric_derivatives = true;
+  limiter_ = ros2_controllers_utils::Limiter<1>({limits});
 }
 
 double SteeringLimiter::limit(double & p, double p0, double p1, double dt)
 {
-  const double tmp = p;
-
-  if (!std::isnan(min_acceleration_) && !std::isnan(max_acceleration_))
-    limit_acceleration(p, p0, p1, dt);
-  if (!std::isnan(min_velocity_) && !std::isnan(max_velocity_)) limit_velocity(p, p0, dt);
-  if (!std::isnan(min_position_) && !std::isnan(max_position_)) limit_position(p);
-
-  return tmp != 0.0 ? p / tmp : 1.0;
+  return limiter_.limit(0, p, p0, p1, dt);
 }
 
-double SteeringLimiter::limit_position(double & p)
-{
-  const double tmp = p;
-  p = std::clamp(p, min_position_, max_position_);
-
-  return tmp != 0.0 ? p / tmp : 1.0;
-}
+double SteeringLimiter::limit_position(double & p) { return limiter_.limit_value(0, p); }
 
 double SteeringLimiter::limit_velocity(double & p, double p0, double dt)
 {
-  const double tmp = p;
-
-  const double dv_min = min_velocity_ * dt;
-  const double dv_max = max_velocity_ * dt;
-
-  double dv = std::clamp(std::fabs(p - p0), dv_min, dv_max);
-  dv *= (p - p0 >= 0 ? 1 : -1);
-  p = p0 + dv;
-
-  return tmp != 0.0 ? p / tmp : 1.0;
+  return limiter_.limit_first_derivative(0, p, p0, dt);
 }
 
 double SteeringLimiter::limit_acceleration(double & p, double p0, double p1, double dt)
 {
-  const double tmp = p;
-
-  const double dv = p - p0;
-  const double dp0 = p0 - p1;
-
-  const double dt2 = 2. * dt * dt;
-
-  const double da_min = min_acceleration_ * dt2;
-  const double da_max = max_acceleration_ * dt2;
-
-  double da = std::clamp(std::fabs(dv - dp0), da_min, da_max);
-  da *= (dv - dp0 >= 0 ? 1 : -1);
-  p = p0 + dp0 + da;
-
-  return tmp != 0.0 ? p / tmp : 1.0;
+  return limiter_.limit_second_derivative(0, p, p0, p1, dt);
 }
 
 }  // namespace tricycle_controller
@@ -18,8 +18,8 @@
 
 #define _USE_MATH_DEFINES
 
+#include <limits>
 #include <memory>
-#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
@@ -48,7 +48,7 @@ using hardware_interface::HW_IF_POSITION;
 using hardware_interface::HW_IF_VELOCITY;
 using lifecycle_msgs::msg::State;
 
-TricycleController::TricycleController() : controller_interface::ControllerInterface() {}
+TricycleController::TricycleController() : controller_interface::ChainableControllerInterface() {}
 
 CallbackReturn TricycleController::on_init()
 {
@@ -85,31 +85,32 @@ InterfaceConfiguration TricycleController::state_interface_configuration() const
   return state_interfaces_config;
 }
 
-controller_interface::return_type TricycleController::update(
+controller_interface::return_type TricycleController::update_reference_from_subscribers(
+  const rclcpp::Time & /*time*/, const rclcpp::Duration & /*period*/)
+{
+  // no reference interfaces are exported, the command is read in update_and_write_commands
+  return controller_interface::return_type::OK;
+}
+
+controller_interface::return_type TricycleController::update_and_write_commands(
   const rclcpp::Time & time, const rclcpp::Duration & period)
 {
-  // if the mutex is unable to lock, last_command_msg_ won't be updated
-  received_velocity_msg_ptr_.try_get([this](const std::shared_ptr<TwistStamped> & msg)
-                                     { last_command_msg_ = msg; });
-  if (last_command_msg_ == nullptr)
+  // if the mutex is unable to lock, velocity_command_ won't be updated
+  auto velocity_command_op = received_velocity_command_.try_get();
+  if (velocity_command_op.has_value())
   {
-    RCLCPP_WARN(get_node()->get_logger(), "Velocity message received was a nullptr.");
-    return controller_interface::return_type::ERROR;
+    velocity_command_ = velocity_command_op.value();
   }
 
-  const auto age_of_last_command = time - last_command_msg_->header.stamp;
-  // Brake if cmd_vel has timeout, override the stored command
-  if (age_of_last_command > cmd_vel_timeout_)
-  {
-    last_command_msg_->twist.linear.x = 0.0;
-    last_command_msg_->twist.angular.z = 0.0;
-  }
+  const int64_t age_of_last_command = time.nanoseconds() - velocity_command_.stamp;
+  // Brake if cmd_vel has timeout
+  const bool is_timed_out =
+    age_of_last_command > std::chrono::nanoseconds(cmd_vel_timeout_).count();
 
   // command may be limited further by Limiters,
   // without affecting the stored twist command
-  TwistStamped command = *last_command_msg_;
-  double & linear_command = command.twist.linear.x;
-  double & angular_command = command.twist.angular.z;
+  double linear_command = is_timed_out ? 0.0 : velocity_command_.values[0];
+  double angular_command = is_timed_out ? 0.0 : velocity_command_.values[1];
   double Ws_read = traction_joint_[0].velocity_state.get().get_value();     // in radians/s
   double alpha_read = steering_joint_[0].position_state.get().get_value();  // in radians
 
@@ -127,10 +128,16 @@ controller_interface::return_type TricycleController::update(
     odometry_.update(Ws_read, alpha_read, period);
   }
 
+  state_interfaces_values_[0] = odometry_.getX();
+  state_interfaces_values_[1] = odometry_.getY();
+  state_interfaces_values_[2] = odometry_.getHeading();
+  state_interfaces_values_[3] = odometry_.getLinear();
+  state_interfaces_values_[4] = odometry_.getAngular();
+
   tf2::Quaternion orientation;
   orientation.setRPY(0.0, 0.0, odometry_.getHeading());
 
-  if (realtime_odometry_publisher_->trylock())
+  if (params_.publish_odom && realtime_odometry_publisher_->trylock())
   {
     auto & odometry_message = realtime_odometry_publisher_->msg_;
     odometry_message.header.stamp = time;
@@ -182,23 +189,12 @@ controller_interface::return_type TricycleController::update(
   }
   Ws_write *= scale;
 
-  auto & last_command = previous_commands_.back();
-  auto & second_to_last_command = previous_commands_.front();
-
-  limiter_traction_.limit(
-    Ws_write, last_command.speed, second_to_last_command.speed, period.seconds());
-
-  limiter_steering_.limit(
-    alpha_write, last_command.steering_angle, second_to_last_command.steering_angle,
-    period.seconds());
-
-  previous_commands_.pop();
-  AckermannDrive ackermann_command;
-  // speed in AckermannDrive is defined as desired forward speed (m/s) but it is used here as wheel
-  // speed (rad/s)
-  ackermann_command.speed = static_cast<float>(Ws_write);
-  ackermann_command.steering_angle = static_cast<float>(alpha_write);
-  previous_commands_.emplace(ackermann_command);
+  // limit wheel speed and steering angle in one call, index 0 is traction, 1 steering
+  std::array<double, 2> command{{Ws_write, alpha_write}};
+  limiter_.limit(command, previous_commands_, period.seconds());
+  previous_commands_.push(command);
+  Ws_write = command[0];
+  alpha_write = command[1];
 
   //  Publish ackermann command
   if (params_.publish_ackermann_command && realtime_ackermann_command_publisher_->trylock())
@@ -230,6 +226,21 @@ CallbackReturn TricycleController::on_configure(const rclcpp_lifecycle::State &
   odometry_.setWheelParams(params_.wheelbase, params_.wheel_radius);
   odometry_.setVelocityRollingWindowSize(static_cast<size_t>(params_.velocity_rolling_window_size));
 
+  ros2_controllers_utils::VelocityEstimator::Type velocity_estimator_type;
+  if (!ros2_controllers_utils::VelocityEstimator::type_from_string(
+        params_.velocity_estimator, velocity_estimator_type))
+  {
+    RCLCPP_ERROR(
+      get_node()->get_logger(), "Unknown velocity estimator '%s'",
+      params_.velocity_estimator.c_str());
+    return CallbackReturn::ERROR;
+  }
+  odometry_.setVelocityEstimatorType(velocity_estimator_type);
+
+  // Allocate state interfaces for the odometry: x, y, yaw, linear and angular velocity
+  const size_t nr_state_itfs = 5;
+  state_interfaces_values_.resize(nr_state_itfs, std::numeric_limits<double>::quiet_NaN());
+
   cmd_vel_timeout_ = std::chrono::milliseconds{params_.cmd_vel_timeout};
   params_.publish_ackermann_command =
     get_node()->get_parameter("publish_ackermann_command").as_bool();
@@ -259,19 +270,18 @@ CallbackReturn TricycleController::on_configure(const rclcpp_lifecycle::State &
     RCLCPP_ERROR(get_node()->get_logger(), "Error configuring steering limiter: %s", e.what());
     return CallbackReturn::ERROR;
   }
+  limiter_ = ros2_controllers_utils::Limiter<2>(
+    {limiter_traction_.axis_limits(), limiter_steering_.axis_limits()});
 
   if (!reset())
   {
     return CallbackReturn::ERROR;
   }
 
-  last_command_msg_ = std::make_shared<TwistStamped>();
-  received_velocity_msg_ptr_.set([this](std::shared_ptr<TwistStamped> & stored_value)
-                                 { stored_value = last_command_msg_; });
-  // Fill last two commands with default constructed commands
-  const AckermannDrive empty_ackermann_drive;
-  previous_commands_.emplace(empty_ackermann_drive);
-  previous_commands_.emplace(empty_ackermann_drive);
+  velocity_command_ = VelocityCommand();
+  received_velocity_command_.set(velocity_command_);
+  // Fill last two commands with zeros
+  previous_commands_.fill({{0.0, 0.0}});
 
   // initialize ackermann command publisher
   if (params_.publish_ackermann_command)
@@ -301,8 +311,9 @@ CallbackReturn TricycleController::on_configure(const rclcpp_lifecycle::State &
           "time, this message will only be shown once");
         msg->header.stamp = get_node()->get_clock()->now();
       }
-      received_velocity_msg_ptr_.set([msg](std::shared_ptr<TwistStamped> & stored_value)
-                                     { stored_value = std::move(msg); });
+      received_velocity_command_.set(
+        {rclcpp::Time(msg->header.stamp).nanoseconds(),
+         {{msg->twist.linear.x, msg->twist.angular.z}}});
     });
 
   // initialize odometry publisher and message
@@ -417,9 +428,7 @@ bool TricycleController::reset()
 {
   odometry_.resetOdometry();
 
-  // release the old queue
-  std::queue<AckermannDrive> empty_ackermann_drive;
-  std::swap(previous_commands_, empty_ackermann_drive);
+  previous_commands_.fill({{0.0, 0.0}});
 
   traction_joint_.clear();
   steering_joint_.clear();
@@ -427,7 +436,7 @@ bool TricycleController::reset()
   subscriber_is_active_ = false;
   velocity_command_subscriber_.reset();
 
-  received_velocity_msg_ptr_.set(nullptr);
+  received_velocity_command_.set(VelocityCommand());
   return true;
 }
 
@@ -548,8 +557,33 @@ std::tuple<double, double> TricycleController::twist_to_ackermann(double Vx, dou
   return std::make_tuple(alpha, Ws);
 }
 
+std::vector<hardware_interface::StateInterface> TricycleController::on_export_state_interfaces()
+{
+  std::vector<hardware_interface::StateInterface> state_interfaces;
+  state_interfaces.reserve(state_interfaces_values_.size());
+
+  const std::string prefix = get_node()->get_name();
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/x", HW_IF_POSITION, &state_interfaces_values_[0]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/y", HW_IF_POSITION, &state_interfaces_values_[1]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/yaw", HW_IF_POSITION, &state_interfaces_values_[2]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/linear", HW_IF_VELOCITY, &state_interfaces_values_[3]));
+  state_interfaces.push_back(
+    hardware_interface::StateInterface(
+      prefix + "/angular", HW_IF_VELOCITY, &state_interfaces_values_[4]));
+
+  return state_interfaces;
+}
+
 }  // namespace tricycle_controller
 
 #include <pluginlib/class_list_macros.hpp>
 PLUGINLIB_EXPORT_CLASS(
-  tricycle_controller::TricycleController, controller_interface::ControllerInterface)
+  tricycle_controller::TricycleController, controller_interface::ChainableControllerInterface)
@@ -13,10 +13,102 @@
 // limitations under the License.
 
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <random>
+#include <tuple>
+#include <utility>
 
+#include "tricycle_controller/steering_limiter.hpp"
 #include "tricycle_controller/traction_limiter.hpp"
 
+namespace
+{
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// Reference implementations of the limiters before they used ros2_controllers_utils::Limiter
+
+void resolve(double & min, double & max, double default_max)
+{
+  if (!std::isnan(min) && std::isnan(max)) max = default_max;
+  if (!std::isnan(max) && std::isnan(min)) min = 0.0;
+}
+
+bool is_set(double min, double max) { return !std::isnan(min) && !std::isnan(max); }
+
+double clamp_magnitude(double value, double min, double max)
+{
+  return std::clamp(std::fabs(value), min, max) * (value >= 0 ? 1 : -1);
+}
+
+double reference_traction_limit(
+  std::array<double, 8> l, double & v, double v0, double v1, double dt)
+{
+  for (size_t i = 0; i < l.size(); i += 2)
+  {
+    resolve(l[i], l[i + 1], 1000.0);
+  }
+  const double tmp = v;
+  if (is_set(l[6], l[7]))
+  {
+    const double dv0 = v0 - v1;
+    v = v0 + dv0 + clamp_magnitude(v - v0 - dv0, l[6] * 2. * dt * dt, l[7] * 2. * dt * dt);
+  }
+  if (is_set(l[2], l[3]))
+  {
+    const bool accelerating = std::fabs(v) >= std::fabs(v0);
+    const double min = accelerating ? l[2] : l[4];
+    const double max = accelerating ? l[3] : l[5];
+    v = v0 + clamp_magnitude(v - v0, min * dt, max * dt);
+  }
+  if (is_set(l[0], l[1]))
+  {
+    v = clamp_magnitude(v, l[0], l[1]);
+  }
+  return tmp != 0.0 ? v / tmp : 1.0;
+}
+
+double reference_steering_limit(
+  std::array<double, 6> l, double & p, double p0, double p1, double dt)
+{
+  if (!std::isnan(l[0]) && std::isnan(l[1])) l[1] = -l[0];
+  if (!std::isnan(l[1]) && std::isnan(l[0])) l[0] = -l[1];
+  resolve(l[2], l[3], 1000.0);
+  resolve(l[4], l[5], 1000.0);
+  const double tmp = p;
+  if (is_set(l[4], l[5]))
+  {
+    const double dp0 = p0 - p1;
+    p = p0 + dp0 + clamp_magnitude(p - p0 - dp0, l[4] * 2. * dt * dt, l[5] * 2. * dt * dt);
+  }
+  if (is_set(l[2], l[3]))
+  {
+    p = p0 + clamp_magnitude(p - p0, l[2] * dt, l[3] * dt);
+  }
+  if (is_set(l[0], l[1]))
+  {
+    p = std::clamp(p, l[0], l[1]);
+  }
+  return tmp != 0.0 ? p / tmp : 1.0;
+}
+
+// random pair of limits 0 <= min <= max, each of them unset with a probability of 1/3
+std::pair<double, double> random_limits(std::mt19937 & generator)
+{
+  std::uniform_real_distribution<double> value(0.0, 2.0);
+  std::uniform_int_distribution<int> unset(0, 2);
+  double min = value(generator);
+  double max = value(generator);
+  if (min > max)
+  {
+    std::swap(min, max);
+  }
+  return {unset(generator) == 0 ? NaN : min, unset(generator) == 0 ? NaN : max};
+}
+}  // namespace
+
 TEST(SpeedLimiterTest, testWrongParams)
 {
   EXPECT_NO_THROW(
@@ -545,3 +637,69 @@ TEST(SpeedLimiterTest, testJerkLimits)
     EXPECT_DOUBLE_EQ(limiting_factor, 0.5 / 10.0);
   }
 }
+
+TEST(SpeedLimiterTest, testSameAsReferenceImplementation)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> velocity(-3.0, 3.0);
+  std::uniform_real_distribution<double> period(0.001, 0.1);
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::array<double, 8> limits;
+    for (size_t j = 0; j < limits.size(); j += 2)
+    {
+      std::tie(limits[j], limits[j + 1]) = random_limits(generator);
+    }
+    tricycle_controller::TractionLimiter limiter(
+      limits[0], limits[1], limits[2], limits[3], limits[4], limits[5], limits[6], limits[7]);
+
+    double v0 = 0.0;
+    double v1 = 0.0;
+    for (int k = 0; k < 100; ++k)
+    {
+      const double dt = period(generator);
+      double v = velocity(generator);
+      double expected = v;
+      const double expected_factor = reference_traction_limit(limits, expected, v0, v1, dt);
+      const double factor = limiter.limit(v, v0, v1, dt);
+      ASSERT_NEAR(v, expected, 1e-12) << "limits " << i << ", cycle " << k;
+      ASSERT_NEAR(factor, expected_factor, 1e-9) << "limits " << i << ", cycle " << k;
+      v1 = v0;
+      v0 = v;
+    }
+  }
+}
+
+TEST(SteeringLimiterTest, testSameAsReferenceImplementation)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> position(-1.5, 1.5);
+  std::uniform_real_distribution<double> period(0.001, 0.1);
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::array<double, 6> limits;
+    for (size_t j = 0; j < limits.size(); j += 2)
+    {
+      std::tie(limits[j], limits[j + 1]) = random_limits(generator);
+    }
+    // symmetric position limits, the minimum is negative
+    limits[0] = -limits[0];
+    tricycle_controller::SteeringLimiter limiter(
+      limits[0], limits[1], limits[2], limits[3], limits[4], limits[5]);
+
+    double p0 = 0.0;
+    double p1 = 0.0;
+    for (int k = 0; k < 100; ++k)
+    {
+      const double dt = period(generator);
+      double p = position(generator);
+      double expected = p;
+      const double expected_factor = reference_steering_limit(limits, expected, p0, p1, dt);
+      const double factor = limiter.limit(p, p0, p1, dt);
+      ASSERT_NEAR(p, expected, 1e-12) << "limits " << i << ", cycle " << k;
+      ASSERT_NEAR(factor, expected_factor, 1e-9) << "limits " << i << ", cycle " << k;
+      p1 = p0;
+      p0 = p;
+    }
+  }
+}
@@ -51,13 +51,7 @@ class TestableTricycleController : public tricycle_controller::TricycleControlle
 {
 public:
   using TricycleController::TricycleController;
-  std::shared_ptr<geometry_msgs::msg::TwistStamped> getLastReceivedTwist()
-  {
-    std::shared_ptr<geometry_msgs::msg::TwistStamped> ret;
-    received_velocity_msg_ptr_.get(
-      [&ret](const std::shared_ptr<geometry_msgs::msg::TwistStamped> & msg) { ret = msg; });
-    return ret;
-  }
+  VelocityCommand getLastReceivedCommand() { return received_velocity_command_.get(); }
 
   /**
    * @brief wait_for_twist block until a new twist is received.
@@ -276,6 +270,11 @@ TEST_F(TestTricycleController, cleanup)
   publish(linear, angular);
   controller_->wait_for_twist(executor);
 
+  // only the used values of the message are handed over to the realtime loop
+  const auto received_command = controller_->getLastReceivedCommand();
+  EXPECT_EQ(linear, received_command.values[0]);
+  EXPECT_EQ(angular, received_command.values[1]);
+
   ASSERT_EQ(
     controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
     controller_interface::return_type::OK);
@@ -353,3 +352,53 @@ TEST_F(TestTricycleController, correct_initialization_using_parameters)
   ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
   executor.cancel();
 }
+
+TEST_F(TestTricycleController, odometry_is_exported_as_state_interfaces)
+{
+  ASSERT_EQ(
+    InitController(
+      traction_joint_name, steering_joint_name, {rclcpp::Parameter("open_loop", true)}),
+    controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResources();
+
+  auto state_interfaces = controller_->export_state_interfaces();
+  ASSERT_THAT(state_interfaces, SizeIs(5));
+  const std::vector<std::pair<std::string, std::string>> expected_interfaces = {
+    {"/x", HW_IF_POSITION},
+    {"/y", HW_IF_POSITION},
+    {"/yaw", HW_IF_POSITION},
+    {"/linear", HW_IF_VELOCITY},
+    {"/angular", HW_IF_VELOCITY}};
+  for (size_t i = 0; i < expected_interfaces.size(); ++i)
+  {
+    EXPECT_EQ(
+      state_interfaces[i]->get_prefix_name(), controller_name + expected_interfaces[i].first);
+    EXPECT_EQ(state_interfaces[i]->get_interface_name(), expected_interfaces[i].second);
+  }
+
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  const double linear = 1.0;
+  publish(linear, 0.0);
+  controller_->wait_for_twist(executor);
+
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.1)),
+    controller_interface::return_type::OK);
+
+  // the odometry is exported in the same cycle
+  EXPECT_NEAR(state_interfaces[0]->get_value(), linear * 0.1, 1e-9);
+  EXPECT_NEAR(state_interfaces[1]->get_value(), 0.0, 1e-9);
+  EXPECT_NEAR(state_interfaces[2]->get_value(), 0.0, 1e-9);
+  EXPECT_NEAR(state_interfaces[3]->get_value(), linear, 1e-9);
+  EXPECT_NEAR(state_interfaces[4]->get_value(), 0.0, 1e-9);
+
+  executor.cancel();
+}
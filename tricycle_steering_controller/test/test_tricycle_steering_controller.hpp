@@ -68,6 +68,7 @@ class TestableTricycleSteeringController
   FRIEND_TEST(TricycleSteeringControllerTest, test_update_logic_chained);
   FRIEND_TEST(TricycleSteeringControllerTest, publish_status_success);
   FRIEND_TEST(TricycleSteeringControllerTest, receive_message_and_publish_updated_status);
+  FRIEND_TEST(TricycleSteeringControllerTest, update_does_not_allocate);
 
 public:
   controller_interface::CallbackReturn on_configure(